@@ -0,0 +1,262 @@
+// CompressedSplatDecoder.cpp
+
+#include "CompressedSplatDecoder.h"
+#include "Miniply.h"
+#include "SplatArena.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+static const char* const kChunkElement = "chunk";
+static const char* const kHarmonicsElement = "sh";
+
+static const char* const kChunkProperties[] = {
+	"min_x", "min_y", "min_z", "max_x", "max_y", "max_z",
+	"min_scale_x", "min_scale_y", "min_scale_z", "max_scale_x", "max_scale_y", "max_scale_z",
+	"min_r", "min_g", "min_b", "max_r", "max_g", "max_b",
+};
+
+static constexpr int32 NumVertexColumns = 14;
+static constexpr float SH_C0 = 0.28209479177387814f;
+
+// Value of the low Bits bits of Value, mapped to [0, 1]
+static FORCEINLINE float UnpackUnorm(uint32 Value, uint32 Bits) {
+	const uint32 Max = (1u << Bits) - 1;
+	return float(Value & Max) / float(Max);
+}
+
+FCompressedSplatDecoder::FCompressedSplatDecoder()
+	: Chunks()
+	, NumChunks(0)
+	, bChunkColors(false)
+	, Storage()
+	, Packed()
+	, Arena(nullptr)
+	, ArenaColumns(0)
+	, ArenaStorage(nullptr)
+	, ArenaStorageSize(0)
+	, NumSplats(0)
+	, FileSHDegree(0)
+{
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		Columns[Col] = nullptr;
+	}
+}
+
+bool FCompressedSplatDecoder::IsCompressedLayout(miniply::PLYReader& Reader) {
+	const uint32 ChunkIdx = Reader.find_element(kChunkElement);
+	const uint32 VertexIdx = Reader.find_element(miniply::kPLYVertexElement);
+	if (ChunkIdx == miniply::kInvalidIndex || VertexIdx == miniply::kInvalidIndex || ChunkIdx > VertexIdx) {
+		return false;
+	}
+	uint32 PropIdxs[4];
+	return Reader.get_element(VertexIdx)->find_properties(PropIdxs, 4, "packed_position", "packed_rotation", "packed_scale", "packed_color")
+		&& Reader.get_element(ChunkIdx)->find_properties(PropIdxs, 4, "min_x", "max_x", "min_scale_x", "max_scale_x");
+}
+
+int32 FCompressedSplatDecoder::GetSHDegree(miniply::PLYReader& Reader) {
+	// Harmonics must follow the vertex element, since they are written into textures the vertices created
+	const uint32 HarmonicsIdx = Reader.find_element(kHarmonicsElement);
+	const uint32 VertexIdx = Reader.find_element(miniply::kPLYVertexElement);
+	if (HarmonicsIdx == miniply::kInvalidIndex || HarmonicsIdx < VertexIdx) {
+		return 0;
+	}
+	const miniply::PLYElement* Elem = Reader.get_element(HarmonicsIdx);
+	if (Elem->count != Reader.get_element(VertexIdx)->count || !Elem->fixedSize) {
+		return 0;
+	}
+	FGaussianSplatBuffer Harmonics;
+	Harmonics.Resolve(*Elem);
+	return Harmonics.SHDegree();
+}
+
+void FCompressedSplatDecoder::SetArena(FSplatArena* InArena, int32 SHDegree) {
+	Arena = InArena;
+	ArenaColumns = FMath::Max(NumVertexColumns, FGaussianSplatBuffer::NumRestCoefficientsForDegree(SHDegree));
+	ArenaStorage = nullptr;
+	ArenaStorageSize = 0;
+}
+
+int64 FCompressedSplatDecoder::GetBatchBytes(uint32 NumRows, int32 SHDegree) {
+	const int32 NumColumnsUsed = FMath::Max(NumVertexColumns, FGaussianSplatBuffer::NumRestCoefficientsForDegree(SHDegree));
+	return int64(NumColumnsUsed) * NumRows * sizeof(float);
+}
+
+bool FCompressedSplatDecoder::LoadChunks(miniply::PLYReader& Reader) {
+	const miniply::PLYElement* Elem = Reader.element();
+	uint32 PropIdxs[NumChunkBounds];
+	if (!Reader.element_is(kChunkElement) || !Elem->find_properties(PropIdxs, MinR, kChunkProperties[0], kChunkProperties[1],
+		kChunkProperties[2], kChunkProperties[3], kChunkProperties[4], kChunkProperties[5], kChunkProperties[6], kChunkProperties[7],
+		kChunkProperties[8], kChunkProperties[9], kChunkProperties[10], kChunkProperties[11])) {
+		return false;
+	}
+	bChunkColors = Elem->find_properties(PropIdxs + MinR, NumChunkBounds - MinR, kChunkProperties[12], kChunkProperties[13],
+		kChunkProperties[14], kChunkProperties[15], kChunkProperties[16], kChunkProperties[17]);
+	const uint32 NumBounds = bChunkColors ? uint32(NumChunkBounds) : uint32(MinR);
+
+	NumChunks = int32(Elem->count);
+	Chunks.SetNumZeroed(NumChunks * NumChunkBounds);
+	return Reader.load_element()
+		&& Reader.extract_properties_with_stride(PropIdxs, NumBounds, miniply::PLYPropertyType::Float, Chunks.GetData(), NumChunkBounds * sizeof(float));
+}
+
+float* FCompressedSplatDecoder::AllocateColumns(int32 NumColumnsUsed, int32 InNumSplats) {
+	NumSplats = InNumSplats;
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		Columns[Col] = nullptr;
+	}
+
+	if (Arena) {
+		// Both elements share one allocation, sized for the larger of them
+		const int64 NumValues = int64(FMath::Max(NumColumnsUsed, ArenaColumns)) * NumSplats;
+		if (NumValues > ArenaStorageSize) {
+			ArenaStorage = Arena->AllocateArray<float>(NumValues);
+			ArenaStorageSize = NumValues;
+		}
+		return ArenaStorage;
+	}
+	Storage.SetNumUninitialized(NumColumnsUsed * NumSplats, EAllowShrinking::No);
+	return Storage.GetData();
+}
+
+bool FCompressedSplatDecoder::DecodeVertices(const miniply::PLYReader& Reader, uint32 FirstRow) {
+	const miniply::PLYElement* Elem = Reader.element();
+	uint32 PropIdxs[4];
+	if (!Elem->find_properties(PropIdxs, 4, "packed_position", "packed_rotation", "packed_scale", "packed_color")) {
+		return false;
+	}
+	const int32 NumRows = int32(Reader.num_loaded_rows());
+	if (FMath::DivideAndRoundUp(FirstRow + uint32(NumRows), SplatsPerChunk) > uint32(NumChunks)) {
+		UE_LOG(LogTemp, Error, TEXT("Compressed PLY - %d chunks do not cover vertex %u"), NumChunks, FirstRow + NumRows - 1);
+		return false;
+	}
+
+	float* Next = AllocateColumns(NumVertexColumns, NumRows);
+	for (EGaussianSplatColumn Col : { EGaussianSplatColumn::X, EGaussianSplatColumn::Y, EGaussianSplatColumn::Z,
+		EGaussianSplatColumn::Scale0, EGaussianSplatColumn::Scale1, EGaussianSplatColumn::Scale2,
+		EGaussianSplatColumn::Rot0, EGaussianSplatColumn::Rot1, EGaussianSplatColumn::Rot2, EGaussianSplatColumn::Rot3,
+		EGaussianSplatColumn::DC0, EGaussianSplatColumn::DC1, EGaussianSplatColumn::DC2, EGaussianSplatColumn::Opacity }) {
+		Columns[int32(Col)] = Next;
+		Next += NumRows;
+	}
+	Packed.SetNumUninitialized(NumRows * 4, EAllowShrinking::No);
+
+	float* PosX = Columns[int32(EGaussianSplatColumn::X)];
+	float* PosY = Columns[int32(EGaussianSplatColumn::Y)];
+	float* PosZ = Columns[int32(EGaussianSplatColumn::Z)];
+	float* Scale[3] = { Columns[int32(EGaussianSplatColumn::Scale0)], Columns[int32(EGaussianSplatColumn::Scale1)], Columns[int32(EGaussianSplatColumn::Scale2)] };
+	// Packed in x, y, z, w order, i.e. rot_1, rot_2, rot_3, rot_0
+	float* Rot[4] = { Columns[int32(EGaussianSplatColumn::Rot1)], Columns[int32(EGaussianSplatColumn::Rot2)], Columns[int32(EGaussianSplatColumn::Rot3)], Columns[int32(EGaussianSplatColumn::Rot0)] };
+	float* DC[3] = { Columns[int32(EGaussianSplatColumn::DC0)], Columns[int32(EGaussianSplatColumn::DC1)], Columns[int32(EGaussianSplatColumn::DC2)] };
+	float* Opacity = Columns[int32(EGaussianSplatColumn::Opacity)];
+
+	std::atomic<bool> bFailed(false);
+	ParallelFor(FGaussianSplatBuffer::NumTasks(NumRows), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumRows);
+		uint32* Rows = Packed.GetData() + Begin * 4;
+		if (!Reader.extract_properties_range(PropIdxs, 4, miniply::PLYPropertyType::UInt, Rows, uint32(Begin), uint32(End - Begin))) {
+			bFailed = true;
+			return;
+		}
+
+		for (int32 i = Begin; i < End; i++, Rows += 4) {
+			const float* Chunk = Chunks.GetData() + ((FirstRow + uint32(i)) / SplatsPerChunk) * NumChunkBounds;
+
+			// Position and log scale: 11/10/11 bits between the chunk's min and max
+			const uint32 Position = Rows[0];
+			PosX[i] = FMath::Lerp(Chunk[MinX], Chunk[MaxX], UnpackUnorm(Position >> 21, 11));
+			PosY[i] = FMath::Lerp(Chunk[MinY], Chunk[MaxY], UnpackUnorm(Position >> 11, 10));
+			PosZ[i] = FMath::Lerp(Chunk[MinZ], Chunk[MaxZ], UnpackUnorm(Position, 11));
+
+			const uint32 PackedScale = Rows[2];
+			Scale[0][i] = FMath::Lerp(Chunk[MinScaleX], Chunk[MaxScaleX], UnpackUnorm(PackedScale >> 21, 11));
+			Scale[1][i] = FMath::Lerp(Chunk[MinScaleY], Chunk[MaxScaleY], UnpackUnorm(PackedScale >> 11, 10));
+			Scale[2][i] = FMath::Lerp(Chunk[MinScaleZ], Chunk[MaxScaleZ], UnpackUnorm(PackedScale, 11));
+
+			// Rotation: the three smallest components in [-1/sqrt(2), 1/sqrt(2)], the largest rebuilt from unit length
+			const uint32 Rotation = Rows[1];
+			const float Norm = UE_SQRT_2;
+			const float A = (UnpackUnorm(Rotation >> 20, 10) - 0.5f) * Norm;
+			const float B = (UnpackUnorm(Rotation >> 10, 10) - 0.5f) * Norm;
+			const float C = (UnpackUnorm(Rotation, 10) - 0.5f) * Norm;
+			const float M = FMath::Sqrt(FMath::Max(1.0f - (A * A + B * B + C * C), 0.0f));
+			const uint32 Largest = Rotation >> 30;
+			const float Small[3] = { A, B, C };
+			for (uint32 Component = 0, SmallIndex = 0; Component < 4; Component++) {
+				Rot[Component][i] = Component == Largest ? M : Small[SmallIndex++];
+			}
+
+			// Color is stored as the displayed base color, opacity after the sigmoid
+			const uint32 Color = Rows[3];
+			float RGB[3] = { UnpackUnorm(Color >> 24, 8), UnpackUnorm(Color >> 16, 8), UnpackUnorm(Color >> 8, 8) };
+			for (int32 Channel = 0; Channel < 3; Channel++) {
+				if (bChunkColors) {
+					RGB[Channel] = FMath::Lerp(Chunk[MinR + Channel], Chunk[MaxR + Channel], RGB[Channel]);
+				}
+				DC[Channel][i] = (RGB[Channel] - 0.5f) / SH_C0;
+			}
+			const float Alpha = UnpackUnorm(Color, 8);
+			Opacity[i] = -FMath::Loge(1.0f / Alpha - 1.0f);
+		}
+	});
+	return !bFailed;
+}
+
+bool FCompressedSplatDecoder::DecodeHarmonics(const miniply::PLYReader& Reader, int32 SHDegree) {
+	FGaussianSplatBuffer Harmonics;
+	Harmonics.Resolve(*Reader.element());
+	FileSHDegree = Harmonics.SHDegree();
+	SHDegree = FMath::Min(SHDegree, FileSHDegree);
+
+	const int32 Stride = RestChannelStride();
+	const int32 NumKept = FGaussianSplatBuffer::NumSHCoefficientsForDegree(SHDegree);
+	const int32 NumRows = int32(Reader.num_loaded_rows());
+	float* Next = AllocateColumns(3 * NumKept, NumRows);
+
+	uint32 PropIdxs[FGaussianSplatBuffer::NumRestCoefficients];
+	float* Dest[FGaussianSplatBuffer::NumRestCoefficients];
+	int32 NumProps = 0;
+	for (int32 Channel = 0; Channel < 3; Channel++) {
+		for (int32 y = 0; y < NumKept; y++) {
+			const int32 Rest = Channel * Stride + y;
+			PropIdxs[NumProps] = Reader.element()->find_property(FGaussianSplatBuffer::ColumnName(int32(EGaussianSplatColumn::Rest0) + Rest));
+			Dest[NumProps] = Columns[int32(EGaussianSplatColumn::Rest0) + Rest] = Next;
+			Next += NumRows;
+			NumProps++;
+		}
+	}
+
+	std::atomic<bool> bFailed(false);
+	ParallelFor(FGaussianSplatBuffer::NumTasks(NumRows), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumRows);
+		for (int32 Prop = 0; Prop < NumProps; Prop++) {
+			float* Values = Dest[Prop] + Begin;
+			if (!Reader.extract_properties_range(&PropIdxs[Prop], 1, miniply::PLYPropertyType::Float, Values, uint32(Begin), uint32(End - Begin))) {
+				bFailed = true;
+				return;
+			}
+			// 8 bits over [-4, 4), with 0 reserved for the lowest value
+			for (int32 i = 0; i < End - Begin; i++) {
+				const float Quantized = Values[i] == 0.0f ? 0.0f : (Values[i] + 0.5f) / 256.0f;
+				Values[i] = (Quantized - 0.5f) * 8.0f;
+			}
+		}
+	});
+	return !bFailed;
+}
+
+void FCompressedSplatDecoder::Reset() {
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		Columns[Col] = nullptr;
+	}
+	Chunks.Empty();
+	NumChunks = 0;
+	Storage.Empty();
+	Packed.Empty();
+	Arena = nullptr;
+	ArenaColumns = 0;
+	ArenaStorage = nullptr;
+	ArenaStorageSize = 0;
+	NumSplats = 0;
+}
@@ -0,0 +1,227 @@
+// GaussianSplatBuffer.cpp
+
+#include "GaussianSplatBuffer.h"
+#include "Miniply.h"
+#include "SplatArena.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+static const char* const kColumnNames[FGaussianSplatBuffer::NumColumns] = {
+	"x", "y", "z",
+	"nx", "ny", "nz",
+	"f_dc_0", "f_dc_1", "f_dc_2",
+	"f_rest_0", "f_rest_1", "f_rest_2", "f_rest_3", "f_rest_4", "f_rest_5", "f_rest_6", "f_rest_7", "f_rest_8",
+	"f_rest_9", "f_rest_10", "f_rest_11", "f_rest_12", "f_rest_13", "f_rest_14", "f_rest_15", "f_rest_16", "f_rest_17",
+	"f_rest_18", "f_rest_19", "f_rest_20", "f_rest_21", "f_rest_22", "f_rest_23", "f_rest_24", "f_rest_25", "f_rest_26",
+	"f_rest_27", "f_rest_28", "f_rest_29", "f_rest_30", "f_rest_31", "f_rest_32", "f_rest_33", "f_rest_34", "f_rest_35",
+	"f_rest_36", "f_rest_37", "f_rest_38", "f_rest_39", "f_rest_40", "f_rest_41", "f_rest_42", "f_rest_43", "f_rest_44",
+	"opacity",
+	"scale_0", "scale_1", "scale_2",
+	"rot_0", "rot_1", "rot_2", "rot_3",
+};
+
+FGaussianSplatBuffer::FGaussianSplatBuffer()
+	: Storage()
+	, Arena(nullptr)
+	, ArenaStorage(nullptr)
+	, ArenaStorageSize(0)
+	, NumSplats(0)
+	, FileSHDegree(0)
+{
+	for (int32 Col = 0; Col < NumColumns; Col++)
+	{
+		PropertyIndices[Col] = miniply::kInvalidIndex;
+		Columns[Col] = nullptr;
+	}
+}
+
+void FGaussianSplatBuffer::Resolve(const miniply::PLYElement& Element)
+{
+	for (int32 Col = 0; Col < NumColumns; Col++)
+	{
+		PropertyIndices[Col] = Element.find_property(kColumnNames[Col]);
+	}
+
+	int32 NumRest = 0;
+	while (NumRest < NumRestCoefficients && PropertyIndices[int32(EGaussianSplatColumn::Rest0) + NumRest] != miniply::kInvalidIndex)
+	{
+		NumRest++;
+	}
+
+	FileSHDegree = 0;
+	for (int32 Degree = 1; Degree <= 3; Degree++)
+	{
+		if (NumRestCoefficientsForDegree(Degree) == NumRest)
+		{
+			FileSHDegree = Degree;
+		}
+	}
+	if (FileSHDegree == 0 && NumRest > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GaussianSplatBuffer: %d f_rest_* properties do not match any spherical harmonics degree, ignoring them"), NumRest);
+	}
+	ExcludeSHAbove(FileSHDegree);
+}
+
+void FGaussianSplatBuffer::Exclude(EGaussianSplatColumn First, int32 Count)
+{
+	for (int32 Col = int32(First); Col < int32(First) + Count; Col++)
+	{
+		PropertyIndices[Col] = miniply::kInvalidIndex;
+	}
+}
+
+void FGaussianSplatBuffer::ExcludeSHAbove(int32 Degree)
+{
+	if (Degree >= FileSHDegree)
+	{
+		// Also drops stray coefficients past the file's own degree
+		const int32 NumRest = NumRestCoefficientsForDegree(FileSHDegree);
+		Exclude(EGaussianSplatColumn(int32(EGaussianSplatColumn::Rest0) + NumRest), NumRestCoefficients - NumRest);
+		return;
+	}
+
+	const int32 Stride = RestChannelStride();
+	const int32 NumKept = NumSHCoefficientsForDegree(FMath::Max(Degree, 0));
+	for (int32 Channel = 0; Channel < 3; Channel++)
+	{
+		Exclude(EGaussianSplatColumn(int32(EGaussianSplatColumn::Rest0) + Channel * Stride + NumKept), Stride - NumKept);
+	}
+}
+
+bool FGaussianSplatBuffer::Project(miniply::PLYReader& Reader) const
+{
+	uint32 Projection[NumColumns];
+	uint32 NumProjected = 0;
+	for (int32 Col = 0; Col < NumColumns; Col++)
+	{
+		if (PropertyIndices[Col] != miniply::kInvalidIndex)
+		{
+			Projection[NumProjected++] = PropertyIndices[Col];
+		}
+	}
+	return Reader.set_projection(Projection, NumProjected);
+}
+
+int64 FGaussianSplatBuffer::GetBatchBytes(uint32 NumRows) const
+{
+	return int64(NumResolvedColumns()) * NumRows * sizeof(float);
+}
+
+bool FGaussianSplatBuffer::Load(const miniply::PLYReader& Reader)
+{
+	// Keep the allocation when streaming batches of the same size through the buffer
+	NumSplats = int32(Reader.num_loaded_rows());
+	const int64 NumValues = int64(NumResolvedColumns()) * NumSplats;
+
+	float* Next;
+	if (Arena)
+	{
+		if (NumValues > ArenaStorageSize)
+		{
+			ArenaStorage = Arena->AllocateArray<float>(NumValues);
+			ArenaStorageSize = NumValues;
+		}
+		Next = ArenaStorage;
+	}
+	else
+	{
+		Storage.SetNumUninitialized(int32(NumValues), EAllowShrinking::No);
+		Next = Storage.GetData();
+	}
+	for (int32 Col = 0; Col < NumColumns; Col++)
+	{
+		if (PropertyIndices[Col] != miniply::kInvalidIndex)
+		{
+			Columns[Col] = Next;
+			Next += NumSplats;
+		}
+		else
+		{
+			Columns[Col] = nullptr;
+		}
+	}
+
+	// Each task decodes every column for its own row range, so the rows it
+	// touches in the (possibly memory-mapped) element stay hot in cache.
+	std::atomic<bool> bFailed(false);
+	ParallelFor(NumTasks(NumSplats), [this, &Reader, &bFailed](int32 Task)
+	{
+		const uint32 FirstRow = uint32(Task) * RowsPerTask;
+		const uint32 NumRows = FMath::Min<uint32>(RowsPerTask, uint32(NumSplats) - FirstRow);
+		for (int32 Col = 0; Col < NumColumns; Col++)
+		{
+			if (Columns[Col] && !Reader.extract_properties_range(&PropertyIndices[Col], 1, miniply::PLYPropertyType::Float, Columns[Col] + FirstRow, FirstRow, NumRows))
+			{
+				bFailed = true;
+			}
+		}
+	});
+
+	if (bFailed)
+	{
+		Reset();
+		return false;
+	}
+	return true;
+}
+
+void FGaussianSplatBuffer::Reset()
+{
+	for (int32 Col = 0; Col < NumColumns; Col++)
+	{
+		Columns[Col] = nullptr;
+	}
+	Storage.Empty();
+	// Arena memory is owned by the arena and released with it
+	ArenaStorage = nullptr;
+	ArenaStorageSize = 0;
+	NumSplats = 0;
+}
+
+bool FGaussianSplatBuffer::IsCanonicalLayout(const miniply::PLYElement& Element)
+{
+	if (Element.properties.size() != size_t(NumColumns) || !Element.fixedSize || Element.rowStride != uint32(CanonicalRowStride))
+	{
+		return false;
+	}
+	for (int32 Col = 0; Col < NumColumns; Col++)
+	{
+		const miniply::PLYProperty& Prop = Element.properties[Col];
+		if (Prop.type != miniply::PLYPropertyType::Float || Prop.name != kColumnNames[Col])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+const char* FGaussianSplatBuffer::ColumnName(int32 InColumn)
+{
+	return kColumnNames[InColumn];
+}
+
+bool FGaussianSplatBuffer::HasColumns(EGaussianSplatColumn First, int32 Count) const
+{
+	for (int32 Col = int32(First); Col < int32(First) + Count; Col++)
+	{
+		if (PropertyIndices[Col] == miniply::kInvalidIndex)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int32 FGaussianSplatBuffer::NumResolvedColumns() const
+{
+	int32 NumResolved = 0;
+	for (int32 Col = 0; Col < NumColumns; Col++)
+	{
+		if (PropertyIndices[Col] != miniply::kInvalidIndex)
+		{
+			NumResolved++;
+		}
+	}
+	return NumResolved;
+}
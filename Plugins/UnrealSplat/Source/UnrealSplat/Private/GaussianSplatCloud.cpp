@@ -0,0 +1,117 @@
+// GaussianSplatCloud.cpp
+
+#include "GaussianSplatCloud.h"
+#include "Parser.h"
+
+void UGaussianSplatCloud::Allocate(int32 InNumSplats, bool bPositions, bool bNormals, bool bOrientations, bool bScales, bool bOpacity, bool bZeroOrderHarmonics, int32 InSHDegree)
+{
+	NumSplats = InNumSplats;
+	SHDegree = InSHDegree;
+	Positions.SetNumUninitialized(bPositions ? NumSplats : 0);
+	Normals.SetNumUninitialized(bNormals ? NumSplats : 0);
+	Orientations.SetNumUninitialized(bOrientations ? NumSplats : 0);
+	Scales.SetNumUninitialized(bScales ? NumSplats : 0);
+	Opacities.SetNumUninitialized(bOpacity ? NumSplats : 0);
+	ZeroOrderHarmonics.SetNumUninitialized(bZeroOrderHarmonics ? NumSplats : 0);
+	HigherOrderHarmonics.SetNumUninitialized(NumSplats * GetNumSHCoefficients() * 3);
+}
+
+int32 UGaussianSplatCloud::GetMaxSplats(int32 InSHDegree)
+{
+	const int32 NumValues = ((InSHDegree + 1) * (InSHDegree + 1) - 1) * 3;
+	return NumValues > 0 ? MAX_int32 / NumValues : MAX_int32;
+}
+
+void UGaussianSplatCloud::Empty()
+{
+	Positions.Empty();
+	Normals.Empty();
+	Orientations.Empty();
+	Scales.Empty();
+	Opacities.Empty();
+	ZeroOrderHarmonics.Empty();
+	HigherOrderHarmonics.Empty();
+	NumSplats = 0;
+	SHDegree = 0;
+}
+
+FGaussianSplatData UGaussianSplatCloud::ToSplatData() const
+{
+	FGaussianSplatData SplatData;
+	const int32 NumCoefficients = GetNumSHCoefficients();
+
+	SplatData.Positions.SetNumUninitialized(Positions.Num());
+	SplatData.Normals.SetNumUninitialized(Normals.Num());
+	SplatData.Orientations.SetNumUninitialized(Orientations.Num());
+	SplatData.Scales.SetNumUninitialized(Scales.Num());
+	SplatData.Opacity = Opacities;
+	SplatData.ZeroOrderHarmonicsCoefficients.SetNumUninitialized(ZeroOrderHarmonics.Num());
+	SplatData.HighOrderHarmonicsCoefficients.SetNum(NumCoefficients > 0 ? NumSplats : 0);
+
+	for (int32 i = 0; i < Positions.Num(); i++) {
+		SplatData.Positions[i] = FVector(Positions[i]);
+	}
+	for (int32 i = 0; i < Normals.Num(); i++) {
+		SplatData.Normals[i] = FVector(Normals[i]);
+	}
+	for (int32 i = 0; i < Orientations.Num(); i++) {
+		SplatData.Orientations[i] = FQuat(Orientations[i]);
+	}
+	for (int32 i = 0; i < Scales.Num(); i++) {
+		SplatData.Scales[i] = FVector(Scales[i]);
+	}
+	for (int32 i = 0; i < ZeroOrderHarmonics.Num(); i++) {
+		SplatData.ZeroOrderHarmonicsCoefficients[i] = FVector(ZeroOrderHarmonics[i]);
+	}
+	if (NumCoefficients > 0) {
+		for (int32 i = 0; i < NumSplats; i++) {
+			SplatData.HighOrderHarmonicsCoefficients[i].Values = GetHigherOrderHarmonics(i);
+		}
+	}
+	return SplatData;
+}
+
+FVector UGaussianSplatCloud::GetPosition(int32 Index) const
+{
+	return Positions.IsValidIndex(Index) ? FVector(Positions[Index]) : FVector::ZeroVector;
+}
+
+FVector UGaussianSplatCloud::GetNormal(int32 Index) const
+{
+	return Normals.IsValidIndex(Index) ? FVector(Normals[Index]) : FVector::ZeroVector;
+}
+
+FQuat UGaussianSplatCloud::GetOrientation(int32 Index) const
+{
+	return Orientations.IsValidIndex(Index) ? FQuat(Orientations[Index]) : FQuat::Identity;
+}
+
+FVector UGaussianSplatCloud::GetScale(int32 Index) const
+{
+	return Scales.IsValidIndex(Index) ? FVector(Scales[Index]) : FVector::OneVector;
+}
+
+float UGaussianSplatCloud::GetOpacity(int32 Index) const
+{
+	return Opacities.IsValidIndex(Index) ? Opacities[Index] : 1.0f;
+}
+
+FVector UGaussianSplatCloud::GetZeroOrderHarmonics(int32 Index) const
+{
+	return ZeroOrderHarmonics.IsValidIndex(Index) ? FVector(ZeroOrderHarmonics[Index]) : FVector::ZeroVector;
+}
+
+TArray<FVector> UGaussianSplatCloud::GetHigherOrderHarmonics(int32 Index) const
+{
+	TArray<FVector> Values;
+	const int32 NumCoefficients = GetNumSHCoefficients();
+	if (NumCoefficients == 0 || Index < 0 || Index >= NumSplats) {
+		return Values;
+	}
+	const float* Coefficients = HigherOrderHarmonics.GetData() + SIZE_T(Index) * NumCoefficients * 3;
+	Values.SetNumUninitialized(NumCoefficients);
+	for (int32 y = 0; y < NumCoefficients; y++) {
+		Values[y] = FVector(Coefficients[3 * y], Coefficients[3 * y + 1], Coefficients[3 * y + 2]);
+	}
+	return Values;
+}
@@ -2,9 +2,25 @@
 // Simple 4D Gaussian Splatting - direct texture swapping on Niagara
 
 #include "GaussianSplatLiveActor.h"
+#include "GaussianSplatPages.h"
+#include "SplatTexturePages.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
 
+// The preprocessor only writes the harmonics textures of the degrees present in the PLY
+static int32 GetHarmonicsDegree(const FGaussianSplatFramePage& Page)
+{
+    if (!Page.HarmonicsL1Texture)
+    {
+        return 0;
+    }
+    if (!Page.HarmonicsL2Texture)
+    {
+        return 1;
+    }
+    return Page.HarmonicsL31Texture && Page.HarmonicsL32Texture ? 3 : 2;
+}
+
 AGaussianSplatLiveActor::AGaussianSplatLiveActor()
 {
     PrimaryActorTick.bCanEverTick = true;
@@ -93,19 +109,46 @@ void AGaussianSplatLiveActor::LoadFrames()
         FString GamePath = FString::Printf(TEXT("/Game/%s/%s/%s"), *BasePath, *ModelName, *FolderName);
 
         FGaussianSplatFrame Frame;
-        Frame.PositionTexture = LoadTexture(GamePath, TEXT("positiontexture"));
-        Frame.ScaleTexture = LoadTexture(GamePath, TEXT("scaletexture"));
-        Frame.ColorTexture = LoadTexture(GamePath, TEXT("colortexture"));
-        Frame.RotationTexture = LoadTexture(GamePath, TEXT("rotationtexture"));
-        Frame.HarmonicsL1Texture = LoadTexture(GamePath, TEXT("harmonicsl1texture"));
-        Frame.HarmonicsL2Texture = LoadTexture(GamePath, TEXT("harmonicsl2texture"));
-        Frame.HarmonicsL31Texture = LoadTexture(GamePath, TEXT("harmonicsl31texture"));
-        Frame.HarmonicsL32Texture = LoadTexture(GamePath, TEXT("harmonicsl32texture"));
-
-        if (Frame.PositionTexture)
+        for (int32 PageIndex = 0;; PageIndex++)
+        {
+            auto LoadPageTexture = [&](const TCHAR* Name)
+            {
+                return LoadTexture(GamePath, FSplatTexturePages::GetPageTextureName(Name, PageIndex));
+            };
+
+            FGaussianSplatFramePage Page;
+            Page.PositionTexture = LoadPageTexture(TEXT("positiontexture"));
+            if (!Page.PositionTexture)
+            {
+                break;
+            }
+            Page.ScaleTexture = LoadPageTexture(TEXT("scaletexture"));
+            Page.ColorTexture = LoadPageTexture(TEXT("colortexture"));
+            Page.RotationTexture = LoadPageTexture(TEXT("rotationtexture"));
+            Page.HarmonicsL1Texture = LoadPageTexture(TEXT("harmonicsl1texture"));
+            Page.HarmonicsL2Texture = LoadPageTexture(TEXT("harmonicsl2texture"));
+            Page.HarmonicsL31Texture = LoadPageTexture(TEXT("harmonicsl31texture"));
+            Page.HarmonicsL32Texture = LoadPageTexture(TEXT("harmonicsl32texture"));
+            Page.ChunkRangeTexture = LoadPageTexture(TEXT("chunkrangetexture"));
+
+            Page.SHDegree = GetHarmonicsDegree(Page);
+
+            Frame.Pages.Add(Page);
+        }
+
+        if (Frame.Pages.Num() > 0)
         {
+            const FGaussianSplatFramePage& FirstPage = Frame.Pages[0];
+            Frame.PositionTexture = FirstPage.PositionTexture;
+            Frame.ScaleTexture = FirstPage.ScaleTexture;
+            Frame.ColorTexture = FirstPage.ColorTexture;
+            Frame.RotationTexture = FirstPage.RotationTexture;
+            Frame.HarmonicsL1Texture = FirstPage.HarmonicsL1Texture;
+            Frame.HarmonicsL2Texture = FirstPage.HarmonicsL2Texture;
+            Frame.HarmonicsL31Texture = FirstPage.HarmonicsL31Texture;
+            Frame.HarmonicsL32Texture = FirstPage.HarmonicsL32Texture;
             Frames.Add(Frame);
-            UE_LOG(LogTemp, Log, TEXT("GaussianSplatLive: Loaded frame %d from %s"), Frames.Num() - 1, *FolderName);
+            UE_LOG(LogTemp, Log, TEXT("GaussianSplatLive: Loaded frame %d (%d pages) from %s"), Frames.Num() - 1, Frame.Pages.Num(), *FolderName);
         }
         else
         {
@@ -118,6 +161,22 @@ void AGaussianSplatLiveActor::LoadFrames()
 
     if (Frames.Num() > 0)
     {
+        // Systems without User.SHDegree sample their harmonics textures whatever the frame has
+        const int32 SampledSHDegree = UGaussianSplatPageLibrary::GetSampledSHDegree(GetNiagaraComponent());
+        int32 MinSHDegree = 3;
+        for (const FGaussianSplatFrame& Frame : Frames)
+        {
+            for (const FGaussianSplatFramePage& Page : Frame.Pages)
+            {
+                MinSHDegree = FMath::Min(MinSHDegree, Page.SHDegree);
+            }
+        }
+        if (MinSHDegree < SampledSHDegree)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("GaussianSplatLive: Frames of '%s' have harmonics of degree %d, but the target system samples degree %d"),
+                *ModelName, MinSHDegree, SampledSHDegree);
+        }
+
         FrameIndex = 0;
         ApplyCurrentFrame();
     }
@@ -155,31 +214,72 @@ void AGaussianSplatLiveActor::ApplyFrameToNiagara(const FGaussianSplatFrame& Fra
         return;
     }
 
+    // Frames set up without pages, e.g. from Blueprints, have page 0 alone
+    TArray<FGaussianSplatFramePage> LegacyPages;
+    if (Frame.Pages.Num() == 0 && Frame.PositionTexture)
+    {
+        FGaussianSplatFramePage& Page = LegacyPages.AddDefaulted_GetRef();
+        Page.PositionTexture = Frame.PositionTexture;
+        Page.ScaleTexture = Frame.ScaleTexture;
+        Page.ColorTexture = Frame.ColorTexture;
+        Page.RotationTexture = Frame.RotationTexture;
+        Page.HarmonicsL1Texture = Frame.HarmonicsL1Texture;
+        Page.HarmonicsL2Texture = Frame.HarmonicsL2Texture;
+        Page.HarmonicsL31Texture = Frame.HarmonicsL31Texture;
+        Page.HarmonicsL32Texture = Frame.HarmonicsL32Texture;
+        Page.SHDegree = GetHarmonicsDegree(Page);
+    }
+    const TArray<FGaussianSplatFramePage>& Pages = Frame.Pages.Num() > 0 ? Frame.Pages : LegacyPages;
+
+    // One system per page; components of pages the frame does not have are deactivated
+    UGaussianSplatPageLibrary::SetNumPageComponents(NC, Pages.Num(), PageComponents);
+    for (int32 PageIndex = 0; PageIndex < Pages.Num(); PageIndex++)
+    {
+        UNiagaraComponent* PageNC = PageComponents[PageIndex];
+        if (IsValid(PageNC))
+        {
+            if (!PageNC->IsActive())
+            {
+                PageNC->Activate();
+            }
+            ApplyPageToNiagara(PageNC, Pages[PageIndex]);
+        }
+    }
+}
+
+void AGaussianSplatLiveActor::ApplyPageToNiagara(UNiagaraComponent* NC, const FGaussianSplatFramePage& Page)
+{
     // Set texture parameters directly on Niagara
     // These names must match the Niagara system's User parameters
-    if (Frame.PositionTexture)
-        NC->SetVariableTexture(TEXT("User.PositionTexture"), Frame.PositionTexture);
+    if (Page.PositionTexture)
+        NC->SetVariableTexture(TEXT("User.PositionTexture"), Page.PositionTexture);
+
+    if (Page.ScaleTexture)
+        NC->SetVariableTexture(TEXT("User.ScaleTexture"), Page.ScaleTexture);
+
+    if (Page.ColorTexture)
+        NC->SetVariableTexture(TEXT("User.ColorTexture"), Page.ColorTexture);
 
-    if (Frame.ScaleTexture)
-        NC->SetVariableTexture(TEXT("User.ScaleTexture"), Frame.ScaleTexture);
+    if (Page.RotationTexture)
+        NC->SetVariableTexture(TEXT("User.RotationTexture"), Page.RotationTexture);
 
-    if (Frame.ColorTexture)
-        NC->SetVariableTexture(TEXT("User.ColorTexture"), Frame.ColorTexture);
+    if (Page.HarmonicsL1Texture)
+        NC->SetVariableTexture(TEXT("User.HarmonicsL1Texture"), Page.HarmonicsL1Texture);
 
-    if (Frame.RotationTexture)
-        NC->SetVariableTexture(TEXT("User.RotationTexture"), Frame.RotationTexture);
+    if (Page.HarmonicsL2Texture)
+        NC->SetVariableTexture(TEXT("User.HarmonicsL2Texture"), Page.HarmonicsL2Texture);
 
-    if (Frame.HarmonicsL1Texture)
-        NC->SetVariableTexture(TEXT("User.HarmonicsL1Texture"), Frame.HarmonicsL1Texture);
+    if (Page.HarmonicsL31Texture)
+        NC->SetVariableTexture(TEXT("User.HarmonicsL31Texture"), Page.HarmonicsL31Texture);
 
-    if (Frame.HarmonicsL2Texture)
-        NC->SetVariableTexture(TEXT("User.HarmonicsL2Texture"), Frame.HarmonicsL2Texture);
+    if (Page.HarmonicsL32Texture)
+        NC->SetVariableTexture(TEXT("User.HarmonicsL32Texture"), Page.HarmonicsL32Texture);
 
-    if (Frame.HarmonicsL31Texture)
-        NC->SetVariableTexture(TEXT("User.HarmonicsL31Texture"), Frame.HarmonicsL31Texture);
+    if (Page.ChunkRangeTexture)
+        NC->SetVariableTexture(TEXT("User.ChunkRangeTexture"), Page.ChunkRangeTexture);
 
-    if (Frame.HarmonicsL32Texture)
-        NC->SetVariableTexture(TEXT("User.HarmonicsL32Texture"), Frame.HarmonicsL32Texture);
+    // Harmonics textures above this degree are left over from an earlier frame and must not be sampled
+    NC->SetVariableInt(TEXT("User.SHDegree"), Page.SHDegree);
 }
 
 void AGaussianSplatLiveActor::Play()
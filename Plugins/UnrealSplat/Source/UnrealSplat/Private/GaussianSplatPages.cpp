@@ -0,0 +1,109 @@
+// GaussianSplatPages.cpp
+
+#include "GaussianSplatPages.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Engine/Texture2D.h"
+
+void UGaussianSplatPageLibrary::SetNumPageComponents(UNiagaraComponent* FirstPage, int32 NumPages, TArray<UNiagaraComponent*>& Components)
+{
+	if (!FirstPage)
+	{
+		return;
+	}
+	AActor* Owner = FirstPage->GetOwner();
+	Components.SetNum(FMath::Max(Components.Num(), NumPages));
+	if (Components.Num() > 0)
+	{
+		Components[0] = FirstPage;
+	}
+
+	for (int32 PageIndex = 1; PageIndex < Components.Num(); PageIndex++)
+	{
+		UNiagaraComponent*& Component = Components[PageIndex];
+		if (PageIndex >= NumPages)
+		{
+			if (IsValid(Component))
+			{
+				Component->Deactivate();
+			}
+			continue;
+		}
+		if (!IsValid(Component) && Owner)
+		{
+			Component = NewObject<UNiagaraComponent>(Owner, FName(*FString::Printf(TEXT("%s_Page%d"), *FirstPage->GetName(), PageIndex)), RF_Transient);
+			Component->SetAsset(FirstPage->GetAsset());
+			Component->AttachToComponent(FirstPage, FAttachmentTransformRules::SnapToTargetIncludingScale);
+			Component->RegisterComponent();
+			Owner->AddInstanceComponent(Component);
+		}
+		else if (IsValid(Component) && Component->GetAsset() != FirstPage->GetAsset())
+		{
+			Component->SetAsset(FirstPage->GetAsset());
+		}
+	}
+}
+
+int32 UGaussianSplatPageLibrary::GetSampledSHDegree(const UNiagaraComponent* Component)
+{
+	const UNiagaraSystem* System = Component ? Component->GetAsset() : nullptr;
+	if (!System)
+	{
+		return 0;
+	}
+	TArray<FNiagaraVariable> Parameters;
+	System->GetExposedParameters().GetParameters(Parameters);
+	auto HasParameter = [&Parameters](const TCHAR* Name)
+	{
+		return Parameters.ContainsByPredicate([Name](const FNiagaraVariable& Parameter) { return Parameter.GetName() == FName(Name); });
+	};
+	if (HasParameter(TEXT("User.SHDegree")))
+	{
+		return 0;
+	}
+	return HasParameter(TEXT("User.SH1Texture")) || HasParameter(TEXT("User.HarmonicsL1Texture")) ? ShippedSHRendererDegree : 0;
+}
+
+void UGaussianSplatPageLibrary::ApplyTexturePages(UNiagaraComponent* FirstPage, const TArray<FTextureLocations>& Pages, TArray<UNiagaraComponent*>& Components)
+{
+	if (!FirstPage)
+	{
+		return;
+	}
+	SetNumPageComponents(FirstPage, FMath::Max(Pages.Num(), 1), Components);
+	const int32 SampledSHDegree = GetSampledSHDegree(FirstPage);
+
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); PageIndex++)
+	{
+		UNiagaraComponent* Component = Components[PageIndex];
+		if (!IsValid(Component))
+		{
+			continue;
+		}
+		const FTextureLocations& Page = Pages[PageIndex];
+		auto SetTexture = [Component](const TCHAR* Name, const TSoftObjectPtr<UTexture2D>& Location)
+		{
+			if (UTexture2D* Texture = Location.LoadSynchronous())
+			{
+				Component->SetVariableTexture(FName(Name), Texture);
+			}
+		};
+		SetTexture(TEXT("User.PositionTexture"), Page.PositionTextureLocation);
+		SetTexture(TEXT("User.ScaleTexture"), Page.ScaleTextureLocation);
+		SetTexture(TEXT("User.ColorTexture"), Page.ColorTextureLocation);
+		SetTexture(TEXT("User.RotationTexture"), Page.RotationTextureLocation);
+		SetTexture(TEXT("User.SH1Texture"), Page.HarmonicsL1TextureLocation);
+		SetTexture(TEXT("User.SH2Texture"), Page.HarmonicsL2TextureLocation);
+		SetTexture(TEXT("User.SH31Texture"), Page.HarmonicsL31TextureLocation);
+		SetTexture(TEXT("User.SH32Texture"), Page.HarmonicsL32TextureLocation);
+		SetTexture(TEXT("User.ChunkRangeTexture"), Page.ChunkRangeTextureLocation);
+		if (Page.SHDegree < SampledSHDegree)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Page %d has harmonics of degree %d, but %s samples degree %d; the missing bands read stale or default textures"),
+				PageIndex, Page.SHDegree, *GetNameSafe(FirstPage->GetAsset()), SampledSHDegree);
+		}
+
+		// Particles are spawned from the textures, so the system starts over with the new ones
+		Component->ReinitializeSystem();
+	}
+}
@@ -0,0 +1,182 @@
+// ImageSplatSequence.cpp
+
+#include "ImageSplatSequence.h"
+#include "IImageWrapperModule.h"
+#include "ImageCore.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+const TCHAR* FImageSplatSequence::SidecarFileName = TEXT("sequence.json");
+
+// Image files are looked up with these extensions, in this order
+static const TCHAR* const kImageExtensions[] = { TEXT("png"), TEXT("exr") };
+
+// Attribute images of a frame and the raw columns their channels hold
+struct FImageAttribute {
+	const TCHAR* Name;
+	int32 NumChannels;
+	EGaussianSplatColumn Columns[4];
+};
+
+static const FImageAttribute kImageAttributes[FImageSplatSequence::NumAttributes] = {
+	{ TEXT("position"), 3, { EGaussianSplatColumn::X, EGaussianSplatColumn::Y, EGaussianSplatColumn::Z } },
+	{ TEXT("scale"), 3, { EGaussianSplatColumn::Scale0, EGaussianSplatColumn::Scale1, EGaussianSplatColumn::Scale2 } },
+	{ TEXT("rotation"), 4, { EGaussianSplatColumn::Rot0, EGaussianSplatColumn::Rot1, EGaussianSplatColumn::Rot2, EGaussianSplatColumn::Rot3 } },
+	{ TEXT("color"), 4, { EGaussianSplatColumn::DC0, EGaussianSplatColumn::DC1, EGaussianSplatColumn::DC2, EGaussianSplatColumn::Opacity } },
+};
+
+static int32 NumImageColumns() {
+	int32 NumColumns = 0;
+	for (const FImageAttribute& Attribute : kImageAttributes) {
+		NumColumns += Attribute.NumChannels;
+	}
+	return NumColumns;
+}
+
+// ---------- FImageSplatFrame ----------
+
+FImageSplatFrame::FImageSplatFrame()
+	: Error()
+	, Storage()
+	, NumSplats(0)
+{
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		Columns[Col] = nullptr;
+	}
+}
+
+// ---------- FImageSplatSequence ----------
+
+bool FImageSplatSequence::IsImageSequence(const FString& AbsoluteDirectory) {
+	return FPaths::FileExists(AbsoluteDirectory / SidecarFileName);
+}
+
+bool FImageSplatSequence::ParseRanges(const FJsonObject& RangesObject, FRange* OutRanges) {
+	for (int32 Index = 0; Index < NumAttributes; Index++) {
+		const FImageAttribute& Attribute = kImageAttributes[Index];
+		const TSharedPtr<FJsonObject>* Range = nullptr;
+		if (!RangesObject.TryGetObjectField(Attribute.Name, Range)) {
+			continue;
+		}
+		const TArray<TSharedPtr<FJsonValue>>* Min = nullptr;
+		const TArray<TSharedPtr<FJsonValue>>* Max = nullptr;
+		if (!(*Range)->TryGetArrayField(TEXT("min"), Min) || !(*Range)->TryGetArrayField(TEXT("max"), Max)
+			|| Min->Num() < Attribute.NumChannels || Max->Num() < Attribute.NumChannels) {
+			return false;
+		}
+		for (int32 Channel = 0; Channel < Attribute.NumChannels; Channel++) {
+			OutRanges[Index].Min[Channel] = float((*Min)[Channel]->AsNumber());
+			OutRanges[Index].Max[Channel] = float((*Max)[Channel]->AsNumber());
+		}
+	}
+	return true;
+}
+
+bool FImageSplatSequence::Open(const FString& AbsoluteDirectory) {
+	Directory = AbsoluteDirectory;
+	Frames.Reset();
+
+	const FString SidecarPath = AbsoluteDirectory / SidecarFileName;
+	FString Json;
+	TSharedPtr<FJsonObject> Root;
+	if (!FFileHelper::LoadFileToString(Json, *SidecarPath) || !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid()) {
+		Error = FString::Printf(TEXT("Cannot read %s"), *SidecarPath);
+		return false;
+	}
+
+	// Sequence-wide ranges, which every frame can override
+	FRange Defaults[NumAttributes];
+	const TSharedPtr<FJsonObject>* RangesObject = nullptr;
+	if (Root->TryGetObjectField(TEXT("ranges"), RangesObject) && !ParseRanges(**RangesObject, Defaults)) {
+		Error = FString::Printf(TEXT("Invalid ranges in %s"), *SidecarPath);
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* FrameValues = nullptr;
+	if (!Root->TryGetArrayField(TEXT("frames"), FrameValues) || FrameValues->Num() == 0) {
+		Error = FString::Printf(TEXT("No frames in %s"), *SidecarPath);
+		return false;
+	}
+	for (int32 Index = 0; Index < FrameValues->Num(); Index++) {
+		const TSharedPtr<FJsonObject>* FrameObject = nullptr;
+		FFrame& Frame = Frames.AddDefaulted_GetRef();
+		for (int32 Attribute = 0; Attribute < NumAttributes; Attribute++) {
+			Frame.Ranges[Attribute] = Defaults[Attribute];
+		}
+		if (!(*FrameValues)[Index]->TryGetObject(FrameObject)
+			|| !(*FrameObject)->TryGetStringField(TEXT("folder"), Frame.Folder)
+			|| !(*FrameObject)->TryGetNumberField(TEXT("count"), Frame.NumSplats) || Frame.NumSplats < 0
+			|| ((*FrameObject)->TryGetObjectField(TEXT("ranges"), RangesObject) && !ParseRanges(**RangesObject, Frame.Ranges))) {
+			Error = FString::Printf(TEXT("Invalid frame %d in %s"), Index, *SidecarPath);
+			return false;
+		}
+	}
+
+	// Loaded here because modules must not be loaded from the worker threads that decode frames
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	return true;
+}
+
+bool FImageSplatSequence::DecodeFrame(int32 FrameIndex, FImageSplatFrame& OutFrame) const {
+	const FFrame& Frame = Frames[FrameIndex];
+	const int32 NumSplats = Frame.NumSplats;
+	const FString FrameDirectory = Directory / Frame.Folder;
+
+	OutFrame.NumSplats = 0;
+	OutFrame.Error.Reset();
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		OutFrame.Columns[Col] = nullptr;
+	}
+	OutFrame.Storage.SetNumUninitialized(int64(NumImageColumns()) * NumSplats);
+	float* Next = OutFrame.Storage.GetData();
+
+	for (int32 Index = 0; Index < NumAttributes; Index++) {
+		const FImageAttribute& Attribute = kImageAttributes[Index];
+		const FRange& Range = Frame.Ranges[Index];
+
+		FString ImagePath;
+		for (const TCHAR* Extension : kImageExtensions) {
+			const FString Candidate = FrameDirectory / FString::Printf(TEXT("%s.%s"), Attribute.Name, Extension);
+			if (FPaths::FileExists(Candidate)) {
+				ImagePath = Candidate;
+				break;
+			}
+		}
+		TArray64<uint8> Compressed;
+		FImage Image;
+		if (ImagePath.IsEmpty() || !FFileHelper::LoadFileToArray(Compressed, *ImagePath)
+			|| !ImageWrapperModule->DecompressImage(Compressed.GetData(), Compressed.Num(), Image)) {
+			OutFrame.Error = FString::Printf(TEXT("Cannot decode the %s image in %s"), Attribute.Name, *FrameDirectory);
+			return false;
+		}
+		Compressed.Empty();
+		if (Image.GetNumPixels() < NumSplats) {
+			OutFrame.Error = FString::Printf(TEXT("%s holds %lld pixels for %d splats"), *ImagePath, Image.GetNumPixels(), NumSplats);
+			return false;
+		}
+
+		// Integer images are normalized to [0, 1] and dequantized with the range, float images hold the values.
+		// The pixels are data, so no sRGB decoding happens on the way.
+		const bool bQuantized = !ERawImageFormat::IsHDR(Image.Format);
+		Image.GammaSpace = EGammaSpace::Linear;
+		Image.ChangeFormat(ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+		const FLinearColor* Pixels = Image.AsRGBA32F().GetData();
+
+		for (int32 Channel = 0; Channel < Attribute.NumChannels; Channel++) {
+			const float Min = bQuantized ? Range.Min[Channel] : 0.0f;
+			const float Scale = bQuantized ? Range.Max[Channel] - Range.Min[Channel] : 1.0f;
+			float* Column = Next;
+			Next += NumSplats;
+			for (int32 i = 0; i < NumSplats; i++) {
+				Column[i] = Min + Pixels[i].Component(Channel) * Scale;
+			}
+			OutFrame.Columns[int32(Attribute.Columns[Channel])] = Column;
+		}
+	}
+	OutFrame.NumSplats = NumSplats;
+	return true;
+}
@@ -0,0 +1,378 @@
+// MappedSplatReaders.cpp
+
+#include "MappedSplatReaders.h"
+#include "SplatArena.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Math/Float16.h"
+
+static constexpr float SH_C0 = 0.28209479177387814f;
+
+// Columns every decoded batch fills, followed by the kept f_rest_* columns
+static const EGaussianSplatColumn kMappedVertexColumns[] = {
+	EGaussianSplatColumn::X, EGaussianSplatColumn::Y, EGaussianSplatColumn::Z,
+	EGaussianSplatColumn::Scale0, EGaussianSplatColumn::Scale1, EGaussianSplatColumn::Scale2,
+	EGaussianSplatColumn::Rot0, EGaussianSplatColumn::Rot1, EGaussianSplatColumn::Rot2, EGaussianSplatColumn::Rot3,
+	EGaussianSplatColumn::DC0, EGaussianSplatColumn::DC1, EGaussianSplatColumn::DC2, EGaussianSplatColumn::Opacity,
+};
+static constexpr int32 NumMappedVertexColumns = UE_ARRAY_COUNT(kMappedVertexColumns);
+
+// File data is little endian and not necessarily aligned
+template <typename T>
+static FORCEINLINE T ReadValue(const uint8* Ptr) {
+	T Value;
+	FMemory::Memcpy(&Value, Ptr, sizeof(T));
+	return Value;
+}
+
+static FORCEINLINE float ReadHalf(const uint8* Ptr) {
+	FFloat16 Half;
+	Half.Encoded = ReadValue<uint16>(Ptr);
+	return Half.GetFloat();
+}
+
+// Raw columns of a base color and sigmoid opacity stored in 8 bits each
+static FORCEINLINE void UnpackColor(const uint8* Color, float* const* DC, float* Opacity, int32 i) {
+	for (int32 Channel = 0; Channel < 3; Channel++) {
+		DC[Channel][i] = (float(Color[Channel]) / 255.0f - 0.5f) / SH_C0;
+	}
+	const float Alpha = float(Color[3]) / 255.0f;
+	Opacity[i] = -FMath::Loge(1.0f / Alpha - 1.0f);
+}
+
+// Raw log scale of a linear scale; zero scales are clamped instead of becoming -inf
+static FORCEINLINE float LogScale(float Scale) {
+	return FMath::Loge(FMath::Max(Scale, UE_SMALL_NUMBER));
+}
+
+// ---------- FMappedSplatReader ----------
+
+FMappedSplatReader::FMappedSplatReader()
+	: Data(nullptr)
+	, Size(0)
+	, NumPoints(0)
+	, FileSHDegree(0)
+	, Error()
+	, MappedFile()
+	, MappedRegion()
+	, Arena(nullptr)
+	, BatchStorage(nullptr)
+	, BatchStorageSize(0)
+	, NumSplats(0)
+{
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		Columns[Col] = nullptr;
+	}
+}
+
+FMappedSplatReader::~FMappedSplatReader() {
+	// The region has to be unmapped before its file is closed
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+bool FMappedSplatReader::Open(const FString& AbsolutePath, FSplatArena& InArena) {
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*AbsolutePath));
+	Size = MappedFile ? MappedFile->GetFileSize() : 0;
+	if (Size > 0) {
+		MappedRegion.Reset(MappedFile->MapRegion(0, Size));
+	}
+	if (!MappedRegion) {
+		Error = FString::Printf(TEXT("Cannot map %s"), *AbsolutePath);
+		return false;
+	}
+	Data = MappedRegion->GetMappedPtr();
+
+	if (!ParseHeader()) {
+		Error += FString::Printf(TEXT(" - %s"), *AbsolutePath);
+		return false;
+	}
+	Arena = &InArena;
+	Arena->Reserve(FMath::Min<int64>(NumPoints, FGaussianSplatBuffer::RowsPerBatch)
+		* (NumMappedVertexColumns + FGaussianSplatBuffer::NumRestCoefficientsForDegree(FileSHDegree)) * sizeof(float));
+	return true;
+}
+
+bool FMappedSplatReader::BeginBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree) {
+	if (!Data || FirstSplat < 0 || InNumSplats < 0 || FirstSplat + InNumSplats > NumPoints) {
+		return false;
+	}
+	const int32 NumKept = FGaussianSplatBuffer::NumSHCoefficientsForDegree(SHDegree);
+	const int32 Stride = RestChannelStride();
+
+	NumSplats = InNumSplats;
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		Columns[Col] = nullptr;
+	}
+	const int64 NumValues = int64(NumMappedVertexColumns + 3 * NumKept) * NumSplats;
+	if (NumValues > BatchStorageSize) {
+		BatchStorage = Arena->AllocateArray<float>(NumValues);
+		BatchStorageSize = NumValues;
+	}
+	float* Next = BatchStorage;
+	for (EGaussianSplatColumn Col : kMappedVertexColumns) {
+		Columns[int32(Col)] = Next;
+		Next += NumSplats;
+	}
+	for (int32 Channel = 0; Channel < 3; Channel++) {
+		for (int32 y = 0; y < NumKept; y++) {
+			Columns[int32(EGaussianSplatColumn::Rest0) + Channel * Stride + y] = Next;
+			Next += NumSplats;
+		}
+	}
+	return true;
+}
+
+// ---------- FSplatReader ----------
+
+bool FSplatReader::ParseHeader() {
+	if (Size % BytesPerSplat != 0 || Size / BytesPerSplat > MAX_int32) {
+		Error = FString::Printf(TEXT("Not a .splat file, %lld bytes is no multiple of %d"), Size, BytesPerSplat);
+		return false;
+	}
+	NumPoints = int32(Size / BytesPerSplat);
+	FileSHDegree = 0;
+	return true;
+}
+
+FString FSplatReader::Describe() const {
+	return FString::Printf(TEXT("splat\npoints %d\n"), NumPoints);
+}
+
+bool FSplatReader::DecodeBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree) {
+	if (!BeginBatch(FirstSplat, InNumSplats, 0)) {
+		return false;
+	}
+	float* Position[3] = { Columns[int32(EGaussianSplatColumn::X)], Columns[int32(EGaussianSplatColumn::Y)], Columns[int32(EGaussianSplatColumn::Z)] };
+	float* Scale[3] = { Columns[int32(EGaussianSplatColumn::Scale0)], Columns[int32(EGaussianSplatColumn::Scale1)], Columns[int32(EGaussianSplatColumn::Scale2)] };
+	float* Rot[4] = { Columns[int32(EGaussianSplatColumn::Rot0)], Columns[int32(EGaussianSplatColumn::Rot1)], Columns[int32(EGaussianSplatColumn::Rot2)], Columns[int32(EGaussianSplatColumn::Rot3)] };
+	float* DC[3] = { Columns[int32(EGaussianSplatColumn::DC0)], Columns[int32(EGaussianSplatColumn::DC1)], Columns[int32(EGaussianSplatColumn::DC2)] };
+	float* Opacity = Columns[int32(EGaussianSplatColumn::Opacity)];
+
+	ParallelFor(FGaussianSplatBuffer::NumTasks(InNumSplats), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, InNumSplats);
+		const uint8* Row = Data + (int64(FirstSplat) + Begin) * BytesPerSplat;
+		for (int32 i = Begin; i < End; i++, Row += BytesPerSplat) {
+			for (int32 Axis = 0; Axis < 3; Axis++) {
+				Position[Axis][i] = ReadValue<float>(Row + Axis * 4);
+				Scale[Axis][i] = LogScale(ReadValue<float>(Row + 12 + Axis * 4));
+			}
+			UnpackColor(Row + 24, DC, Opacity, i);
+			for (int32 Component = 0; Component < 4; Component++) {
+				Rot[Component][i] = (float(Row[28 + Component]) - 128.0f) / 128.0f;
+			}
+		}
+	});
+	return true;
+}
+
+// ---------- FKSplatReader ----------
+
+static constexpr int64 KSplatHeaderBytes = 4096;
+static constexpr int64 KSplatSectionHeaderBytes = 1024;
+static constexpr int32 KSplatMaxCompressionLevel = 2;
+static constexpr int32 KSplatMaxSHDegree = 2;
+static constexpr float KSplatDefaultSHRange = 1.5f;
+
+// Byte offsets within a splat and sizes of the spherical harmonics components, per compression level
+static constexpr int32 KSplatScaleOffset[] = { 12, 6, 6 };
+static constexpr int32 KSplatRotationOffset[] = { 24, 12, 12 };
+static constexpr int32 KSplatColorOffset[] = { 40, 20, 20 };
+static constexpr int32 KSplatSHOffset[] = { 44, 24, 24 };
+static constexpr int32 KSplatBytesPerSHComponent[] = { 4, 2, 1 };
+static constexpr uint32 KSplatDefaultPositionRange[] = { 1, 32767, 32767 };
+
+int32 FKSplatReader::FSection::GetBucket(int32 LocalSplat) const {
+	const int32 SplatsInFullBuckets = FullBucketCount * BucketSize;
+	if (LocalSplat < SplatsInFullBuckets) {
+		return LocalSplat / BucketSize;
+	}
+	return FullBucketCount + Algo::UpperBound(PartialBucketStarts, LocalSplat) - 1;
+}
+
+FKSplatReader::FKSplatReader()
+	: Sections()
+	, VersionMajor(0)
+	, VersionMinor(0)
+	, CompressionLevel(0)
+	, MinSHCoefficient(-KSplatDefaultSHRange)
+	, MaxSHCoefficient(KSplatDefaultSHRange)
+{
+}
+
+bool FKSplatReader::ParseHeader() {
+	if (Size < KSplatHeaderBytes) {
+		Error = TEXT("Not a .ksplat file, too small for its header");
+		return false;
+	}
+	VersionMajor = Data[0];
+	VersionMinor = Data[1];
+	const uint32 MaxSectionCount = ReadValue<uint32>(Data + 4);
+	const uint32 SectionCount = ReadValue<uint32>(Data + 8);
+	CompressionLevel = ReadValue<uint16>(Data + 20);
+	// Files written before the range was stored have zeros here
+	MinSHCoefficient = ReadValue<float>(Data + 36);
+	MaxSHCoefficient = ReadValue<float>(Data + 40);
+	if (MinSHCoefficient == 0.0f) {
+		MinSHCoefficient = -KSplatDefaultSHRange;
+	}
+	if (MaxSHCoefficient == 0.0f) {
+		MaxSHCoefficient = KSplatDefaultSHRange;
+	}
+
+	if ((VersionMajor == 0 && VersionMinor < 1) || CompressionLevel > KSplatMaxCompressionLevel || SectionCount > MaxSectionCount) {
+		Error = FString::Printf(TEXT("Unsupported .ksplat file (version %d.%d, compression level %d, %u of %u sections)"),
+			VersionMajor, VersionMinor, CompressionLevel, SectionCount, MaxSectionCount);
+		return false;
+	}
+
+	// Every section header is read before its section's size is checked
+	int64 SectionBase = KSplatHeaderBytes + int64(MaxSectionCount) * KSplatSectionHeaderBytes;
+	if (SectionBase > Size) {
+		Error = FString::Printf(TEXT("Truncated .ksplat file, %lld bytes for %u section headers"), Size, MaxSectionCount);
+		return false;
+	}
+	int64 TotalSplats = 0;
+	FileSHDegree = KSplatMaxSHDegree;
+	Sections.Reset();
+	for (uint32 SectionIndex = 0; SectionIndex < SectionCount; SectionIndex++) {
+		const uint8* Header = Data + KSplatHeaderBytes + int64(SectionIndex) * KSplatSectionHeaderBytes;
+		const uint32 NumSectionSplats = ReadValue<uint32>(Header);
+		const uint32 MaxSectionSplats = ReadValue<uint32>(Header + 4);
+		const uint32 BucketSize = ReadValue<uint32>(Header + 8);
+		const uint32 BucketCount = ReadValue<uint32>(Header + 12);
+		const float BucketBlockSize = ReadValue<float>(Header + 16);
+		const uint16 BucketStorageBytes = ReadValue<uint16>(Header + 20);
+		uint32 PositionRange = ReadValue<uint32>(Header + 24);
+		const uint32 FullBucketCount = ReadValue<uint32>(Header + 32);
+		const uint32 PartialBucketCount = ReadValue<uint32>(Header + 36);
+		const int32 SectionSHDegree = ReadValue<uint16>(Header + 40);
+		if (PositionRange == 0) {
+			PositionRange = KSplatDefaultPositionRange[CompressionLevel];
+		}
+
+		const int32 BytesPerSplat = KSplatSHOffset[CompressionLevel]
+			+ FGaussianSplatBuffer::NumRestCoefficientsForDegree(FMath::Min(SectionSHDegree, KSplatMaxSHDegree)) * KSplatBytesPerSHComponent[CompressionLevel];
+		const int64 BucketMetaBytes = int64(PartialBucketCount) * 4;
+		const int64 BucketBytes = int64(BucketStorageBytes) * BucketCount + BucketMetaBytes;
+		const int64 SectionBytes = BucketBytes + int64(BytesPerSplat) * MaxSectionSplats;
+		if (SectionSHDegree > KSplatMaxSHDegree || NumSectionSplats > MaxSectionSplats || SectionBase + SectionBytes > Size
+			|| (CompressionLevel > 0 && (BucketSize == 0 || BucketStorageBytes < 12 || int64(FullBucketCount) + PartialBucketCount > BucketCount))) {
+			Error = FString::Printf(TEXT("Truncated or corrupt .ksplat file, section %u"), SectionIndex);
+			return false;
+		}
+
+		FSection& Section = Sections.AddDefaulted_GetRef();
+		Section.FirstSplat = int32(TotalSplats);
+		Section.NumSplats = int32(NumSectionSplats);
+		Section.BucketSize = int32(BucketSize);
+		Section.FullBucketCount = int32(FullBucketCount);
+		Section.PositionScale = BucketBlockSize / 2.0f / float(PositionRange);
+		Section.PositionOffset = PositionRange;
+		Section.SHDegree = SectionSHDegree;
+		Section.BytesPerSplat = BytesPerSplat;
+		Section.BucketCenters = reinterpret_cast<const float*>(Data + SectionBase + BucketMetaBytes);
+		Section.Splats = Data + SectionBase + BucketBytes;
+
+		const uint8* PartialBucketLengths = Data + SectionBase;
+		int32 BucketStart = Section.FullBucketCount * Section.BucketSize;
+		Section.PartialBucketStarts.SetNumUninitialized(PartialBucketCount);
+		for (uint32 Bucket = 0; Bucket < PartialBucketCount; Bucket++) {
+			Section.PartialBucketStarts[Bucket] = BucketStart;
+			BucketStart += int32(ReadValue<uint32>(PartialBucketLengths + Bucket * 4));
+		}
+
+		TotalSplats += NumSectionSplats;
+		FileSHDegree = FMath::Min(FileSHDegree, SectionSHDegree);
+		SectionBase += SectionBytes;
+	}
+	if (TotalSplats > MAX_int32) {
+		Error = FString::Printf(TEXT("Too many splats in .ksplat file (%lld)"), TotalSplats);
+		return false;
+	}
+	NumPoints = int32(TotalSplats);
+	if (Sections.Num() == 0) {
+		FileSHDegree = 0;
+	}
+	return true;
+}
+
+FString FKSplatReader::Describe() const {
+	return FString::Printf(TEXT("ksplat version %d.%d\npoints %d\nsections %d\ncompression level %d\nspherical harmonics degree %d\n"),
+		VersionMajor, VersionMinor, NumPoints, Sections.Num(), CompressionLevel, FileSHDegree);
+}
+
+bool FKSplatReader::DecodeBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree) {
+	SHDegree = FMath::Clamp(SHDegree, 0, FileSHDegree);
+	if (!BeginBatch(FirstSplat, InNumSplats, SHDegree)) {
+		return false;
+	}
+	float* Position[3] = { Columns[int32(EGaussianSplatColumn::X)], Columns[int32(EGaussianSplatColumn::Y)], Columns[int32(EGaussianSplatColumn::Z)] };
+	float* Scale[3] = { Columns[int32(EGaussianSplatColumn::Scale0)], Columns[int32(EGaussianSplatColumn::Scale1)], Columns[int32(EGaussianSplatColumn::Scale2)] };
+	float* Rot[4] = { Columns[int32(EGaussianSplatColumn::Rot0)], Columns[int32(EGaussianSplatColumn::Rot1)], Columns[int32(EGaussianSplatColumn::Rot2)], Columns[int32(EGaussianSplatColumn::Rot3)] };
+	float* DC[3] = { Columns[int32(EGaussianSplatColumn::DC0)], Columns[int32(EGaussianSplatColumn::DC1)], Columns[int32(EGaussianSplatColumn::DC2)] };
+	float* Opacity = Columns[int32(EGaussianSplatColumn::Opacity)];
+	float* const* Rest = Columns + int32(EGaussianSplatColumn::Rest0);
+	const int32 NumKept = FGaussianSplatBuffer::NumSHCoefficientsForDegree(SHDegree);
+	const int32 Stride = RestChannelStride();
+	const int32 Level = CompressionLevel;
+	const float SHScale = (MaxSHCoefficient - MinSHCoefficient) / 255.0f;
+
+	ParallelFor(FGaussianSplatBuffer::NumTasks(InNumSplats), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, InNumSplats);
+
+		// Sections are contiguous ranges of splats, so a task only ever moves forward through them
+		int32 SectionIndex = Algo::UpperBoundBy(Sections, FirstSplat + Begin, &FSection::FirstSplat) - 1;
+		for (int32 i = Begin; i < End; i++) {
+			const int32 Splat = FirstSplat + i;
+			while (Splat >= Sections[SectionIndex].FirstSplat + Sections[SectionIndex].NumSplats) {
+				SectionIndex++;
+			}
+			const FSection& Section = Sections[SectionIndex];
+			const int32 LocalSplat = Splat - Section.FirstSplat;
+			const uint8* Row = Section.Splats + int64(LocalSplat) * Section.BytesPerSplat;
+
+			if (Level == 0) {
+				for (int32 Axis = 0; Axis < 3; Axis++) {
+					Position[Axis][i] = ReadValue<float>(Row + Axis * 4);
+					Scale[Axis][i] = LogScale(ReadValue<float>(Row + KSplatScaleOffset[0] + Axis * 4));
+				}
+				for (int32 Component = 0; Component < 4; Component++) {
+					Rot[Component][i] = ReadValue<float>(Row + KSplatRotationOffset[0] + Component * 4);
+				}
+			}
+			else {
+				const int32 Bucket = Section.GetBucket(LocalSplat);
+				for (int32 Axis = 0; Axis < 3; Axis++) {
+					const float Offset = float(int32(ReadValue<uint16>(Row + Axis * 2)) - int32(Section.PositionOffset));
+					Position[Axis][i] = Offset * Section.PositionScale + ReadValue<float>(reinterpret_cast<const uint8*>(Section.BucketCenters + Bucket * 3 + Axis));
+					Scale[Axis][i] = LogScale(ReadHalf(Row + KSplatScaleOffset[Level] + Axis * 2));
+				}
+				for (int32 Component = 0; Component < 4; Component++) {
+					Rot[Component][i] = ReadHalf(Row + KSplatRotationOffset[Level] + Component * 2);
+				}
+			}
+			UnpackColor(Row + KSplatColorOffset[Level], DC, Opacity, i);
+
+			// Coefficient-major RGB in the file, channel-major columns like f_rest_*
+			const uint8* SH = Row + KSplatSHOffset[Level];
+			for (int32 y = 0; y < NumKept; y++) {
+				for (int32 Channel = 0; Channel < 3; Channel++) {
+					const int32 Component = y * 3 + Channel;
+					float Value;
+					switch (Level) {
+					case 0: Value = ReadValue<float>(SH + Component * 4); break;
+					case 1: Value = ReadHalf(SH + Component * 2); break;
+					default: Value = MinSHCoefficient + float(SH[Component]) * SHScale; break;
+					}
+					Rest[Channel * Stride + y][i] = Value;
+				}
+			}
+		}
+	});
+	return true;
+}
@@ -24,16 +24,50 @@ SOFTWARE.
 
 #include "Miniply.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cctype>
 #include <cmath>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
+#include <mutex>
 #include <string>
+#include <thread>
 
-#ifndef _WIN32
+#ifdef _WIN32
+#if defined(__has_include) && __has_include("Windows/WindowsHWrapper.h")
+#include "Windows/WindowsHWrapper.h"
+#else
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+#else
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Byte swapping of big-endian data works on 16 bytes at a time where the
+// target guarantees a vector unit.
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#define MINIPLY_SWAP_NEON 1
+#include <arm_neon.h>
+#elif defined(__SSSE3__) || defined(__AVX__)
+#define MINIPLY_SWAP_SSSE3 1
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MINIPLY_SWAP_SSE2 1
+#include <emmintrin.h>
 #endif
 
 
@@ -54,6 +88,10 @@ namespace miniply {
 
     static constexpr uint32_t kPLYReadBufferSize = 128 * 1024;
     static constexpr uint32_t kPLYTempBufferSize = kPLYReadBufferSize;
+    static constexpr uint32_t kPLYAsciiRowsPerTask = 4096; //!< ASCII rows parsed by each task of the parallel-for hook.
+    static constexpr uint32_t kPLYSwapBytesPerTask = 4 * 1024 * 1024; //!< Bytes of big-endian data swapped by each task of the parallel-for hook.
+    static constexpr uint32_t kPLYReadAheadBlockSize = 1024 * 1024;
+    static constexpr uint32_t kPLYReadAheadBlocks = 4;
 
     static const char* kPLYFileTypes[] = { "ascii", "binary_little_endian", "binary_big_endian", nullptr };
     static const uint32_t kPLYPropertySize[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
@@ -248,6 +286,40 @@ namespace miniply {
     }
 
 
+    // An unsigned literal such as an element count, which may need all 32 bits.
+    // Unlike int_literal, overflow is detected exactly.
+    static bool uint_literal(const char* start, char const** end, uint32_t* val)
+    {
+        const char* pos = start;
+        if (*pos == '+') {
+            ++pos;
+        }
+
+        int numDigits = 0;
+        uint64_t localVal = 0;
+        while (is_digit(*pos)) {
+            localVal = localVal * 10 + static_cast<uint64_t>(*pos - '0');
+            if (localVal > 0xFFFFFFFFull) {
+                return false;
+            }
+            ++numDigits;
+            ++pos;
+        }
+
+        if (numDigits == 0 || is_letter(*pos) || *pos == '_') {
+            return false;
+        }
+
+        if (val != nullptr) {
+            *val = static_cast<uint32_t>(localVal);
+        }
+        if (end != nullptr) {
+            *end = pos;
+        }
+        return true;
+    }
+
+
     static bool double_literal(const char* start, char const** end, double* val)
     {
         const char* pos = start;
@@ -354,6 +426,247 @@ namespace miniply {
     }
 
 
+    // Splits a decimal literal into its sign, significant digits and power of
+    // ten, accepting the same syntax as `double_literal`. Returns false for
+    // anything that isn't a valid literal and for literals with more
+    // significant digits than fit in `mantissa`; callers fall back to
+    // `double_literal` for those.
+    static bool decimal_literal(const char* start, char const** end, bool* negative, uint64_t* mantissa, int* exponent)
+    {
+        const char* pos = start;
+
+        *negative = false;
+        if (*pos == '-') {
+            *negative = true;
+            ++pos;
+        }
+        else if (*pos == '+') {
+            ++pos;
+        }
+
+        uint64_t digits = 0;
+        int numDigits = 0;
+        int scale = 0;
+
+        bool hasIntDigits = is_digit(*pos);
+        while (*pos == '0') {
+            ++pos;
+        }
+        while (is_digit(*pos)) {
+            digits = digits * 10 + static_cast<uint64_t>(*pos - '0');
+            ++numDigits;
+            ++pos;
+        }
+
+        bool hasFracDigits = false;
+        if (*pos == '.') {
+            ++pos;
+            hasFracDigits = is_digit(*pos);
+            if (numDigits == 0) {
+                // Leading zeroes after the point only move the decimal point.
+                while (*pos == '0') {
+                    --scale;
+                    ++pos;
+                }
+            }
+            while (is_digit(*pos)) {
+                digits = digits * 10 + static_cast<uint64_t>(*pos - '0');
+                ++numDigits;
+                --scale;
+                ++pos;
+            }
+        }
+        if (!hasIntDigits && !hasFracDigits) {
+            return false;
+        }
+
+        if (*pos == 'e' || *pos == 'E') {
+            ++pos;
+            bool negativeExponent = false;
+            if (*pos == '-') {
+                negativeExponent = true;
+                ++pos;
+            }
+            else if (*pos == '+') {
+                ++pos;
+            }
+            if (!is_digit(*pos)) {
+                return false;
+            }
+            int exp = 0;
+            do {
+                if (exp < 10000) {
+                    exp = exp * 10 + (*pos - '0');
+                }
+                ++pos;
+            } while (is_digit(*pos));
+            scale += negativeExponent ? -exp : exp;
+        }
+
+        if (*pos == '.' || *pos == '_' || is_alnum(*pos) || numDigits > 19) {
+            return false;
+        }
+
+        *mantissa = digits;
+        *exponent = scale;
+        *end = pos;
+        return true;
+    }
+
+
+    static const float kFloatPowersOf10[] = {
+        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+    };
+
+    static const double kDoublePowersOf10[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+
+    // Clinger's fast path: when both the significant digits and the power of
+    // ten are exactly representable, a single multiplication or division gives
+    // the correctly rounded result. That covers practically every number a
+    // PLY exporter writes; the rest go through `double_literal`.
+    static bool fast_double_literal(const char* start, char const** end, double* val)
+    {
+        bool negative;
+        uint64_t mantissa;
+        int exponent;
+        if (decimal_literal(start, end, &negative, &mantissa, &exponent) &&
+                mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+            double value = static_cast<double>(mantissa);
+            value = (exponent < 0) ? value / kDoublePowersOf10[-exponent] : value * kDoublePowersOf10[exponent];
+            *val = negative ? -value : value;
+            return true;
+        }
+        return double_literal(start, end, val);
+    }
+
+
+    static bool fast_float_literal(const char* start, char const** end, float* val)
+    {
+        bool negative;
+        uint64_t mantissa;
+        int exponent;
+        if (decimal_literal(start, end, &negative, &mantissa, &exponent)) {
+            if (mantissa <= (uint64_t(1) << 24) && exponent >= -10 && exponent <= 10) {
+                float value = static_cast<float>(mantissa);
+                value = (exponent < 0) ? value / kFloatPowersOf10[-exponent] : value * kFloatPowersOf10[exponent];
+                *val = negative ? -value : value;
+                return true;
+            }
+            if (mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+                // Exact in double, then rounded once more to float.
+                double value = static_cast<double>(mantissa);
+                value = (exponent < 0) ? value / kDoublePowersOf10[-exponent] : value * kDoublePowersOf10[exponent];
+                *val = static_cast<float>(negative ? -value : value);
+                return true;
+            }
+        }
+        return float_literal(start, end, val);
+    }
+
+
+    // Parses one ASCII value of type `propType` at `pos` and stores it in
+    // `dest` in binary form. `dest` may be unaligned.
+    static bool ascii_value_at(const char* pos, char const** end, PLYPropertyType propType, uint8_t* dest)
+    {
+        int tmpInt = 0;
+        switch (propType) {
+        case PLYPropertyType::Char: {
+            if (!int_literal(pos, end, &tmpInt)) {
+                return false;
+            }
+            int8_t value = static_cast<int8_t>(tmpInt);
+            std::memcpy(dest, &value, sizeof(value));
+            return true;
+        }
+        case PLYPropertyType::UChar: {
+            if (!int_literal(pos, end, &tmpInt)) {
+                return false;
+            }
+            uint8_t value = static_cast<uint8_t>(tmpInt);
+            std::memcpy(dest, &value, sizeof(value));
+            return true;
+        }
+        case PLYPropertyType::Short: {
+            if (!int_literal(pos, end, &tmpInt)) {
+                return false;
+            }
+            int16_t value = static_cast<int16_t>(tmpInt);
+            std::memcpy(dest, &value, sizeof(value));
+            return true;
+        }
+        case PLYPropertyType::UShort: {
+            if (!int_literal(pos, end, &tmpInt)) {
+                return false;
+            }
+            uint16_t value = static_cast<uint16_t>(tmpInt);
+            std::memcpy(dest, &value, sizeof(value));
+            return true;
+        }
+        case PLYPropertyType::Int:
+        case PLYPropertyType::UInt:
+            if (!int_literal(pos, end, &tmpInt)) {
+                return false;
+            }
+            std::memcpy(dest, &tmpInt, sizeof(tmpInt));
+            return true;
+        case PLYPropertyType::Float: {
+            float value = 0.0f;
+            if (!fast_float_literal(pos, end, &value)) {
+                return false;
+            }
+            std::memcpy(dest, &value, sizeof(value));
+            return true;
+        }
+        case PLYPropertyType::Double:
+        default: {
+            double value = 0.0;
+            if (!fast_double_literal(pos, end, &value)) {
+                return false;
+            }
+            std::memcpy(dest, &value, sizeof(value));
+            return true;
+        }
+        }
+    }
+
+
+    // Parses one ASCII row of a fixed-size element into `dest`, which has the
+    // element's loaded layout, and moves `pos` to the start of the next line.
+    // The row must be terminated by '\n' or '\0'. Values of properties left
+    // out by a projection are skipped without being parsed.
+    static bool parse_ascii_row(const PLYElement& elem, const char*& pos, uint8_t* dest)
+    {
+        for (const PLYProperty& prop : elem.properties) {
+            while (is_whitespace(*pos)) {
+                ++pos;
+            }
+            if (!prop.projected) {
+                const char* valueStart = pos;
+                while (*pos != '\n' && *pos != '\0' && !is_whitespace(*pos)) {
+                    ++pos;
+                }
+                if (pos == valueStart) {
+                    return false;
+                }
+            }
+            else if (!ascii_value_at(pos, &pos, prop.type, dest + prop.loadedOffset)) {
+                return false;
+            }
+        }
+        while (*pos != '\n' && *pos != '\0') {
+            ++pos;
+        }
+        if (*pos == '\n') {
+            ++pos;
+        }
+        return true;
+    }
+
+
     static inline void endian_swap_2(uint8_t* data)
     {
         uint16_t tmp = *reinterpret_cast<uint16_t*>(data);
@@ -381,6 +694,69 @@ namespace miniply {
     }
 
 
+    // Swaps every value in one 16 byte block of values that are `Size` bytes each.
+    template <uint32_t Size>
+    static inline void endian_swap_16_bytes(uint8_t* data)
+    {
+#if defined(MINIPLY_SWAP_NEON)
+        uint8x16_t v = vld1q_u8(data);
+        v = (Size == 2) ? vrev16q_u8(v) : (Size == 4) ? vrev32q_u8(v) : vrev64q_u8(v);
+        vst1q_u8(data, v);
+#elif defined(MINIPLY_SWAP_SSSE3)
+        const __m128i shuffle = (Size == 2) ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14) :
+                                (Size == 4) ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12) :
+                                              _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data), _mm_shuffle_epi8(v, shuffle));
+#elif defined(MINIPLY_SWAP_SSE2)
+        // No byte shuffle in SSE2: swap the 32-bit halves of 64-bit values, then
+        // the 16-bit halves of 32-bit values, then the bytes of 16-bit values.
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        if (Size == 8) {
+            v = _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+        }
+        if (Size >= 4) {
+            v = _mm_or_si128(_mm_slli_epi32(v, 16), _mm_srli_epi32(v, 16));
+        }
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data), v);
+#else
+        for (uint32_t i = 0; i < 16; i += Size) {
+            std::reverse(data + i, data + i + Size);
+        }
+#endif
+    }
+
+
+    // Swaps `n` consecutive values of `Size` bytes each.
+    template <uint32_t Size>
+    static void endian_swap_values(uint8_t* data, size_t n)
+    {
+        uint8_t* end = data + n * Size;
+        for (uint8_t* blockEnd = data + ((n * Size) & ~size_t(15)); data < blockEnd; data += 16) {
+            endian_swap_16_bytes<Size>(data);
+        }
+        for (; data < end; data += Size) {
+            switch (Size) {
+            case 2: endian_swap_2(data); break;
+            case 4: endian_swap_4(data); break;
+            default: endian_swap_8(data); break;
+            }
+        }
+    }
+
+
+    static void endian_swap_values(uint8_t* data, uint32_t size, size_t n)
+    {
+        switch (size) {
+        case 2: endian_swap_values<2>(data, n); break;
+        case 4: endian_swap_values<4>(data, n); break;
+        case 8: endian_swap_values<8>(data, n); break;
+        default: break;
+        }
+    }
+
+
     static inline void endian_swap(uint8_t* data, PLYPropertyType type)
     {
         switch (kPLYPropertySize[uint32_t(type)]) {
@@ -394,24 +770,66 @@ namespace miniply {
 
     static inline void endian_swap_array(uint8_t* data, PLYPropertyType type, int n)
     {
-        switch (kPLYPropertySize[uint32_t(type)]) {
-        case 2:
-            for (const uint8_t* end = data + 2 * n; data < end; data += 2) {
-                endian_swap_2(data);
+        endian_swap_values(data, kPLYPropertySize[uint32_t(type)], size_t(n));
+    }
+
+
+    // Swaps the loaded properties of `numRows` consecutive big-endian rows.
+    // Neighbouring properties of the same size are swapped as one run, so a row
+    // of 62 floats is a single call rather than 62 switches. When one run covers
+    // whole rows, as it does for the usual all-float splat element, the block is
+    // one flat array of values and is split between tasks by bytes.
+    static void endian_swap_rows(const PLYElement& elem, uint8_t* rows, uint32_t numRows, const PLYParallelFor& parallelFor)
+    {
+        struct SwapRun {
+            uint32_t offset;
+            uint32_t size;
+            uint32_t count;
+        };
+        std::vector<SwapRun> runs;
+        for (const PLYProperty& prop : elem.properties) {
+            uint32_t size = kPLYPropertySize[uint32_t(prop.type)];
+            if (!prop.projected || size == 1) {
+                continue;
             }
-            break;
-        case 4:
-            for (const uint8_t* end = data + 4 * n; data < end; data += 4) {
-                endian_swap_4(data);
+            if (!runs.empty() && runs.back().size == size && runs.back().offset + runs.back().size * runs.back().count == prop.loadedOffset) {
+                runs.back().count++;
             }
-            break;
-        case 8:
-            for (const uint8_t* end = data + 8 * n; data < end; data += 8) {
-                endian_swap_8(data);
+            else {
+                runs.push_back(SwapRun{ prop.loadedOffset, size, 1 });
+            }
+        }
+        if (runs.empty() || numRows == 0) {
+            return;
+        }
+
+        const size_t numBytes = static_cast<size_t>(numRows) * elem.loadedStride;
+        const bool flat = runs.size() == 1 && runs[0].offset == 0 && runs[0].size * runs[0].count == elem.loadedStride;
+        const uint32_t rowsPerTask = std::max(kPLYSwapBytesPerTask / elem.loadedStride, 1u);
+        const uint32_t numTasks = (numRows + rowsPerTask - 1) / rowsPerTask;
+
+        auto swapTask = [&](uint32_t task) {
+            const uint32_t firstRow = task * rowsPerTask;
+            const uint32_t endRow = std::min(firstRow + rowsPerTask, numRows);
+            uint8_t* row = rows + static_cast<size_t>(firstRow) * elem.loadedStride;
+            if (flat) {
+                endian_swap_values(row, runs[0].size, static_cast<size_t>(endRow - firstRow) * runs[0].count);
+                return;
+            }
+            for (uint32_t rowIdx = firstRow; rowIdx < endRow; rowIdx++) {
+                for (const SwapRun& run : runs) {
+                    endian_swap_values(row + run.offset, run.size, run.count);
+                }
+                row += elem.loadedStride;
+            }
+        };
+        if (parallelFor && numTasks > 1 && numBytes > kPLYSwapBytesPerTask) {
+            parallelFor(numTasks, swapTask);
+        }
+        else {
+            for (uint32_t task = 0; task < numTasks; task++) {
+                swapTask(task);
             }
-            break;
-        default:
-            break;
         }
     }
 
@@ -479,8 +897,11 @@ namespace miniply {
                 continue;
             }
             prop.offset = rowStride;
+            prop.loadedOffset = rowStride;
+            prop.projected = true;
             rowStride += kPLYPropertySize[uint32_t(prop.type)];
         }
+        loadedStride = rowStride;
     }
 
 
@@ -577,11 +998,164 @@ namespace miniply {
     }
 
 
+    //
+    // PLYReadAhead class
+    //
+
+    /// Reads a file sequentially on a background thread, up to
+    /// `kPLYReadAheadBlocks` blocks ahead of the consumer, so that waiting for
+    /// the disk overlaps with decoding the data that has already arrived.
+    /// Only the background thread touches the `FILE` once this exists.
+    class PLYReadAhead {
+    public:
+        explicit PLYReadAhead(FILE* f);
+        ~PLYReadAhead();
+
+        /// Copies the next `numBytes` bytes of the file into `dest`, waiting
+        /// for them if necessary. Returns fewer only at the end of the file.
+        size_t read(char* dest, size_t numBytes);
+
+        /// Drops everything read ahead so far and continues from `offset`.
+        void seek(int64_t offset);
+
+    private:
+        void run();
+
+        struct Block {
+            std::vector<char> data;
+            size_t size = 0;
+        };
+
+        FILE* m_f;
+        Block m_blocks[kPLYReadAheadBlocks];
+        uint32_t m_head = 0;       //!< Block the consumer reads from next.
+        uint32_t m_count = 0;      //!< Number of filled blocks, starting at `m_head`.
+        size_t m_headPos = 0;      //!< Bytes already consumed from the head block.
+        uint64_t m_generation = 0; //!< Bumped by every seek, so reads started before it get dropped.
+        int64_t m_seekOffset = -1; //!< Pending seek for the background thread, or -1.
+        bool m_eof = false;
+        bool m_stop = false;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        std::thread m_thread;
+    };
+
+
+    PLYReadAhead::PLYReadAhead(FILE* f) :
+        m_f(f)
+    {
+        for (Block& block : m_blocks) {
+            block.data.resize(kPLYReadAheadBlockSize);
+        }
+        m_thread = std::thread(&PLYReadAhead::run, this);
+    }
+
+
+    PLYReadAhead::~PLYReadAhead()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cond.notify_all();
+        m_thread.join();
+    }
+
+
+    size_t PLYReadAhead::read(char* dest, size_t numBytes)
+    {
+        size_t total = 0;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (total < numBytes) {
+            m_cond.wait(lock, [this]() { return m_count > 0 || m_eof; });
+            if (m_count == 0) {
+                break;
+            }
+
+            // The background thread never writes to a filled block, so the
+            // copy can happen without holding the lock.
+            const Block& block = m_blocks[m_head];
+            size_t n = std::min(numBytes - total, block.size - m_headPos);
+            lock.unlock();
+            std::memcpy(dest + total, block.data.data() + m_headPos, n);
+            lock.lock();
+
+            total += n;
+            m_headPos += n;
+            if (m_headPos == block.size) {
+                m_head = (m_head + 1) % kPLYReadAheadBlocks;
+                m_count--;
+                m_headPos = 0;
+                m_cond.notify_all();
+            }
+        }
+        return total;
+    }
+
+
+    void PLYReadAhead::seek(int64_t offset)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_generation++;
+            m_count = 0;
+            m_headPos = 0;
+            m_eof = false;
+            m_seekOffset = offset;
+        }
+        m_cond.notify_all();
+    }
+
+
+    void PLYReadAhead::run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_cond.wait(lock, [this]() { return m_stop || m_seekOffset >= 0 || (!m_eof && m_count < kPLYReadAheadBlocks); });
+            if (m_stop) {
+                return;
+            }
+            if (m_seekOffset >= 0) {
+                file_seek(m_f, m_seekOffset, SEEK_SET);
+                m_seekOffset = -1;
+                continue;
+            }
+
+            // Fill the next free block. The consumer can't see it until it's
+            // counted, so the read itself happens without the lock.
+            uint64_t generation = m_generation;
+            Block& block = m_blocks[(m_head + m_count) % kPLYReadAheadBlocks];
+            lock.unlock();
+            size_t fetched = fread(block.data.data(), sizeof(char), kPLYReadAheadBlockSize, m_f);
+            lock.lock();
+
+            if (generation != m_generation) {
+                continue; // A seek came in while we were reading.
+            }
+            block.size = fetched;
+            if (fetched > 0) {
+                m_count++;
+            }
+            if (fetched < kPLYReadAheadBlockSize) {
+                m_eof = true;
+            }
+            m_cond.notify_all();
+        }
+    }
+
+
     //
     // PLYReader methods
     //
 
-    PLYReader::PLYReader(const char* filename)
+    PLYReader::PLYReader(const char* filename) :
+        PLYReader(filename, false)
+    {
+    }
+
+
+    PLYReader::PLYReader(const char* filename, bool memoryMap)
     {
         m_buf = new char[kPLYReadBufferSize + 1];
         m_buf[kPLYReadBufferSize] = '\0';
@@ -601,6 +1175,7 @@ namespace miniply {
         m_valid = true;
 
         refill_buffer();
+        m_bufOffset = 0; // The first refill counts the empty initial buffer as consumed; it held no file data.
 
         m_valid = keyword("ply") && next_line() &&
             keyword("format") && advance() &&
@@ -613,6 +1188,16 @@ namespace miniply {
         if (!m_valid) {
             return;
         }
+
+        // Only little-endian binary data can be used in place, but ASCII rows
+        // can be parsed straight out of the mapping. If mapping fails we
+        // silently carry on with buffered reads. This has to be decided before
+        // the first refill in the data section, which starts reading ahead
+        // for buffered files.
+        if (memoryMap && m_fileType != PLYFileType::BinaryBigEndian) {
+            map_file(filename);
+        }
+
         m_inDataSection = true;
         if (m_fileType == PLYFileType::ASCII) {
             advance();
@@ -626,6 +1211,8 @@ namespace miniply {
 
     PLYReader::~PLYReader()
     {
+        unmap_file();
+        delete m_readAhead; // Stops the read-ahead thread before the file goes away.
         if (m_f != nullptr) {
             fclose(m_f);
         }
@@ -640,28 +1227,179 @@ namespace miniply {
     }
 
 
-    bool PLYReader::has_element() const
-    {
-        return m_valid && m_currentElement < m_elements.size();
+    bool PLYReader::is_memory_mapped() const
+    {
+        return m_mapData != nullptr;
+    }
+
+
+    bool PLYReader::has_element() const
+    {
+        return m_valid && m_currentElement < m_elements.size();
+    }
+
+
+    const PLYElement* PLYReader::element() const
+    {
+        assert(has_element());
+        return &m_elements[m_currentElement];
+    }
+
+
+    bool PLYReader::load_element()
+    {
+        assert(has_element());
+        if (m_elementLoaded) {
+            return true;
+        }
+
+        PLYElement& elem = m_elements[m_currentElement];
+        return elem.fixedSize ? load_fixed_size_element(elem) : load_variable_size_element(elem);
+    }
+
+
+    bool PLYReader::load_element_batches(uint32_t batchRows, const PLYRowBatchVisitor& visitor)
+    {
+        assert(has_element());
+        if (m_elementLoaded || batchRows == 0) {
+            return false;
+        }
+
+        PLYElement& elem = m_elements[m_currentElement];
+        bool completed = true;
+
+        if (!elem.fixedSize) {
+            // List properties make the row size vary, so there is no way to find
+            // a batch boundary without parsing everything before it.
+            if (!load_variable_size_element(elem)) {
+                return false;
+            }
+            const uint8_t* rows = m_elementPtr;
+            for (uint32_t firstRow = 0; firstRow < elem.count && completed; firstRow += batchRows) {
+                uint32_t numRows = std::min(batchRows, elem.count - firstRow);
+                m_elementPtr = rows + static_cast<size_t>(firstRow) * elem.rowStride;
+                m_elementSize = static_cast<size_t>(numRows) * elem.rowStride;
+                completed = visitor(firstRow, numRows);
+            }
+        }
+        else if (rows_are_mapped()) {
+            size_t numBytes = static_cast<size_t>(elem.count) * elem.rowStride;
+            size_t elementStart = static_cast<size_t>(m_bufOffset + (m_pos - m_buf));
+            if (elementStart > m_mapSize || numBytes > m_mapSize - elementStart) {
+                m_valid = false;
+                return false;
+            }
+            for (uint32_t firstRow = 0; firstRow < elem.count && completed; firstRow += batchRows) {
+                uint32_t numRows = std::min(batchRows, elem.count - firstRow);
+                m_elementPtr = m_mapData + elementStart + static_cast<size_t>(firstRow) * elem.rowStride;
+                m_elementSize = static_cast<size_t>(numRows) * elem.rowStride;
+                completed = visitor(firstRow, numRows);
+            }
+            skip_fixed_size_element(elem);
+        }
+        else {
+            uint32_t firstRow = 0;
+            while (firstRow < elem.count && completed) {
+                uint32_t numRows = std::min(batchRows, elem.count - firstRow);
+                if (!load_fixed_size_rows(elem, numRows)) {
+                    m_elementData.clear();
+                    m_elementData.shrink_to_fit();
+                    m_elementPtr = nullptr;
+                    m_elementSize = 0;
+                    return false;
+                }
+                completed = visitor(firstRow, numRows);
+                firstRow += numRows;
+            }
+
+            // If the visitor bailed out, move past the rows it didn't want.
+            uint32_t remainingRows = elem.count - firstRow;
+            if (remainingRows > 0) {
+                if (m_fileType == PLYFileType::ASCII) {
+                    for (uint32_t row = 0; row < remainingRows; row++) {
+                        next_line();
+                    }
+                }
+                else {
+                    skip_fixed_size_rows(elem, remainingRows);
+                }
+            }
+            m_elementData.clear();
+            m_elementData.shrink_to_fit();
+        }
+
+        m_elementPtr = nullptr;
+        m_elementSize = 0;
+        m_elementLoaded = true;
+        return completed;
     }
 
 
-    const PLYElement* PLYReader::element() const
+    bool PLYReader::load_element_sample(uint32_t numSamples)
     {
         assert(has_element());
-        return &m_elements[m_currentElement];
-    }
+        if (m_elementLoaded || numSamples == 0) {
+            return false;
+        }
 
+        PLYElement& elem = m_elements[m_currentElement];
+        if (!elem.fixedSize) {
+            return false;
+        }
+        numSamples = std::min(numSamples, elem.count);
 
-    bool PLYReader::load_element()
-    {
-        assert(has_element());
-        if (m_elementLoaded) {
+        if (m_fileType == PLYFileType::ASCII) {
+            // ASCII rows can't be found without reading every line before
+            // them, so the sample is simply the first rows. The rest of the
+            // element is only skipped if the caller moves on to the next one.
+            if (!load_fixed_size_rows(elem, numSamples)) {
+                return false;
+            }
+            m_skipRowsOnNextElement = elem.count - numSamples;
+            m_elementLoaded = true;
             return true;
         }
 
-        PLYElement& elem = m_elements[m_currentElement];
-        return elem.fixedSize ? load_fixed_size_element(elem) : load_variable_size_element(elem);
+        // Binary rows are at fixed offsets, so we can jump straight to each
+        // sampled row and leave everything in between unread.
+        std::vector<uint8_t> sample;
+        sample.reserve(static_cast<size_t>(numSamples) * elem.loadedStride);
+        const int64_t elementStart = m_bufOffset + (m_pos - m_buf);
+        const int64_t elementSize = static_cast<int64_t>(elem.count) * elem.rowStride;
+
+        if (rows_are_mapped()) {
+            if (elementStart + elementSize > static_cast<int64_t>(m_mapSize)) {
+                m_valid = false;
+                return false;
+            }
+            for (uint32_t i = 0; i < numSamples; i++) {
+                uint64_t row = static_cast<uint64_t>(i) * elem.count / numSamples;
+                const uint8_t* src = m_mapData + elementStart + row * elem.rowStride;
+                sample.insert(sample.end(), src, src + elem.rowStride);
+            }
+        }
+        else {
+            // Reading ahead would only fetch the rows we're jumping over.
+            stop_read_ahead();
+            for (uint32_t i = 0; i < numSamples; i++) {
+                uint64_t row = static_cast<uint64_t>(i) * elem.count / numSamples;
+                int64_t rowStart = elementStart + static_cast<int64_t>(row * elem.rowStride);
+                skip_bytes(rowStart - (m_bufOffset + (m_pos - m_buf)));
+                if (!load_fixed_size_rows(elem, 1)) {
+                    return false;
+                }
+                sample.insert(sample.end(), m_elementData.begin(), m_elementData.end());
+            }
+        }
+
+        // Leave the read position at the end of the element, as a full load would.
+        skip_bytes(elementStart + elementSize - (m_bufOffset + (m_pos - m_buf)));
+
+        m_elementData.swap(sample);
+        m_elementPtr = m_elementData.data();
+        m_elementSize = m_elementData.size();
+        m_elementLoaded = true;
+        return true;
     }
 
 
@@ -677,6 +1415,12 @@ namespace miniply {
         m_currentElement++;
 
         if (m_elementLoaded) {
+            // An ASCII sample only read the first rows of the element.
+            for (uint32_t row = 0; row < m_skipRowsOnNextElement; row++) {
+                next_line();
+            }
+            m_skipRowsOnNextElement = 0;
+
             // Clear any temporary storage used for list properties in the current element.
             for (PLYProperty& prop : elem.properties) {
                 if (prop.countType == PLYPropertyType::None) {
@@ -690,6 +1434,8 @@ namespace miniply {
 
             // Clear temporary storage for the non-list properties in the current element.
             m_elementData.clear();
+            m_elementPtr = nullptr;
+            m_elementSize = 0;
             m_elementLoaded = false;
             return;
         }
@@ -704,21 +1450,7 @@ namespace miniply {
             }
         }
         else if (elem.fixedSize) {
-            int64_t elementStart = static_cast<int64_t>(m_pos - m_buf);
-            int64_t elementSize = elem.rowStride * elem.count;
-            int64_t elementEnd = elementStart + elementSize;
-            if (elementEnd >= kPLYReadBufferSize) {
-                m_bufOffset += elementEnd;
-                file_seek(m_f, m_bufOffset, SEEK_SET);
-                m_bufEnd = m_buf + kPLYReadBufferSize;
-                m_pos = m_bufEnd;
-                m_end = m_bufEnd;
-                refill_buffer();
-            }
-            else {
-                m_pos = m_buf + elementEnd;
-                m_end = m_pos;
-            }
+            skip_fixed_size_element(elem);
         }
         else if (m_fileType == PLYFileType::Binary) {
             for (uint32_t row = 0; row < elem.count; row++) {
@@ -815,6 +1547,12 @@ namespace miniply {
     }
 
 
+    void PLYReader::set_parallel_for(const PLYParallelFor& parallelFor)
+    {
+        m_parallelFor = parallelFor;
+    }
+
+
     PLYFileType PLYReader::file_type() const
     {
         return m_fileType;
@@ -863,12 +1601,93 @@ namespace miniply {
     }
 
 
+    const uint8_t* PLYReader::element_data() const
+    {
+        return m_elementSize > 0 ? m_elementPtr : nullptr;
+    }
+
+
+    size_t PLYReader::buffer_bytes() const
+    {
+        size_t bytes = 0;
+        if (m_buf != nullptr) {
+            bytes += kPLYReadBufferSize + 1;
+        }
+        if (m_tmpBuf != nullptr) {
+            bytes += kPLYTempBufferSize + 1;
+        }
+        if (m_readAhead != nullptr) {
+            bytes += size_t(kPLYReadAheadBlocks) * kPLYReadAheadBlockSize;
+        }
+        bytes += m_elementData.capacity() + m_asciiText.capacity();
+        for (const PLYElement& elem : m_elements) {
+            for (const PLYProperty& prop : elem.properties) {
+                bytes += prop.listData.capacity() + prop.rowCount.capacity() * sizeof(uint32_t);
+            }
+        }
+        return bytes;
+    }
+
+
+    bool PLYReader::set_projection(const uint32_t propIdxs[], uint32_t numProps)
+    {
+        if (!has_element() || m_elementLoaded) {
+            return false;
+        }
+
+        PLYElement& elem = m_elements[m_currentElement];
+        for (uint32_t i = 0; i < numProps; i++) {
+            if (propIdxs[i] >= elem.properties.size()) {
+                return false;
+            }
+        }
+
+        for (PLYProperty& prop : elem.properties) {
+            prop.projected = prop.countType != PLYPropertyType::None;
+        }
+        for (uint32_t i = 0; i < numProps; i++) {
+            elem.properties[propIdxs[i]].projected = true;
+        }
+
+        // Only rows that get copied out of the read buffer one at a time can be
+        // compacted. Mapped rows are used where they are, and rows with lists in
+        // them are parsed property by property into the full layout.
+        bool compact = !rows_are_mapped() && elem.fixedSize && elem.rowStride <= kPLYReadBufferSize;
+        elem.loadedStride = 0;
+        for (PLYProperty& prop : elem.properties) {
+            if (prop.countType != PLYPropertyType::None) {
+                continue;
+            }
+            if (!compact) {
+                prop.loadedOffset = prop.offset;
+            }
+            else if (prop.projected) {
+                prop.loadedOffset = elem.loadedStride;
+                elem.loadedStride += kPLYPropertySize[uint32_t(prop.type)];
+            }
+        }
+        if (!compact) {
+            elem.loadedStride = elem.rowStride;
+        }
+        return true;
+    }
+
+
     uint32_t PLYReader::num_rows() const
     {
         return has_element() ? element()->count : 0;
     }
 
 
+    uint32_t PLYReader::num_loaded_rows() const
+    {
+        if (!has_element() || element()->loadedStride == 0) {
+            return 0;
+        }
+        return static_cast<uint32_t>(m_elementSize / element()->loadedStride);
+    }
+
+
     uint32_t PLYReader::find_property(const char* name) const
     {
         return has_element() ? element()->find_property(name) : kInvalidIndex;
@@ -889,6 +1708,12 @@ namespace miniply {
 
 
     bool PLYReader::extract_properties(const uint32_t propIdxs[], uint32_t numProps, PLYPropertyType destType, void* dest) const
+    {
+        return extract_properties_range(propIdxs, numProps, destType, dest, 0, num_loaded_rows());
+    }
+
+
+    bool PLYReader::extract_properties_range(const uint32_t propIdxs[], uint32_t numProps, PLYPropertyType destType, void* dest, uint32_t firstRow, uint32_t numRows) const
     {
         if (numProps == 0) {
             return false;
@@ -899,31 +1724,42 @@ namespace miniply {
         // Make sure all property indexes are valid and that none of the properties
         // are lists (this function only extracts non-list data).
         for (uint32_t i = 0; i < numProps; i++) {
-            if (propIdxs[i] >= elem->properties.size()) {
+            if (propIdxs[i] >= elem->properties.size() || !elem->properties[propIdxs[i]].projected) {
                 return false;
             }
         }
 
+        // Make sure the requested rows have actually been loaded.
+        if (elem->loadedStride == 0) {
+            return false;
+        }
+        const size_t loadedRows = m_elementSize / elem->loadedStride;
+        if (firstRow > loadedRows || numRows > loadedRows - firstRow) {
+            return false;
+        }
+        const uint8_t* rowsBegin = m_elementPtr + static_cast<size_t>(firstRow) * elem->loadedStride;
+        const uint8_t* rowsEnd = rowsBegin + static_cast<size_t>(numRows) * elem->loadedStride;
+
         // Find out whether we have contiguous columns. If so, we may be able to
         // use a more efficient data extraction technique.
         bool contiguousCols = true;
-        uint32_t expectedOffset = elem->properties[propIdxs[0]].offset;
+        uint32_t expectedOffset = elem->properties[propIdxs[0]].loadedOffset;
         for (uint32_t i = 0; i < numProps; i++) {
             uint32_t propIdx = propIdxs[i];
             const PLYProperty& prop = elem->properties[propIdx];
-            if (prop.offset != expectedOffset) {
+            if (prop.loadedOffset != expectedOffset) {
                 contiguousCols = false;
                 break;
             }
-            expectedOffset = prop.offset + kPLYPropertySize[uint32_t(prop.type)];
+            expectedOffset = prop.loadedOffset + kPLYPropertySize[uint32_t(prop.type)];
         }
 
         // If the row we're extracting is contiguous in memory (i.e. there are no
         // gaps anywhere in a row - start, end or middle), we can use an even MORE
         // efficient data extraction technique.
         bool contiguousRows = contiguousCols &&
-            (elem->properties[propIdxs[0]].offset == 0) &&
-            (expectedOffset == elem->rowStride);
+            (elem->properties[propIdxs[0]].loadedOffset == 0) &&
+            (expectedOffset == elem->loadedStride);
 
         // If no data conversion is required, we can memcpy chunks of data
         // directly over to `dest`. How big those chunks will be depends on whether
@@ -946,34 +1782,34 @@ namespace miniply {
                 // Most efficient case is when the rows are contiguous. It means we're
                 // simply copying the entire data block for this element, which we can
                 // do with a single memcpy.
-                std::memcpy(to, m_elementData.data(), m_elementData.size());
+                std::memcpy(to, rowsBegin, static_cast<size_t>(rowsEnd - rowsBegin));
             }
             else if (contiguousCols) {
                 // If the rows aren't contiguous, but the columns we're extracting
                 // within each row are, then we can do a single memcpy per row.
-                const uint8_t* from = m_elementData.data() + elem->properties[propIdxs[0]].offset;
-                const uint8_t* end = m_elementData.data() + m_elementData.size();
-                const size_t numBytes = expectedOffset - elem->properties[propIdxs[0]].offset;
+                const uint8_t* from = rowsBegin + elem->properties[propIdxs[0]].loadedOffset;
+                const uint8_t* end = rowsEnd;
+                const size_t numBytes = expectedOffset - elem->properties[propIdxs[0]].loadedOffset;
                 while (from < end) {
                     std::memcpy(to, from, numBytes);
-                    from += elem->rowStride;
+                    from += elem->loadedStride;
                     to += numBytes;
                 }
             }
             else {
                 // If the columns aren't contiguous, we must memcpy each one separately.
-                const uint8_t* row = m_elementData.data();
-                const uint8_t* end = m_elementData.data() + m_elementData.size();
+                const uint8_t* row = rowsBegin;
+                const uint8_t* end = rowsEnd;
                 uint8_t* to2 = reinterpret_cast<uint8_t*>(dest);
                 size_t colBytes = kPLYPropertySize[uint32_t(destType)]; // size of an output column in bytes.
                 while (row < end) {
                     for (uint32_t i = 0; i < numProps; i++) {
                         uint32_t propIdx = propIdxs[i];
                         const PLYProperty& prop = elem->properties[propIdx];
-                        std::memcpy(to2, row + prop.offset, colBytes);
+                        std::memcpy(to2, row + prop.loadedOffset, colBytes);
                         to2 += colBytes;
                     }
-                    row += elem->rowStride;
+                    row += elem->loadedStride;
                 }
             }
         }
@@ -981,18 +1817,18 @@ namespace miniply {
             // We will have to do data type conversions on the column values here. We
             // cannot simply use memcpy in this case, every column has to be
             // processed separately.
-            const uint8_t* row = m_elementData.data();
-            const uint8_t* end = m_elementData.data() + m_elementData.size();
+            const uint8_t* row = rowsBegin;
+            const uint8_t* end = rowsEnd;
             uint8_t* to2 = reinterpret_cast<uint8_t*>(dest);
             size_t colBytes = kPLYPropertySize[uint32_t(destType)]; // size of an output column in bytes.
             while (row < end) {
                 for (uint32_t i = 0; i < numProps; i++) {
                     uint32_t propIdx = propIdxs[i];
                     const PLYProperty& prop = elem->properties[propIdx];
-                    copy_and_convert(to2, destType, row + prop.offset, prop.type);
+                    copy_and_convert(to2, destType, row + prop.loadedOffset, prop.type);
                     to2 += colBytes;
                 }
-                row += elem->rowStride;
+                row += elem->loadedStride;
             }
         }
 
@@ -1022,7 +1858,7 @@ namespace miniply {
         // Make sure all property indexes are valid and that none of the properties
         // are lists (this function only extracts non-list data).
         for (uint32_t i = 0; i < numProps; i++) {
-            if (propIdxs[i] >= elem->properties.size()) {
+            if (propIdxs[i] >= elem->properties.size() || !elem->properties[propIdxs[i]].projected) {
                 return false;
             }
         }
@@ -1030,15 +1866,15 @@ namespace miniply {
         // Find out whether we have contiguous columns. If so, we may be able to
         // use a more efficient data extraction technique.
         bool contiguousCols = true;
-        uint32_t expectedOffset = elem->properties[propIdxs[0]].offset;
+        uint32_t expectedOffset = elem->properties[propIdxs[0]].loadedOffset;
         for (uint32_t i = 0; i < numProps; i++) {
             uint32_t propIdx = propIdxs[i];
             const PLYProperty& prop = elem->properties[propIdx];
-            if (prop.offset != expectedOffset) {
+            if (prop.loadedOffset != expectedOffset) {
                 contiguousCols = false;
                 break;
             }
-            expectedOffset = prop.offset + kPLYPropertySize[uint32_t(prop.type)];
+            expectedOffset = prop.loadedOffset + kPLYPropertySize[uint32_t(prop.type)];
         }
 
         // If no data conversion is required, we can memcpy chunks of data
@@ -1062,19 +1898,19 @@ namespace miniply {
             if (contiguousCols) {
                 // If the rows aren't contiguous, but the columns we're extracting
                 // within each row are, then we can do a single memcpy per row.
-                const uint8_t* from = m_elementData.data() + elem->properties[propIdxs[0]].offset;
-                const uint8_t* end = m_elementData.data() + m_elementData.size();
-                const size_t numBytes = expectedOffset - elem->properties[propIdxs[0]].offset;
+                const uint8_t* from = m_elementPtr + elem->properties[propIdxs[0]].loadedOffset;
+                const uint8_t* end = m_elementPtr + m_elementSize;
+                const size_t numBytes = expectedOffset - elem->properties[propIdxs[0]].loadedOffset;
                 while (from < end) {
                     std::memcpy(to, from, numBytes);
-                    from += elem->rowStride;
+                    from += elem->loadedStride;
                     to += destStride;
                 }
             }
             else {
                 // If the columns aren't contiguous, we must memcpy each one separately.
-                const uint8_t* row = m_elementData.data();
-                const uint8_t* end = m_elementData.data() + m_elementData.size();
+                const uint8_t* row = m_elementPtr;
+                const uint8_t* end = m_elementPtr + m_elementSize;
                 uint8_t* to2 = reinterpret_cast<uint8_t*>(dest);
                 const size_t colBytes = kPLYPropertySize[uint32_t(destType)]; // size of an output column in bytes.
                 const size_t colPadding = destStride - minDestStride;
@@ -1082,10 +1918,10 @@ namespace miniply {
                     for (uint32_t i = 0; i < numProps; i++) {
                         uint32_t propIdx = propIdxs[i];
                         const PLYProperty& prop = elem->properties[propIdx];
-                        std::memcpy(to2, row + prop.offset, colBytes);
+                        std::memcpy(to2, row + prop.loadedOffset, colBytes);
                         to2 += colBytes;
                     }
-                    row += elem->rowStride;
+                    row += elem->loadedStride;
                     to2 += colPadding;
                 }
             }
@@ -1094,8 +1930,8 @@ namespace miniply {
             // We will have to do data type conversions on the column values here. We
             // cannot simply use memcpy in this case, every column has to be
             // processed separately.
-            const uint8_t* row = m_elementData.data();
-            const uint8_t* end = m_elementData.data() + m_elementData.size();
+            const uint8_t* row = m_elementPtr;
+            const uint8_t* end = m_elementPtr + m_elementSize;
             uint8_t* to2 = reinterpret_cast<uint8_t*>(dest);
             size_t colBytes = kPLYPropertySize[uint32_t(destType)]; // size of an output column in bytes.
             size_t colPadding = destStride - minDestStride;
@@ -1103,10 +1939,10 @@ namespace miniply {
                 for (uint32_t i = 0; i < numProps; i++) {
                     uint32_t propIdx = propIdxs[i];
                     const PLYProperty& prop = elem->properties[propIdx];
-                    copy_and_convert(to2, destType, row + prop.offset, prop.type);
+                    copy_and_convert(to2, destType, row + prop.loadedOffset, prop.type);
                     to2 += colBytes;
                 }
-                row += elem->rowStride;
+                row += elem->loadedStride;
                 to2 += colPadding;
             }
         }
@@ -1335,6 +2171,96 @@ namespace miniply {
     // PLYReader private methods
     //
 
+    bool PLYReader::map_file(const char* filename)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            return false;
+        }
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        m_mapFileHandle = file;
+        m_mapHandle = mapping;
+        m_mapData = static_cast<const uint8_t*>(view);
+        m_mapSize = static_cast<size_t>(fileSize.QuadPart);
+        return true;
+#else
+        int fd = open(filename, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // The mapping keeps its own reference to the file.
+        if (view == MAP_FAILED) {
+            return false;
+        }
+        madvise(view, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        m_mapData = static_cast<const uint8_t*>(view);
+        m_mapSize = static_cast<size_t>(st.st_size);
+        return true;
+#endif
+    }
+
+
+    void PLYReader::unmap_file()
+    {
+        if (m_mapData == nullptr) {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(m_mapData);
+        CloseHandle(static_cast<HANDLE>(m_mapHandle));
+        CloseHandle(static_cast<HANDLE>(m_mapFileHandle));
+        m_mapHandle = nullptr;
+        m_mapFileHandle = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(m_mapData), m_mapSize);
+#endif
+        m_mapData = nullptr;
+        m_mapSize = 0;
+    }
+
+
+    void PLYReader::stop_read_ahead()
+    {
+        if (m_readAhead != nullptr) {
+            delete m_readAhead;
+            m_readAhead = nullptr;
+            // Buffered reads carry on from the end of what's in the buffer.
+            file_seek(m_f, m_bufOffset + (m_bufEnd - m_buf), SEEK_SET);
+        }
+        m_readAheadStopped = true;
+    }
+
+
+    bool PLYReader::rows_are_mapped() const
+    {
+        // Only little-endian binary rows can be used in place; mapped ASCII
+        // rows are still parsed into m_elementData.
+        return m_mapData != nullptr && m_fileType == PLYFileType::Binary;
+    }
+
+
     bool PLYReader::refill_buffer()
     {
         if (m_f == nullptr || m_atEOF) {
@@ -1358,13 +2284,23 @@ namespace miniply {
         size_t keep = static_cast<size_t>(m_bufEnd - m_pos);
         if (keep > 0 && m_pos > m_buf) {
             std::memmove(m_buf, m_pos, sizeof(char) * keep);
-            m_bufOffset += static_cast<int64_t>(m_pos - m_buf);
         }
+        // m_bufOffset is the file offset of m_buf[0]; the memory-mapped path
+        // relies on it to locate element data.
+        m_bufOffset += static_cast<int64_t>(m_pos - m_buf);
         m_end = m_buf + (m_end - m_pos);
         m_pos = m_buf;
 
+        // The header is read synchronously. After that the file is mostly
+        // read front to back, so for buffered reads a background thread
+        // fetches the next blocks while the current one is being decoded.
+        if (m_readAhead == nullptr && m_inDataSection && m_mapData == nullptr && !m_readAheadStopped) {
+            m_readAhead = new PLYReadAhead(m_f);
+        }
+
         // Fill the remaining space in the buffer with data from the file.
-        size_t fetched = fread(m_buf + keep, sizeof(char), kPLYReadBufferSize - keep, m_f) + keep;
+        size_t numBytes = kPLYReadBufferSize - keep;
+        size_t fetched = (m_readAhead != nullptr ? m_readAhead->read(m_buf + keep, numBytes) : fread(m_buf + keep, sizeof(char), numBytes, m_f)) + keep;
         m_atEOF = fetched < kPLYReadBufferSize;
         m_bufEnd = m_buf + fetched;
 
@@ -1525,15 +2461,21 @@ namespace miniply {
     }
 
 
+    bool PLYReader::uint_literal(uint32_t* value)
+    {
+        return miniply::uint_literal(m_pos, &m_end, value);
+    }
+
+
     bool PLYReader::float_literal(float* value)
     {
-        return miniply::float_literal(m_pos, &m_end, value);
+        return miniply::fast_float_literal(m_pos, &m_end, value);
     }
 
 
     bool PLYReader::double_literal(double* value)
     {
-        return miniply::double_literal(m_pos, &m_end, value);
+        return miniply::fast_double_literal(m_pos, &m_end, value);
     }
 
 
@@ -1549,19 +2491,19 @@ namespace miniply {
 
     bool PLYReader::parse_element()
     {
-        int count = 0;
+        uint32_t count = 0;
 
         m_valid = keyword("element") && advance() &&
             identifier(m_tmpBuf, kPLYTempBufferSize) && advance() &&
-            int_literal(&count) && next_line();
-        if (!m_valid || count < 0) {
+            uint_literal(&count) && next_line();
+        if (!m_valid) {
             return false;
         }
 
         m_elements.push_back(PLYElement());
         PLYElement& elem = m_elements.back();
         elem.name = m_tmpBuf;
-        elem.count = static_cast<uint32_t>(count);
+        elem.count = count;
         elem.properties.reserve(10);
 
         while (m_valid && keyword("property")) {
@@ -1610,22 +2552,43 @@ namespace miniply {
     {
         size_t numBytes = static_cast<size_t>(elem.count) * elem.rowStride;
 
-        m_elementData.resize(numBytes);
+        if (rows_are_mapped()) {
+            // Zero-copy: point straight at the rows in the mapped file, then move
+            // the buffered read position past them so that later elements can
+            // still be parsed as usual.
+            size_t elementStart = static_cast<size_t>(m_bufOffset + (m_pos - m_buf));
+            if (elementStart > m_mapSize || numBytes > m_mapSize - elementStart) {
+                m_valid = false;
+                return false;
+            }
+            m_elementPtr = m_mapData + elementStart;
+            m_elementSize = numBytes;
+            skip_fixed_size_element(elem);
+            m_elementLoaded = true;
+            return true;
+        }
 
-        if (m_fileType == PLYFileType::ASCII) {
-            size_t back = 0;
+        if (!load_fixed_size_rows(elem, elem.count)) {
+            return false;
+        }
+        m_elementLoaded = true;
+        return true;
+    }
 
-            for (uint32_t row = 0; row < elem.count; row++) {
-                for (PLYProperty& prop : elem.properties) {
-                    if (!load_ascii_scalar_property(prop, back)) {
-                        m_valid = false;
-                        return false;
-                    }
-                }
-                next_line();
-            }
+
+    bool PLYReader::load_fixed_size_rows(PLYElement& elem, uint32_t numRows)
+    {
+        // Reads the next `numRows` rows of the element into m_elementData,
+        // replacing whatever was there before. Properties left out by a
+        // projection are skipped over.
+        if (m_fileType == PLYFileType::ASCII) {
+            return load_ascii_rows(elem, numRows);
         }
-        else {
+
+        size_t numBytes = static_cast<size_t>(numRows) * elem.loadedStride;
+        m_elementData.resize(numBytes);
+
+        if (elem.loadedStride == elem.rowStride) {
             uint8_t* dst = m_elementData.data();
             uint8_t* dstEnd = dst + numBytes;
             while (dst < dstEnd) {
@@ -1645,34 +2608,212 @@ namespace miniply {
                 m_valid = false;
                 return false;
             }
+        }
+        else {
+            // Projected rows: gather the wanted properties from each row,
+            // merging neighbouring ones into a single copy.
+            struct CopyRun {
+                uint32_t from;
+                uint32_t to;
+                uint32_t size;
+            };
+            std::vector<CopyRun> runs;
+            for (const PLYProperty& prop : elem.properties) {
+                if (!prop.projected) {
+                    continue;
+                }
+                uint32_t size = kPLYPropertySize[uint32_t(prop.type)];
+                if (!runs.empty() && runs.back().from + runs.back().size == prop.offset && runs.back().to + runs.back().size == prop.loadedOffset) {
+                    runs.back().size += size;
+                }
+                else {
+                    runs.push_back(CopyRun{ prop.offset, prop.loadedOffset, size });
+                }
+            }
+
+            uint8_t* dst = m_elementData.data();
+            for (uint32_t row = 0; row < numRows; row++) {
+                if (m_pos + elem.rowStride > m_bufEnd) {
+                    if (!refill_buffer() || m_pos + elem.rowStride > m_bufEnd) {
+                        m_valid = false;
+                        return false;
+                    }
+                }
+                for (const CopyRun& run : runs) {
+                    std::memcpy(dst + run.to, m_pos + run.from, run.size);
+                }
+                m_pos += elem.rowStride;
+                m_end = m_pos;
+                dst += elem.loadedStride;
+            }
+        }
+
+        // We assume the CPU is little endian, so if the file is big-endian we
+        // need to do an endianness swap on every data item in the block. The
+        // rows were copied in bulk above, so this is a separate vectorized pass.
+        if (m_fileType == PLYFileType::BinaryBigEndian) {
+            endian_swap_rows(elem, m_elementData.data(), numRows, m_parallelFor);
+        }
+
+        m_elementPtr = m_elementData.data();
+        m_elementSize = m_elementData.size();
+        return true;
+    }
+
+
+    bool PLYReader::skip_fixed_size_element(const PLYElement& elem)
+    {
+        return skip_fixed_size_rows(elem, elem.count);
+    }
+
+
+    bool PLYReader::skip_fixed_size_rows(const PLYElement& elem, uint32_t numRows)
+    {
+        // Binary files only: the byte size of ASCII rows isn't known up front.
+        int64_t elementSize = static_cast<int64_t>(elem.rowStride) * numRows;
+        return skip_bytes(elementSize);
+    }
+
+
+    bool PLYReader::skip_bytes(int64_t numBytes)
+    {
+        int64_t elementStart = static_cast<int64_t>(m_pos - m_buf);
+        int64_t elementEnd = elementStart + numBytes;
+        if (elementEnd >= static_cast<int64_t>(m_bufEnd - m_buf)) {
+            if (m_readAhead != nullptr) {
+                m_readAhead->seek(m_bufOffset + elementEnd);
+            }
+            else {
+                file_seek(m_f, m_bufOffset + elementEnd, SEEK_SET);
+            }
+            // refill_buffer() moves m_bufOffset past everything before m_pos,
+            // which is the whole (now discarded) buffer.
+            m_bufOffset += elementEnd - kPLYReadBufferSize;
+            m_atEOF = false;
+            m_bufEnd = m_buf + kPLYReadBufferSize;
+            m_pos = m_bufEnd;
+            m_end = m_bufEnd;
+            refill_buffer();
+        }
+        else {
+            m_pos = m_buf + elementEnd;
+            m_end = m_pos;
+        }
+        return true;
+    }
+
+
+    bool PLYReader::load_ascii_rows(PLYElement& elem, uint32_t numRows)
+    {
+        // Find the start of every kPLYAsciiRowsPerTask'th row. Looking for
+        // newlines is much cheaper than parsing the numbers between them, so
+        // this part stays serial; the parsing is then split into tasks at
+        // those rows, which all write to their own part of m_elementData.
+        std::vector<size_t> taskStarts;
+        taskStarts.reserve(numRows / kPLYAsciiRowsPerTask + 1);
+        const char* text = nullptr;
+        size_t textSize = 0;
+
+        if (m_mapData != nullptr) {
+            size_t start = static_cast<size_t>(m_bufOffset + (m_pos - m_buf));
+            if (start > m_mapSize) {
+                m_valid = false;
+                return false;
+            }
+            text = reinterpret_cast<const char*>(m_mapData) + start;
+            const char* textEnd = reinterpret_cast<const char*>(m_mapData) + m_mapSize;
+            const char* pos = text;
+            for (uint32_t row = 0; row < numRows; row++) {
+                if (pos == textEnd) {
+                    m_valid = false;
+                    return false;
+                }
+                if (row % kPLYAsciiRowsPerTask == 0) {
+                    taskStarts.push_back(static_cast<size_t>(pos - text));
+                }
+                const char* newline = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(textEnd - pos)));
+                pos = (newline != nullptr) ? newline + 1 : textEnd;
+            }
+            textSize = static_cast<size_t>(pos - text);
+            skip_bytes(static_cast<int64_t>(textSize));
 
-            // We assume the CPU is little endian, so if the file is big-endian we
-            // need to do an endianness swap on every data item in the block.
-            if (m_fileType == PLYFileType::BinaryBigEndian) {
-                uint8_t* data = m_elementData.data();
-                for (uint32_t row = 0; row < elem.count; row++) {
-                    for (PLYProperty& prop : elem.properties) {
-                        size_t numBytes2 = kPLYPropertySize[uint32_t(prop.type)];
-                        switch (numBytes2) {
-                        case 2:
-                            endian_swap_2(data);
-                            break;
-                        case 4:
-                            endian_swap_4(data);
-                            break;
-                        case 8:
-                            endian_swap_8(data);
-                            break;
-                        default:
-                            break;
+            if (textSize > 0 && pos == textEnd && textEnd[-1] != '\n') {
+                // The last row runs up to the end of the file, where there's
+                // no terminator to stop the parser: parse a terminated copy.
+                m_asciiText.assign(text, textEnd);
+                m_asciiText.push_back('\0');
+                text = m_asciiText.data();
+            }
+        }
+        else {
+            // Copy the rows out of the read buffer as we go. Rows can straddle
+            // the end of the buffer, so copies are made a buffer at a time.
+            m_asciiText.clear();
+            const char* copyStart = m_pos;
+            for (uint32_t row = 0; row < numRows; row++) {
+                size_t rowStart = m_asciiText.size() + static_cast<size_t>(m_pos - copyStart);
+                if (row % kPLYAsciiRowsPerTask == 0) {
+                    taskStarts.push_back(rowStart);
+                }
+                while (true) {
+                    const char* newline = static_cast<const char*>(std::memchr(m_pos, '\n', static_cast<size_t>(m_bufEnd - m_pos)));
+                    if (newline != nullptr) {
+                        m_pos = newline + 1;
+                        break;
+                    }
+                    m_asciiText.insert(m_asciiText.end(), copyStart, m_bufEnd);
+                    m_pos = m_bufEnd;
+                    m_end = m_pos;
+                    if (!refill_buffer()) {
+                        // A final row without a newline is fine, a missing one isn't.
+                        if (m_asciiText.size() == rowStart || row + 1 < numRows) {
+                            m_valid = false;
+                            return false;
                         }
-                        data += numBytes2;
+                        copyStart = m_pos;
+                        break;
                     }
+                    copyStart = m_pos;
+                }
+            }
+            m_asciiText.insert(m_asciiText.end(), copyStart, m_pos);
+            m_end = m_pos;
+            textSize = m_asciiText.size();
+            m_asciiText.push_back('\0');
+            text = m_asciiText.data();
+        }
+
+        m_elementData.resize(static_cast<size_t>(numRows) * elem.loadedStride);
+        uint8_t* dest = m_elementData.data();
+        const uint32_t numTasks = static_cast<uint32_t>(taskStarts.size());
+        std::atomic<bool> failed(false);
+        auto parseTask = [&](uint32_t task) {
+            const uint32_t firstRow = task * kPLYAsciiRowsPerTask;
+            const uint32_t endRow = std::min(firstRow + kPLYAsciiRowsPerTask, numRows);
+            const char* pos = text + taskStarts[task];
+            for (uint32_t row = firstRow; row < endRow; row++) {
+                if (!parse_ascii_row(elem, pos, dest + static_cast<size_t>(row) * elem.loadedStride)) {
+                    failed = true;
+                    return;
                 }
             }
+        };
+        if (m_parallelFor && numTasks > 1) {
+            m_parallelFor(numTasks, parseTask);
+        }
+        else {
+            for (uint32_t task = 0; task < numTasks; task++) {
+                parseTask(task);
+            }
         }
 
-        m_elementLoaded = true;
+        m_asciiText.clear();
+        if (failed) {
+            m_valid = false;
+            return false;
+        }
+        m_elementPtr = m_elementData.data();
+        m_elementSize = m_elementData.size();
         return true;
     }
 
@@ -1688,7 +2829,7 @@ namespace miniply {
         // listData vector as many times during loading.
         for (PLYProperty& prop : elem.properties) {
             if (prop.countType != PLYPropertyType::None) {
-                prop.listData.reserve(elem.count * kPLYPropertySize[uint32_t(prop.type)] * 3);
+                prop.listData.reserve(static_cast<size_t>(elem.count) * kPLYPropertySize[uint32_t(prop.type)] * 3);
             }
         }
 
@@ -1733,6 +2874,8 @@ namespace miniply {
             }
         }
 
+        m_elementPtr = m_elementData.data();
+        m_elementSize = m_elementData.size();
         m_elementLoaded = true;
         return true;
     }
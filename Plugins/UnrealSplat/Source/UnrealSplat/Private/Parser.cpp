@@ -3,7 +3,21 @@
 
 #include "Parser.h"
 #include "Miniply.h"
+#include "GaussianSplatBuffer.h"
+#include "SplatKernels.h"
+#include "SplatArena.h"
+#include "GaussianSplatCloud.h"
+#include "CompressedSplatDecoder.h"
+#include "SpzReader.h"
+#include "MappedSplatReaders.h"
+#include "SplatPLYWriter.h"
+#include "SplatCloudMerge.h"
+#include "SplatCropFilter.h"
+#include "ImageSplatSequence.h"
+#include "SplatTexturePages.h"
+#include "SplatCompactEncoding.h"
 #include "HAL/PlatformFileManager.h" // Core
+#include "HAL/FileManager.h" // Core
 #include "Misc/FileHelper.h" // Core
 #include "Misc/Paths.h" // Core
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -17,6 +31,9 @@
 #include "Engine/TextureDefines.h" // For TextureMipGenSettings
 #include "ImageUtils.h" // Not strictly needed for FLinearColor, but good for general image utilities.
 #include "Math/UnrealMathUtility.h" // For FMath::Memcpy
+#include "Async/ParallelFor.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
 
 // ---------- Constants ----------
 
@@ -39,17 +56,52 @@ const char* kPropertyTypes[] = {
 
 const float C0 = 0.28209479177387814;
 
-struct FGaussianSplattingTextureData {
-	TArray<FLinearColor> PositionTextureData;
-	TArray<FLinearColor> ScaleTextureData;
-	TArray<FLinearColor> RotationTextureData;
-	TArray<FLinearColor> ColorTextureData;
-	TArray<FLinearColor> harmonicsL1TextureData;
-	TArray<FLinearColor> harmonicsL2TextureData;
-	TArray<FLinearColor> harmonicsL31TextureData;
-	TArray<FLinearColor> harmonicsL32TextureData;
+static TAutoConsoleVariable<int32> CVarSplatMaxTextureDimension(
+	TEXT("UnrealSplat.MaxTextureDimension"),
+	0,
+	TEXT("Largest side of an output texture in texels; models with more texels are split into texture pages. 0 uses the engine's limit for non-virtual textures."));
+
+// A texture asset whose source mip stays locked while splat batches are converted into it.
+// Textures with a source format other than RGBA32F are converted into Staging instead, and encoded into
+// their source once all texels are known.
+struct FSplatTextureTarget {
+	UTexture2D* Texture;
+	FLinearColor* Texels;
+	TArray64<FLinearColor> Staging;
+	int64 NumPixels;
+	int32 Width;
+	int32 Height;
+	ETextureSourceFormat Format;
+	bool bLocked;
+
+	FSplatTextureTarget()
+		: Texture(nullptr)
+		, Texels(nullptr)
+		, Staging()
+		, NumPixels(0)
+		, Width(0)
+		, Height(0)
+		, Format(TSF_RGBA32F)
+		, bLocked(false)
+	{
+	}
+};
 
-	FGaussianSplattingTextureData()
+// Every output texture of the splats [FirstSplat, FirstSplat + NumSplats) of a model
+struct FSplatTexturePage {
+	FSplatTextureTarget PositionTextureData;
+	FSplatTextureTarget ScaleTextureData;
+	FSplatTextureTarget RotationTextureData;
+	FSplatTextureTarget ColorTextureData;
+	FSplatTextureTarget harmonicsL1TextureData;
+	FSplatTextureTarget harmonicsL2TextureData;
+	FSplatTextureTarget harmonicsL31TextureData;
+	FSplatTextureTarget harmonicsL32TextureData;
+	int32 FirstSplat;
+	int32 NumSplats;
+	bool bFinished;
+
+	FSplatTexturePage()
 		: PositionTextureData()
 		, ScaleTextureData()
 		, RotationTextureData()
@@ -58,37 +110,89 @@ struct FGaussianSplattingTextureData {
 		, harmonicsL2TextureData()
 		, harmonicsL31TextureData()
 		, harmonicsL32TextureData()
+		, FirstSplat(0)
+		, NumSplats(0)
+		, bFinished(false)
+	{
+	}
+};
+
+// Output textures of a model. A model with more texels than one texture can hold is split into pages of
+// consecutive splats, each with a full set of textures. Pages are created when conversion first reaches them.
+// With bStreamPages, conversion must visit the texels in order, and a page is saved as soon as conversion
+// moves past it, so only one page of locked mips is held at a time.
+struct FGaussianSplattingTextureData {
+	FString ModelFolderPath;
+	int32 SHDegree;
+	int32 SplatsPerPage;
+	// Texture precisions of the preprocess settings; the crop volumes are not kept
+	FGaussianSplatPreprocessSettings Settings;
+	bool bStreamPages;
+	// Set when a page cannot be created; conversion skips the rest of the model
+	bool bFailed;
+	// Bytes of the locked mips and staging buffers of the pages created and not saved yet, and the most held at once
+	int64 HeldTextureBytes;
+	int64 PeakHeldTextureBytes;
+	TArray<FSplatTexturePage> Pages;
+	TArray<FTextureLocations> PageLocations;
+
+	FGaussianSplattingTextureData()
+		: ModelFolderPath()
+		, SHDegree(0)
+		, SplatsPerPage(1)
+		, Settings()
+		, bStreamPages(false)
+		, bFailed(false)
+		, HeldTextureBytes(0)
+		, PeakHeldTextureBytes(0)
+		, Pages()
+		, PageLocations()
 	{
 	}
 };
 
 // ---------- Private Helper Functions ----------
 
-static FString CreateAndSaveTexture(
+// Texels a single output texture may hold, see UnrealSplat.MaxTextureDimension
+static int64 GetMaxTexelsPerTexture() {
+	const int32 Override = CVarSplatMaxTextureDimension.GetValueOnGameThread();
+	const int64 MaxDimension = Override > 0 ? Override : UTexture::GetMaximumDimensionOfNonVT();
+	return MaxDimension * MaxDimension;
+}
+
+// Splats per texture page at the current texture size limit
+static int32 GetSplatsPerPage(int32 SHDegree) {
+	return FSplatTexturePages::GetSplatsPerPage(SHDegree, GetMaxTexelsPerTexture());
+}
+
+// Creates a square-ish texture asset for NumPixels texels and locks its RGBA32F source mip for writing.
+// Textures of any other Format get an RGBA32F staging buffer instead, encoded into their source before saving.
+// Texels past NumPixels are zeroed; everything else is left for the caller to fill.
+static bool BeginTexture(
 	const FString& InPackagePath,
 	const FString& InTextureName,
-	int32 Width,
-	int32 Height,
-	TArray<FLinearColor>& InPixelData
+	int64 NumPixels,
+	ETextureSourceFormat Format,
+	FSplatTextureTarget& OutTarget
 	) {
-	
-	// --- 2. Determine Package and Asset Paths ---
+
+	int32 Width, Height;
+	FSplatTexturePages::GetTextureSize(NumPixels, Width, Height);
+
+	// --- Determine Package and Asset Paths ---
 	FString PackagePath = FPaths::Combine(FPackageName::FilenameToLongPackageName(InPackagePath), InTextureName);
-	// Ensure the package path ends with the asset name for proper asset naming conventions
-	// Example: /Game/MyTextures/MyGeneratedTexture.MyGeneratedTexture
-	FString FullAssetPath = PackagePath + "." + InTextureName;
 	UPackage* Package = CreatePackage(*PackagePath);
 	if (!Package)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to create package: %s"), *PackagePath);
-		return "";
+		return false;
 	}
 
 	UTexture2D* NewTexture = NewObject<UTexture2D>(Package, FName(*InTextureName), RF_Public | RF_Standalone | RF_MarkAsNative);
 	if (!NewTexture)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to create UTexture2D object: %s"), *InTextureName);
-		return "";
+		return false;
 	}
 
 	// Texture Properties
@@ -102,68 +206,148 @@ static FString CreateAndSaveTexture(
 	
 	// Persistent Texture is stored into Source
 
-	NewTexture->Source.Init(Width, Height, 1, 1, ETextureSourceFormat::TSF_RGBA32F);
-	void* MipData = NewTexture->Source.LockMip(0);
-	FMemory::Memcpy(MipData, InPixelData.GetData(), InPixelData.Num() * sizeof(FLinearColor));
-	NewTexture->Source.UnlockMip(0);
-
-	// Transient Texture
-
-	/*NewTexture->SetPlatformData(new FTexturePlatformData());
-	NewTexture->GetPlatformData()->SizeX = Width;
-	NewTexture->GetPlatformData()->SizeY = Height;
-	//NewTexture->GetPlatformData()->SetNumSlices(1);
-	NewTexture->GetPlatformData()->PixelFormat = EPixelFormat::PF_A32B32G32R32F;
-
-	// Mip Map Level 0
-	FTexture2DMipMap* Mip = new FTexture2DMipMap(Width, Height,1);
-	NewTexture->GetPlatformData()->Mips.Add(Mip);
-
-	// Allocate first mipmap.
+	const int64 NumTexels = int64(Width) * Height;
+	FLinearColor* Texels;
+	if (Format != TSF_RGBA32F)
+	{
+		OutTarget.Staging.SetNumUninitialized(NumTexels);
+		Texels = OutTarget.Staging.GetData();
+	}
+	else
+	{
+		NewTexture->Source.Init(Width, Height, 1, 1, ETextureSourceFormat::TSF_RGBA32F);
+		Texels = reinterpret_cast<FLinearColor*>(NewTexture->Source.LockMip(0));
+		OutTarget.bLocked = true;
+	}
+	FMemory::Memzero(Texels + NumPixels, SIZE_T(NumTexels - NumPixels) * sizeof(FLinearColor));
+
+	OutTarget.Texture = NewTexture;
+	OutTarget.Texels = Texels;
+	OutTarget.NumPixels = NumPixels;
+	OutTarget.Width = Width;
+	OutTarget.Height = Height;
+	OutTarget.Format = Format;
+	return true;
+}
 
-	// Bulk-Daten zum Schreiben sperren.
-	Mip->BulkData.Lock(LOCK_READ_WRITE);
+// Initializes the source of a staged texture in its own format and locks it for encoding.
+// Texels past NumPixels are zeroed.
+static uint8* LockTextureSource(FSplatTextureTarget& Target) {
+	FTextureSource& Source = Target.Texture->Source;
+	Source.Init(Target.Width, Target.Height, 1, 1, Target.Format);
+	uint8* Data = Source.LockMip(0);
+	const int64 BytesPerPixel = Source.GetBytesPerPixel();
+	FMemory::Memzero(Data + Target.NumPixels * BytesPerPixel, SIZE_T((int64(Target.Width) * Target.Height - Target.NumPixels) * BytesPerPixel));
+	Target.bLocked = true;
+	return Data;
+}
 
-	void* DestPixels = Mip->BulkData.Realloc(InPixelData.Num() * sizeof(FLinearColor));
+// Writes the staged texels of a half precision texture into its RGBA16F source
+static void EncodeHalfTexture(FSplatTextureTarget& Target) {
+	const FLinearColor Offset(0.0f, 0.0f, 0.0f, 0.0f);
+	const FLinearColor Scale(1.0f, 1.0f, 1.0f, 1.0f);
+	FFloat16Color* Dest = reinterpret_cast<FFloat16Color*>(LockTextureSource(Target));
+	const int32 NumPixels = int32(Target.NumPixels);
+	ParallelFor(FGaussianSplatBuffer::NumTasks(NumPixels), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 Num = FMath::Min(FGaussianSplatBuffer::RowsPerTask, NumPixels - Begin);
+		SplatKernels::EncodeHalf(Target.Texels + Begin, Num, Offset, Scale, Dest + Begin);
+	});
+}
 
+// ---------- Compact Encoding (see EGaussianSplatTexturePrecision::Compact) ----------
+
+// Source format of a texture stored with Precision, where CompactFormat is its compact form
+static ETextureSourceFormat GetTextureFormat(EGaussianSplatTexturePrecision Precision, ETextureSourceFormat CompactFormat) {
+	switch (Precision) {
+	case EGaussianSplatTexturePrecision::Half:
+		return TSF_RGBA16F;
+	case EGaussianSplatTexturePrecision::Compact:
+		return CompactFormat;
+	default:
+		return TSF_RGBA32F;
+	}
+}
 
-	// �berpr�fen, ob die Speicherzuweisung erfolgreich war.
+// Source formats of the textures written with the precisions of Settings
+struct FSplatTextureFormats {
+	ETextureSourceFormat Position;
+	ETextureSourceFormat Scale;
+	ETextureSourceFormat Rotation;
+	ETextureSourceFormat Color;
+	ETextureSourceFormat Harmonics;
+	// Whether a chunk range texture is written for compact positions, scales or colors
+	bool bChunkRanges;
+
+	explicit FSplatTextureFormats(const FGaussianSplatPreprocessSettings& Settings)
+		// Half precision positions would only be accurate relative to their page, which nothing undoes at runtime
+		: Position(Settings.PositionPrecision == EGaussianSplatTexturePrecision::Half ? TSF_RGBA32F : GetTextureFormat(Settings.PositionPrecision, TSF_BGRA8))
+		, Scale(GetTextureFormat(Settings.ScalePrecision, TSF_BGRA8))
+		, Rotation(GetTextureFormat(Settings.RotationPrecision, TSF_BGRA8))
+		, Color(GetTextureFormat(Settings.ColorPrecision, TSF_BGRA8))
+		// Harmonics have no compact form and fall back to half precision
+		, Harmonics(GetTextureFormat(Settings.HarmonicsPrecision, TSF_RGBA16F))
+		, bChunkRanges(Settings.PositionPrecision == EGaussianSplatTexturePrecision::Compact || Settings.ScalePrecision == EGaussianSplatTexturePrecision::Compact
+			|| Settings.ColorPrecision == EGaussianSplatTexturePrecision::Compact)
+	{
+	}
+};
 
-	// Daten in die Textur kopieren
-	FMemory::Memcpy(DestPixels, InPixelData.GetData(), InPixelData.Num() * sizeof(FLinearColor));
+// Unlocks a texture filled through BeginTexture, encoding it first if it has half precision, and saves it.
+// Compact textures must have been encoded by EncodeCompactPage already.
+// Returns the asset path, or "" on failure.
+static FString FinishTexture(FSplatTextureTarget& Target) {
+	UTexture2D* NewTexture = Target.Texture;
+	if (!NewTexture)
+	{
+		return "";
+	}
+	if (Target.Format == TSF_RGBA16F && !Target.bLocked)
+	{
+		EncodeHalfTexture(Target);
+	}
+	if (!ensure(Target.bLocked))
+	{
+		NewTexture->MarkAsGarbage();
+		Target = FSplatTextureTarget();
+		return "";
+	}
+	NewTexture->Source.UnlockMip(0);
+	Target = FSplatTextureTarget();
 
-	Mip -> BulkData.Unlock();
-	// Set Platform Meta Data of Texture*/
-	
 	NewTexture->UpdateResource();
 
 	NewTexture->PostEditChange();
 
 	// Saving to Disk
-	Package->MarkPackageDirty();
+	NewTexture->MarkPackageDirty();
 
-	//const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackagePath, FString(TEXT(".uasset")));
-
-	//bool bSuccess = UPackage::SavePackage(Package, NewTexture, EObjectFlags::RF_Public | EObjectFlags::RF_Standalone, *PackageFileName, GLog);
 	bool bSuccess = UEditorAssetLibrary::SaveLoadedAsset(NewTexture, true);
 	if (bSuccess)
 	{
-		UE_LOG(LogTemp, Log, TEXT("Successfully created and saved texture asset: %s"), *PackagePath);
+		UE_LOG(LogTemp, Log, TEXT("Successfully created and saved texture asset: %s"), *NewTexture->GetOutermost()->GetName());
 		return NewTexture->GetPathName();
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to save texture asset: %s"), *PackagePath);
+		UE_LOG(LogTemp, Error, TEXT("Failed to save texture asset: %s"), *NewTexture->GetOutermost()->GetName());
 		// Clean up partially created asset if save failed to prevent stale references.
 		NewTexture->MarkAsGarbage();
 		return "";
 	}
+}
 
-	// Notify Asset Registry
-	//FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	//AssetRegistryModule.Get().AssetCreated(NewTexture);
-	//UEditorAssetLibrary::SaveAsset(FullAssetPath, true);
-	//return PackagePath;
+// Drops a texture started with BeginTexture without saving it
+static void AbortTexture(FSplatTextureTarget& Target) {
+	if (Target.Texture)
+	{
+		if (Target.bLocked)
+		{
+			Target.Texture->Source.UnlockMip(0);
+		}
+		Target.Texture->MarkAsGarbage();
+	}
+	Target = FSplatTextureTarget();
 }
 
 static FString CreateDirectory(FString Path, bool bAllowOverwrite = true) {
@@ -253,375 +437,1252 @@ bool PopulateGaussianTexture(UTexture2D* Texture, const TArray<FLinearColor>& Da
 	return true;
 }
 
-// ---------- Public Class Functions ----------
-
-int UParser::Preprocess3DGSModel(FString FilePath, bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations) {
-	// ----- Prepare Parsing -----
-	// FilePath is relative to Content/ (e.g., "Splats/mymodel.ply")
-	FString AbsolutePath = FPaths::ProjectContentDir() + FilePath;
-	FString Output = "---- Parsing PLY File ----\n\n";
-	TMap<FString, float*> vertexData;
-	uint32_t numVertices = 0;
+// Creates and locks every texture of a page, with spherical harmonics up to TextureData.SHDegree
+static bool BeginTexturePage(FGaussianSplattingTextureData& TextureData, int32 PageIndex) {
+	FSplatTexturePage& Page = TextureData.Pages[PageIndex];
+	const FString& Path = TextureData.ModelFolderPath;
+	const int64 NumSplats = Page.NumSplats;
+	const FSplatTextureFormats Formats(TextureData.Settings);
+	const ETextureSourceFormat Harmonics = Formats.Harmonics;
+	bool bSuccess = BeginTexture(Path, FSplatTexturePages::GetPageTextureName(TEXT("positiontexture"), PageIndex), NumSplats,
+			Formats.Position, Page.PositionTextureData)
+		&& BeginTexture(Path, FSplatTexturePages::GetPageTextureName(TEXT("colortexture"), PageIndex), NumSplats,
+			Formats.Color, Page.ColorTextureData)
+		&& BeginTexture(Path, FSplatTexturePages::GetPageTextureName(TEXT("scaletexture"), PageIndex), NumSplats,
+			Formats.Scale, Page.ScaleTextureData)
+		&& BeginTexture(Path, FSplatTexturePages::GetPageTextureName(TEXT("rotationtexture"), PageIndex), NumSplats,
+			Formats.Rotation, Page.RotationTextureData);
+	if (bSuccess && TextureData.SHDegree >= 1) {
+		bSuccess = BeginTexture(Path, FSplatTexturePages::GetPageTextureName(TEXT("harmonicsl1texture"), PageIndex), NumSplats * 3, Harmonics, Page.harmonicsL1TextureData);
+	}
+	if (bSuccess && TextureData.SHDegree >= 2) {
+		bSuccess = BeginTexture(Path, FSplatTexturePages::GetPageTextureName(TEXT("harmonicsl2texture"), PageIndex), NumSplats * 5, Harmonics, Page.harmonicsL2TextureData);
+	}
+	if (bSuccess && TextureData.SHDegree >= 3) {
+		bSuccess = BeginTexture(Path, FSplatTexturePages::GetPageTextureName(TEXT("harmonicsl31texture"), PageIndex), NumSplats * 4, Harmonics, Page.harmonicsL31TextureData)
+			&& BeginTexture(Path, FSplatTexturePages::GetPageTextureName(TEXT("harmonicsl32texture"), PageIndex), NumSplats * 3, Harmonics, Page.harmonicsL32TextureData);
+	}
+	return bSuccess;
+}
 
-	// ----- Parsing -----
-	// -- TODO: Determine File Type --
-	// -- Check Validity --
-	miniply::PLYReader reader(TCHAR_TO_ANSI(*AbsolutePath));
+// Reorders the splats of a page along a Morton curve through their positions, in every texture of the page,
+// so that the chunks of the compact encoding cover small regions. Each texture is copied once to permute it.
+static void SortTexturePageByMorton(FSplatTexturePage& Page) {
+	const int32 NumSplats = Page.NumSplats;
+	TArray<int32> Order;
+	FSplatCompactEncoding::GetMortonOrder(Page.PositionTextureData.Texels, NumSplats, Order);
+
+	TArray64<FLinearColor> Copy;
+	auto Permute = [&](FSplatTextureTarget& Target, int32 TexelsPerSplat) {
+		if (!Target.Texels) {
+			return;
+		}
+		Copy.SetNumUninitialized(int64(NumSplats) * TexelsPerSplat, EAllowShrinking::No);
+		FMemory::Memcpy(Copy.GetData(), Target.Texels, Copy.Num() * sizeof(FLinearColor));
+		ParallelFor(FGaussianSplatBuffer::NumTasks(NumSplats), [&](int32 Task) {
+			const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+			const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumSplats);
+			for (int32 i = Begin; i < End; i++) {
+				FMemory::Memcpy(Target.Texels + int64(i) * TexelsPerSplat, Copy.GetData() + int64(Order[i]) * TexelsPerSplat,
+					TexelsPerSplat * sizeof(FLinearColor));
+			}
+		});
+	};
+	Permute(Page.PositionTextureData, 1);
+	Permute(Page.ScaleTextureData, 1);
+	Permute(Page.RotationTextureData, 1);
+	Permute(Page.ColorTextureData, 1);
+	Permute(Page.harmonicsL1TextureData, 3);
+	Permute(Page.harmonicsL2TextureData, 5);
+	Permute(Page.harmonicsL31TextureData, 4);
+	Permute(Page.harmonicsL32TextureData, 3);
+}
 
-	if (!reader.valid()) {
-		bOutSuccess = false;
-		OutputString = FString::Printf(TEXT("Parsing PLY failed - Not a valid PLY file - %s"), *AbsolutePath);
-		return -1;
+// Quantizes the compact textures of a page from their staged texels, chunk by chunk, and saves the chunk range
+// texture they are decoded with (see FSplatCompactEncoding). The quantized textures are left locked for FinishTexture.
+static void EncodeCompactPage(FGaussianSplattingTextureData& TextureData, int32 PageIndex, FTextureLocations& TextureLocations) {
+	FSplatTexturePage& Page = TextureData.Pages[PageIndex];
+	FSplatTextureTarget& Positions = Page.PositionTextureData;
+	FSplatTextureTarget& Scales = Page.ScaleTextureData;
+	FSplatTextureTarget& Rotations = Page.RotationTextureData;
+	FSplatTextureTarget& Colors = Page.ColorTextureData;
+	const bool bCompactPositions = TextureData.Settings.PositionPrecision == EGaussianSplatTexturePrecision::Compact;
+	const bool bCompactScales = TextureData.Settings.ScalePrecision == EGaussianSplatTexturePrecision::Compact;
+	const bool bCompactRotations = TextureData.Settings.RotationPrecision == EGaussianSplatTexturePrecision::Compact;
+	const bool bCompactColors = TextureData.Settings.ColorPrecision == EGaussianSplatTexturePrecision::Compact;
+	const bool bChunkRanges = FSplatTextureFormats(TextureData.Settings).bChunkRanges;
+	if (bChunkRanges) {
+		SortTexturePageByMorton(Page);
 	}
 
-	// -- Content Parsing --
-	FString HeaderLog = FString::Printf(TEXT("ply\nformat %s %d.%d\n"), ANSI_TO_TCHAR(kFileTypes[int(reader.file_type())]),
-		reader.version_major(), reader.version_minor());
-
-	for (; reader.has_element(); reader.next_element()) {
-		// - Element (Set of Vertices, Faces, etc.)
-		const miniply::PLYElement* elem = reader.element();
-		HeaderLog += FString::Printf(TEXT("element %s %u\n"), ANSI_TO_TCHAR(elem->name.c_str()), elem->count);
+	constexpr int32 ChunkSize = FSplatCompactEncoding::ChunkSize;
+	constexpr int32 RangeTexels = FSplatCompactEncoding::RangeTexelsPerChunk;
+	const int32 NumSplats = Page.NumSplats;
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumSplats, ChunkSize);
+	TArray<FLinearColor> ChunkRanges;
+	ChunkRanges.SetNumZeroed(bChunkRanges ? NumChunks * RangeTexels : 0);
+
+	FColor* PositionTexels = bCompactPositions ? reinterpret_cast<FColor*>(LockTextureSource(Positions)) : nullptr;
+	FColor* ScaleTexels = bCompactScales ? reinterpret_cast<FColor*>(LockTextureSource(Scales)) : nullptr;
+	FColor* RotationTexels = bCompactRotations ? reinterpret_cast<FColor*>(LockTextureSource(Rotations)) : nullptr;
+	FColor* ColorTexels = bCompactColors ? reinterpret_cast<FColor*>(LockTextureSource(Colors)) : nullptr;
+
+	// Range[0] and Range[1] of the chunk, and the values normalized into it
+	auto Normalize = [](TConstArrayView<FVector3f> Values, FLinearColor* Range, TArrayView<FVector3f> OutNormalized) {
+		FVector3f Min(MAX_flt), Max(-MAX_flt);
+		for (const FVector3f& Value : Values) {
+			Min = Min.ComponentMin(Value);
+			Max = Max.ComponentMax(Value);
+		}
+		Range[0] = FLinearColor(Min.X, Min.Y, Min.Z, 0.0f);
+		Range[1] = FLinearColor(Max.X, Max.Y, Max.Z, 0.0f);
+		const FVector3f Scale = FSplatCompactEncoding::GetNormalizationScale(Min, Max);
+		for (int32 i = 0; i < Values.Num(); i++) {
+			OutNormalized[i] = (Values[i] - Min) * Scale;
+		}
+	};
+
+	ParallelFor(NumChunks, [&](int32 Chunk) {
+		const int32 Begin = Chunk * ChunkSize;
+		const int32 End = FMath::Min(Begin + ChunkSize, NumSplats);
+		const int32 Num = End - Begin;
+		FLinearColor* Range = bChunkRanges ? ChunkRanges.GetData() + Chunk * RangeTexels : nullptr;
+		FVector3f Values[ChunkSize];
+		FVector3f Normalized[ChunkSize];
+
+		if (bCompactPositions) {
+			for (int32 i = Begin; i < End; i++) {
+				Values[i - Begin] = FVector3f(Positions.Texels[i].R, Positions.Texels[i].G, Positions.Texels[i].B);
+			}
+			Normalize(MakeArrayView(Values, Num), Range, MakeArrayView(Normalized, Num));
+			for (int32 i = Begin; i < End; i++) {
+				PositionTexels[i] = FColor(FSplatCompactEncoding::EncodeUnorm111110(Normalized[i - Begin]));
+			}
+		}
 
-		// - Read PLY Header
-		for (const miniply::PLYProperty& prop : elem->properties) {
-			if (prop.countType != miniply::PLYPropertyType::None) {
-				HeaderLog += FString::Printf(TEXT("property list %s %s %s\n"), ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.countType)]),
-					ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.type)]), ANSI_TO_TCHAR(prop.name.c_str()));
+		if (bCompactScales) {
+			for (int32 i = Begin; i < End; i++) {
+				const FLinearColor& Scale = Scales.Texels[i];
+				Values[i - Begin] = FVector3f(FMath::Loge(FMath::Max(Scale.R, UE_SMALL_NUMBER)), FMath::Loge(FMath::Max(Scale.G, UE_SMALL_NUMBER)),
+					FMath::Loge(FMath::Max(Scale.B, UE_SMALL_NUMBER)));
 			}
-			else {
-				HeaderLog += FString::Printf(TEXT("property %s %s\n"), ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.type)]), ANSI_TO_TCHAR(prop.name.c_str()));
+			Normalize(MakeArrayView(Values, Num), Range + 2, MakeArrayView(Normalized, Num));
+			for (int32 i = Begin; i < End; i++) {
+				ScaleTexels[i] = FColor(FSplatCompactEncoding::EncodeUnorm111110(Normalized[i - Begin]));
 			}
 		}
 
-		// - Extract Data from Vertices
-		if (reader.element_is(miniply::kPLYVertexElement) && reader.load_element()) {
-			numVertices = reader.num_rows();
-			uint32_t y = 0;
-			for (const miniply::PLYProperty& prop : elem->properties) {
-				uint32_t indexes[] = { y };
-				float* columnData = new float[numVertices];
-				reader.extract_properties(indexes, 1, miniply::PLYPropertyType::Float, columnData);
-				vertexData.Add(prop.name.c_str(), columnData);
-				y += 1;
+		if (bCompactRotations) {
+			for (int32 i = Begin; i < End; i++) {
+				const FLinearColor& Rotation = Rotations.Texels[i];
+				RotationTexels[i] = FColor(FSplatCompactEncoding::EncodeRotation(FQuat4f(Rotation.R, Rotation.G, Rotation.B, Rotation.A)));
 			}
 		}
-	}
 
-	HeaderLog += "end_header\n\n";
+		if (bCompactColors) {
+			for (int32 i = Begin; i < End; i++) {
+				Values[i - Begin] = FVector3f(Colors.Texels[i].R, Colors.Texels[i].G, Colors.Texels[i].B);
+			}
+			Normalize(MakeArrayView(Values, Num), Range + 4, MakeArrayView(Normalized, Num));
+			for (int32 i = Begin; i < End; i++) {
+				ColorTexels[i] = FSplatCompactEncoding::EncodeColor(Normalized[i - Begin], Colors.Texels[i].A);
+			}
+		}
+	});
 
-	// ---- Process Model Data ----
+	// The float texels are no longer needed once quantized
+	for (FSplatTextureTarget* Target : { &Positions, &Scales, &Rotations, &Colors }) {
+		if (Target->bLocked && Target->Format != TSF_RGBA32F) {
+			Target->Staging.Empty();
+			Target->Texels = nullptr;
+		}
+	}
 
-	// -- Check Model Validity --
-	bool PositionExists = vertexData.Contains("x") && vertexData.Contains("y") && vertexData.Contains("z");
-	bool OrientationExists = vertexData.Contains("rot_0") && vertexData.Contains("rot_1") && vertexData.Contains("rot_2") && vertexData.Contains("rot_3");
-	bool ScaleExists = vertexData.Contains("scale_0") && vertexData.Contains("scale_1") && vertexData.Contains("scale_2");
-	bool OpacityExists = vertexData.Contains("opacity");
-	bool ZeroOrderHarmonicsExists = vertexData.Contains("f_dc_0") && vertexData.Contains("f_dc_1") && vertexData.Contains("f_dc_2");;
-	bool higherOrderHarmonicsExists = true;
-	for (uint32_t y = 0; y < 45; y += 3) {
-		FString index = "f_rest_" + FString::FromInt(y);
-		if (!vertexData.Contains(index)) {
-			higherOrderHarmonicsExists = false;
-		}
-	}
-	if (!(PositionExists && OrientationExists && ScaleExists && OpacityExists && ZeroOrderHarmonicsExists)) {
-		return -1;
+	if (bChunkRanges) {
+		FSplatTextureTarget RangeTarget;
+		if (BeginTexture(TextureData.ModelFolderPath, FSplatTexturePages::GetPageTextureName(TEXT("chunkrangetexture"), PageIndex), ChunkRanges.Num(), TSF_RGBA32F, RangeTarget)) {
+			FMemory::Memcpy(RangeTarget.Texels, ChunkRanges.GetData(), ChunkRanges.Num() * sizeof(FLinearColor));
+			TextureLocations.ChunkRangeTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(RangeTarget)));
+		}
 	}
+}
 
-	// -- Calculate Bounding Boxes --
-	// Respect Unreal Engine Position Conversions for Position Values 100.0f * (x, -z, -y)
-	float min_x = vertexData["x"][0];
-	float min_y = -vertexData["z"][0];
-	float min_z = -vertexData["y"][0];
+// Bytes of the locked mips and staging buffers of the textures of a page, all RGBA32F until they are encoded
+static int64 GetHeldPageBytes(const FSplatTexturePage& Page) {
+	int64 Bytes = 0;
+	for (const FSplatTextureTarget* Target : { &Page.PositionTextureData, &Page.ScaleTextureData, &Page.RotationTextureData, &Page.ColorTextureData,
+		&Page.harmonicsL1TextureData, &Page.harmonicsL2TextureData, &Page.harmonicsL31TextureData, &Page.harmonicsL32TextureData }) {
+		if (Target->Texture) {
+			Bytes += int64(Target->Width) * Target->Height * int64(sizeof(FLinearColor));
+		}
+	}
+	return Bytes;
+}
 
-	float max_x = vertexData["x"][0];
-	float max_y = -vertexData["z"][0];
-	float max_z = -vertexData["y"][0];
+static void TrackHeldTextureBytes(FGaussianSplattingTextureData& TextureData, int64 Delta) {
+	TextureData.HeldTextureBytes += Delta;
+	TextureData.PeakHeldTextureBytes = FMath::Max(TextureData.PeakHeldTextureBytes, TextureData.HeldTextureBytes);
+}
 
-	for (uint32_t i = 0; i < numVertices; i++) {
-		if (vertexData["x"][i] < min_x) {
-			min_x = vertexData["x"][i];
-		}
-		else if (vertexData["x"][i] > max_x) {
-			max_x = vertexData["x"][i];
-		}
+// Saves the textures of a page started by BeginTexturePage and records where they went
+static void FinishTexturePage(FGaussianSplattingTextureData& TextureData, int32 PageIndex) {
+	FSplatTexturePage& Page = TextureData.Pages[PageIndex];
+	if (Page.bFinished || !Page.PositionTextureData.Texture) {
+		return;
+	}
+	const int64 HeldBytes = GetHeldPageBytes(Page);
+	FTextureLocations& TextureLocations = TextureData.PageLocations[PageIndex];
+	if (TextureData.Settings.PositionPrecision == EGaussianSplatTexturePrecision::Compact || TextureData.Settings.ScalePrecision == EGaussianSplatTexturePrecision::Compact
+		|| TextureData.Settings.RotationPrecision == EGaussianSplatTexturePrecision::Compact || TextureData.Settings.ColorPrecision == EGaussianSplatTexturePrecision::Compact) {
+		EncodeCompactPage(TextureData, PageIndex, TextureLocations);
+	}
+	TextureLocations.PositionTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(Page.PositionTextureData)));
+	TextureLocations.ColorTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(Page.ColorTextureData)));
+	TextureLocations.ScaleTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(Page.ScaleTextureData)));
+	TextureLocations.RotationTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(Page.RotationTextureData)));
+	if (Page.harmonicsL1TextureData.Texture) {
+		TextureLocations.HarmonicsL1TextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(Page.harmonicsL1TextureData)));
+	}
+	if (Page.harmonicsL2TextureData.Texture) {
+		TextureLocations.HarmonicsL2TextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(Page.harmonicsL2TextureData)));
+	}
+	if (Page.harmonicsL31TextureData.Texture) {
+		TextureLocations.HarmonicsL31TextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(Page.harmonicsL31TextureData)));
+		TextureLocations.HarmonicsL32TextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(FinishTexture(Page.harmonicsL32TextureData)));
+	}
+	TextureLocations.SHDegree = TextureData.SHDegree;
+	TextureLocations.FirstSplat = Page.FirstSplat;
+	TextureLocations.NumSplats = Page.NumSplats;
+	Page.bFinished = true;
+	TrackHeldTextureBytes(TextureData, -HeldBytes);
+}
 
-		if (-vertexData["z"][i] < min_y) {
-			min_y = -vertexData["z"][i];
-		}
-		else if (-vertexData["z"][i] > max_y) {
-			max_y = -vertexData["z"][i];
+// Page PageIndex of a model, created on first use. When streaming, the pages before it are saved first.
+// Returns nullptr, and sets bFailed, if the page cannot be created.
+static FSplatTexturePage* AcquireTexturePage(FGaussianSplattingTextureData& TextureData, int32 PageIndex) {
+	FSplatTexturePage& Page = TextureData.Pages[PageIndex];
+	if (TextureData.bFailed || Page.PositionTextureData.Texture) {
+		return TextureData.bFailed ? nullptr : &Page;
+	}
+	// A saved page written again means the texels were not visited in order
+	if (!ensure(!Page.bFinished)) {
+		TextureData.bFailed = true;
+		return nullptr;
+	}
+	if (TextureData.bStreamPages) {
+		for (int32 Earlier = 0; Earlier < PageIndex; Earlier++) {
+			FinishTexturePage(TextureData, Earlier);
 		}
+	}
+	const bool bBegun = BeginTexturePage(TextureData, PageIndex);
+	// Textures created before a failure are held until AbortSplatTextures as well
+	TrackHeldTextureBytes(TextureData, GetHeldPageBytes(Page));
+	if (!bBegun) {
+		TextureData.bFailed = true;
+		return nullptr;
+	}
+	return &Page;
+}
 
-		if (-vertexData["y"][i] < min_z) {
-			min_z = -vertexData["y"][i];
+// Lays out the output textures of a model with NumSplats splats and spherical harmonics up to SHDegree,
+// with the texture precisions of Settings.
+// Without bStreamPages every page is created here, for files that write each texel in several passes.
+// Otherwise only the first page is created here, so that a model that cannot be written fails before any splat is read.
+static bool BeginSplatTextures(const FString& ModelFolderPath, int32 NumSplats, int32 SHDegree, const FGaussianSplatPreprocessSettings& Settings,
+	FGaussianSplattingTextureData& TextureData, bool bStreamPages = true) {
+
+	TextureData.ModelFolderPath = ModelFolderPath;
+	TextureData.SHDegree = SHDegree;
+	TextureData.SplatsPerPage = GetSplatsPerPage(SHDegree);
+	TextureData.Settings = Settings;
+	TextureData.Settings.CropVolumes.Empty();
+	if (Settings.PositionPrecision == EGaussianSplatTexturePrecision::Half) {
+		UE_LOG(LogTemp, Warning, TEXT("Half precision positions are written in full precision"));
+	}
+	for (const EGaussianSplatTexturePrecision Precision : { Settings.PositionPrecision, Settings.ScalePrecision, Settings.RotationPrecision,
+		Settings.ColorPrecision, Settings.HarmonicsPrecision }) {
+		if (Precision == EGaussianSplatTexturePrecision::Compact) {
+			UE_LOG(LogTemp, Warning, TEXT("Compact textures are not decoded by the shipped Niagara systems; they need a material or system that includes SplatCompactDecode.ush"));
+			break;
 		}
-		else if (-vertexData["y"][i] > max_z) {
-			max_z = -vertexData["y"][i];
+	}
+	TextureData.bStreamPages = bStreamPages;
+	TextureData.bFailed = false;
+	TextureData.HeldTextureBytes = 0;
+	TextureData.PeakHeldTextureBytes = 0;
+
+	const TArray<FSplatPageRange> PageRanges = FSplatTexturePages::GetPages(NumSplats, TextureData.SplatsPerPage);
+	const int32 NumPages = PageRanges.Num();
+	TextureData.Pages.SetNum(NumPages);
+	TextureData.PageLocations.SetNum(NumPages);
+	for (int32 PageIndex = 0; PageIndex < NumPages; PageIndex++) {
+		TextureData.Pages[PageIndex].FirstSplat = PageRanges[PageIndex].FirstSplat;
+		TextureData.Pages[PageIndex].NumSplats = PageRanges[PageIndex].NumSplats;
+	}
+
+	for (int32 PageIndex = 0; PageIndex < (bStreamPages ? FMath::Min(NumPages, 1) : NumPages); PageIndex++) {
+		if (!AcquireTexturePage(TextureData, PageIndex)) {
+			return false;
 		}
 	}
+	return true;
+}
 
-	FVector BoundsMin = 100.0f * FVector(min_x, min_y, min_z);
-	FVector BoundsMax = 100.0f * FVector(max_x, max_y, max_z);
+// Size in bytes of the textures of one page with NumSplats splats, each in the format Settings gives it.
+// With bConverting, the RGBA32F staging buffer every texture in another format is converted into is added,
+// since it is held until the texture is encoded.
+static int64 EstimatePageTextureBytes(int64 NumSplats, int32 SHDegree, const FGaussianSplatPreprocessSettings& Settings, bool bConverting) {
+	const FSplatTextureFormats Formats(Settings);
+	auto TextureBytes = [bConverting](int64 NumPixels, ETextureSourceFormat Format) {
+		int32 Width, Height;
+		FSplatTexturePages::GetTextureSize(NumPixels, Width, Height);
+		const int64 Staging = bConverting && Format != TSF_RGBA32F ? int64(sizeof(FLinearColor)) : 0;
+		return int64(Width) * Height * (FTextureSource::GetBytesPerPixel(Format) + Staging);
+	};
+	int64 Bytes = TextureBytes(NumSplats, Formats.Position) + TextureBytes(NumSplats, Formats.Scale)
+		+ TextureBytes(NumSplats, Formats.Rotation) + TextureBytes(NumSplats, Formats.Color);
+	if (Formats.bChunkRanges) {
+		Bytes += TextureBytes(FMath::DivideAndRoundUp<int64>(NumSplats, FSplatCompactEncoding::ChunkSize) * FSplatCompactEncoding::RangeTexelsPerChunk, TSF_RGBA32F);
+		if (bConverting) {
+			// SortTexturePageByMorton: a 16 byte sort key and an index per splat, and a copy of the largest texture
+			Bytes += NumSplats * 20 + NumSplats * FSplatTexturePages::GetMaxTexelsPerSplat(SHDegree) * int64(sizeof(FLinearColor));
+		}
+	}
+	if (SHDegree >= 1) {
+		Bytes += TextureBytes(NumSplats * 3, Formats.Harmonics);
+	}
+	if (SHDegree >= 2) {
+		Bytes += TextureBytes(NumSplats * 5, Formats.Harmonics);
+	}
+	if (SHDegree >= 3) {
+		Bytes += TextureBytes(NumSplats * 4, Formats.Harmonics) + TextureBytes(NumSplats * 3, Formats.Harmonics);
+	}
+	return Bytes;
+}
 
-	// -- Create Folder Structure in Game --
-	// Output to same folder as input PLY (without .ply extension)
-	FString ModelFolderPath = FPaths::ProjectContentDir() + FPaths::GetPath(FilePath) / FPaths::GetBaseFilename(FilePath);
-	ModelFolderPath = CreateDirectory(ModelFolderPath);
+// Size in bytes of all the textures BeginSplatTextures creates for a model, as in EstimatePageTextureBytes
+static int64 EstimateSplatTextureBytes(int64 NumSplats, int32 SHDegree, const FGaussianSplatPreprocessSettings& Settings, bool bConverting) {
+	const int64 SplatsPerPage = GetSplatsPerPage(SHDegree);
+	int64 Bytes = 0;
+	for (int64 FirstSplat = 0; FirstSplat < NumSplats; FirstSplat += SplatsPerPage) {
+		Bytes += EstimatePageTextureBytes(FMath::Min(SplatsPerPage, NumSplats - FirstSplat), SHDegree, Settings, bConverting);
+	}
+	return Bytes;
+}
 
-	// Single texture data (no grid subdivision)
-	FGaussianSplattingTextureData TextureData;
+// Largest size in bytes of the locked texture mips and staging buffers held at once while converting into TextureData
+static int64 EstimateResidentTextureBytes(const FGaussianSplattingTextureData& TextureData) {
+	if (TextureData.Pages.Num() == 0) {
+		return 0;
+	}
+	if (TextureData.bStreamPages) {
+		return EstimatePageTextureBytes(TextureData.Pages[0].NumSplats, TextureData.SHDegree, TextureData.Settings, true);
+	}
+	return EstimateSplatTextureBytes(TextureData.Pages.Last().FirstSplat + TextureData.Pages.Last().NumSplats, TextureData.SHDegree,
+		TextureData.Settings, true);
+}
 
-	// Process splats
-	for (uint32_t i = 0; i < numVertices; i++) {
-		// Positions
-		FLinearColor PositionPixel = 100.0f * FLinearColor(vertexData["x"][i], -vertexData["z"][i], -vertexData["y"][i]);
-		TextureData.PositionTextureData.Add(PositionPixel);
+// Saves every page started by BeginSplatTextures and appends their locations, one entry per page
+static void FinishSplatTextures(FGaussianSplattingTextureData& TextureData, TArray<FTextureLocations>& TexLocations) {
+	for (int32 PageIndex = 0; PageIndex < TextureData.Pages.Num(); PageIndex++) {
+		FinishTexturePage(TextureData, PageIndex);
+	}
+	TexLocations.Append(TextureData.PageLocations);
+}
 
-		// Scales
-		FLinearColor ScalePixel = 100.0f * FLinearColor(FMath::Exp(vertexData["scale_0"][i]), FMath::Exp(vertexData["scale_2"][i]), FMath::Exp(vertexData["scale_1"][i]));
-		TextureData.ScaleTextureData.Add(ScalePixel);
+// Drops every page that has not been saved yet. Pages already saved while streaming stay on disk.
+static void AbortSplatTextures(FGaussianSplattingTextureData& TextureData) {
+	for (FSplatTexturePage& Page : TextureData.Pages) {
+		TrackHeldTextureBytes(TextureData, -GetHeldPageBytes(Page));
+		AbortTexture(Page.PositionTextureData);
+		AbortTexture(Page.ColorTextureData);
+		AbortTexture(Page.ScaleTextureData);
+		AbortTexture(Page.RotationTextureData);
+		AbortTexture(Page.harmonicsL1TextureData);
+		AbortTexture(Page.harmonicsL2TextureData);
+		AbortTexture(Page.harmonicsL31TextureData);
+		AbortTexture(Page.harmonicsL32TextureData);
+	}
+}
 
-		// Rotation
-		FQuat Rot = FQuat(vertexData["rot_1"][i], vertexData["rot_2"][i], vertexData["rot_3"][i], vertexData["rot_0"][i]);
-		Rot.Normalize();
-		FLinearColor RotationPixel = FLinearColor(Rot.X, -Rot.Z, -Rot.Y, Rot.W);
-		TextureData.RotationTextureData.Add(RotationPixel);
+// Runs miniply's parsing tasks (ASCII row chunks) on the task graph
+static void ParallelForPLY(uint32 NumTasks, const std::function<void(uint32)>& Task) {
+	ParallelFor(int32(NumTasks), [&Task](int32 Index) {
+		Task(uint32(Index));
+	});
+}
 
-		// BaseColor and Opacity
-		FVector ZeroOrderHarmonics = FVector(vertexData["f_dc_0"][i], vertexData["f_dc_1"][i], vertexData["f_dc_2"][i]);
-		FLinearColor BaseColor = FLinearColor(ZeroOrderHarmonics.X, ZeroOrderHarmonics.Y, ZeroOrderHarmonics.Z);
-		float Opacity = FMath::Clamp(1.0f / (1.0f + FMath::Exp(-vertexData["opacity"][i])), 0.0f, 1.0f);
-		FLinearColor ColorPixel = FLinearColor(BaseColor.R, BaseColor.G, BaseColor.B, Opacity);
-		TextureData.ColorTextureData.Add(ColorPixel);
+// Raw splat values of a batch, read from the SoA columns of an FGaussianSplatBuffer or FCompressedSplatDecoder
+struct FSplatColumnSource {
+	const float* Columns[FGaussianSplatBuffer::NumColumns];
+	int32 RestChannelStride;
 
-		// Higher Order Harmonics
-		if (higherOrderHarmonicsExists) {
-			// L1 - 3 Pixel per Gaussian
-			for (uint32_t y = 0; y < 9; y += 3) {
-				FString index1 = "f_rest_" + FString::FromInt(y);
-				FString index2 = "f_rest_" + FString::FromInt(y + 1);
-				FString index3 = "f_rest_" + FString::FromInt(y + 2);
-				TextureData.harmonicsL1TextureData.Add(FLinearColor(vertexData[index1][i], vertexData[index2][i], vertexData[index3][i]));
-			}
-			// L2 - 5 Pixel per Gaussian
-			for (uint32_t y = 9; y < 24; y += 3) {
-				FString index1 = "f_rest_" + FString::FromInt(y);
-				FString index2 = "f_rest_" + FString::FromInt(y + 1);
-				FString index3 = "f_rest_" + FString::FromInt(y + 2);
-				TextureData.harmonicsL2TextureData.Add(FLinearColor(vertexData[index1][i], vertexData[index2][i], vertexData[index3][i]));
-			}
-			// L3 - 7 Pixel per Gaussian (divided into 4 and 3)
-			for (uint32_t y = 24; y < 36; y += 3) {
-				FString index1 = "f_rest_" + FString::FromInt(y);
-				FString index2 = "f_rest_" + FString::FromInt(y + 1);
-				FString index3 = "f_rest_" + FString::FromInt(y + 2);
-				TextureData.harmonicsL31TextureData.Add(FLinearColor(vertexData[index1][i], vertexData[index2][i], vertexData[index3][i]));
-			}
-			for (uint32_t y = 36; y < 45; y += 3) {
-				FString index1 = "f_rest_" + FString::FromInt(y);
-				FString index2 = "f_rest_" + FString::FromInt(y + 1);
-				FString index3 = "f_rest_" + FString::FromInt(y + 2);
-				TextureData.harmonicsL32TextureData.Add(FLinearColor(vertexData[index1][i], vertexData[index2][i], vertexData[index3][i]));
-			}
+	template <typename BufferType>
+	explicit FSplatColumnSource(const BufferType& Splats)
+		: RestChannelStride(Splats.RestChannelStride())
+	{
+		for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+			Columns[Col] = Splats.Column(EGaussianSplatColumn(Col));
 		}
 	}
 
-	// Create and save textures directly to model folder (no Emitters subfolder)
-	FTextureLocations TextureLocations;
-
-	int numPixels = TextureData.PositionTextureData.Num();
-	if (numPixels <= 100) {
-		bOutSuccess = false;
-		OutputString = TEXT("Too few splats to process");
-		return numVertices;
-	}
-
-	float TextureWidth = ceil(sqrt(numPixels));
-	float TextureHeight = ceil(numPixels / TextureWidth);
+	FORCEINLINE float Get(int32 Column, int32 Row) const { return Columns[Column][Row]; }
 
-	FString PositionAssetPath = CreateAndSaveTexture(ModelFolderPath, "positiontexture", TextureWidth, TextureHeight, TextureData.PositionTextureData);
-	TextureLocations.PositionTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(PositionAssetPath));
-
-	FString ColorAssetPath = CreateAndSaveTexture(ModelFolderPath, "colortexture", TextureWidth, TextureHeight, TextureData.ColorTextureData);
-	TextureLocations.ColorTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(ColorAssetPath));
+	// Rows [Begin, Begin + Num) of a column; the SoA storage is already contiguous, so Scratch is unused
+	FORCEINLINE const float* Column(int32 Column, int32 Begin, int32 Num, float* Scratch) const { return Columns[Column] + Begin; }
+};
 
-	FString ScaleAssetPath = CreateAndSaveTexture(ModelFolderPath, "scaletexture", TextureWidth, TextureHeight, TextureData.ScaleTextureData);
-	TextureLocations.ScaleTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(ScaleAssetPath));
+// Raw splat values of a batch, read straight from PLY rows in the canonical INRIA layout.
+// Stride and field offsets are compile-time constants, so every read is a single unaligned load.
+struct FCanonicalRowSource {
+	static constexpr int32 RestChannelStride = FGaussianSplatBuffer::NumSHCoefficientsForDegree(3);
 
-	FString RotationAssetPath = CreateAndSaveTexture(ModelFolderPath, "rotationtexture", TextureWidth, TextureHeight, TextureData.RotationTextureData);
-	TextureLocations.RotationTextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(RotationAssetPath));
+	const uint8* Rows;
 
-	if (higherOrderHarmonicsExists) {
-		int numPixelsHL1 = TextureData.harmonicsL1TextureData.Num();
-		float harmonicsL1Width = ceil(sqrt(numPixelsHL1));
-		float harmonicsL1Height = ceil(numPixelsHL1 / harmonicsL1Width);
-		FString HarmonicsL1AssetPath = CreateAndSaveTexture(ModelFolderPath, "harmonicsl1texture", harmonicsL1Width, harmonicsL1Height, TextureData.harmonicsL1TextureData);
-		TextureLocations.HarmonicsL1TextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(HarmonicsL1AssetPath));
+	explicit FCanonicalRowSource(const uint8* InRows)
+		: Rows(InRows)
+	{
+	}
 
-		int numPixelsHL2 = TextureData.harmonicsL2TextureData.Num();
-		float harmonicsL2Width = ceil(sqrt(numPixelsHL2));
-		float harmonicsL2Height = ceil(numPixelsHL2 / harmonicsL2Width);
-		FString HarmonicsL2AssetPath = CreateAndSaveTexture(ModelFolderPath, "harmonicsl2texture", harmonicsL2Width, harmonicsL2Height, TextureData.harmonicsL2TextureData);
-		TextureLocations.HarmonicsL2TextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(HarmonicsL2AssetPath));
+	FORCEINLINE float Get(int32 Column, int32 Row) const {
+		return FPlatformMemory::ReadUnaligned<float>(Rows + SIZE_T(Row) * FGaussianSplatBuffer::CanonicalRowStride + Column * sizeof(float));
+	}
 
-		int numPixelsHL31 = TextureData.harmonicsL31TextureData.Num();
-		float harmonicsL3Width1 = ceil(sqrt(numPixelsHL31));
-		float harmonicsL3Height1 = ceil(numPixelsHL31 / harmonicsL3Width1);
-		FString HarmonicsL31AssetPath = CreateAndSaveTexture(ModelFolderPath, "harmonicsl31texture", harmonicsL3Width1, harmonicsL3Height1, TextureData.harmonicsL31TextureData);
-		TextureLocations.HarmonicsL31TextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(HarmonicsL31AssetPath));
+	// Gathers rows [Begin, Begin + Num) of a column into Scratch
+	FORCEINLINE const float* Column(int32 Column, int32 Begin, int32 Num, float* Scratch) const {
+		for (int32 i = 0; i < Num; i++) {
+			Scratch[i] = Get(Column, Begin + i);
+		}
+		return Scratch;
+	}
+};
 
-		int numPixelsHL32 = TextureData.harmonicsL32TextureData.Num();
-		float harmonicsL3Width2 = ceil(sqrt(numPixelsHL32));
-		float harmonicsL3Height2 = ceil(numPixelsHL32 / harmonicsL3Width2);
-		FString HarmonicsL32AssetPath = CreateAndSaveTexture(ModelFolderPath, "harmonicsl32texture", harmonicsL3Width2, harmonicsL3Height2, TextureData.harmonicsL32TextureData);
-		TextureLocations.HarmonicsL32TextureLocation = TSoftObjectPtr<UTexture2D>(FSoftObjectPath(HarmonicsL32AssetPath));
+// The rows of a batch that survive cropping, presented as a batch of their own
+template <typename SourceType>
+struct FCroppedSource {
+	const SourceType& Source;
+	const int32* Rows;
+	int32 RestChannelStride;
+
+	FCroppedSource(const SourceType& InSource, const int32* InRows)
+		: Source(InSource)
+		, Rows(InRows)
+		, RestChannelStride(InSource.RestChannelStride)
+	{
 	}
 
-	TexLocations.Add(TextureLocations);
+	FORCEINLINE float Get(int32 Column, int32 Row) const { return Source.Get(Column, Rows[Row]); }
 
-	bOutSuccess = true;
-	Output += FString::Printf(TEXT("Successfully parsed PLY File - %s\n\n-- PLY Header --\n\n"), *AbsolutePath);
-	Output += HeaderLog;
-	Output += "-- End of PLY Header --\n\n";
-	Output += "-- PLY Body --\n\n";
-	Output += "-- End of PLY Body --\n\n";
-	Output += "";
-	Output += "---- Finished Parsing PLY File ----";
-	OutputString = Output;
+	// Gathers rows [Begin, Begin + Num) of a column into Scratch
+	FORCEINLINE const float* Column(int32 Column, int32 Begin, int32 Num, float* Scratch) const {
+		for (int32 i = 0; i < Num; i++) {
+			Scratch[i] = Get(Column, Begin + i);
+		}
+		return Scratch;
+	}
+};
 
-	return numVertices;
-}
+// Crop result of a whole file, computed in a position-only pass and then consumed batch by batch
+// while converting, so that the kept splats fill the texels consecutively
+struct FSplatCropPass {
+	// One flag per splat of the file; empty if nothing is cropped
+	TArray<bool> Keep;
+	int32 NumKept = 0;
 
-FGaussianSplatData UParser::ParseFilePLY(FString FilePath, bool& bOutSuccess, FString& OutputString) {
+	bool IsActive() const { return Keep.Num() > 0; }
 
-	// ---- Preparation ----
-	// FilePath is relative to Content/ (e.g., "Splats/mymodel.ply")
-	FString AbsolutePath = FPaths::ProjectContentDir() + FilePath;
-	FString Output = "---- Parsing PLY File ----\n\n";
-	TMap<FString, float*> vertexData;
-	uint32_t numVertices = 0;
-	FGaussianSplatData SplatData;
+	// Starts writing at the first texel again, for files that store a splat's attributes in several elements
+	void Restart() { NumWritten = 0; }
 
-	// ---- PLY Parsing ----
-	
-	miniply::PLYReader reader(TCHAR_TO_ANSI(*AbsolutePath));
-	
-	if (!reader.valid()) {
-		bOutSuccess = false;
-		OutputString = FString::Printf(TEXT("Parsing PLY failed - Not a valid PLY file - %s"), *AbsolutePath);
-		return SplatData;
+	// Calls Convert(BatchSource, NumSplats, FirstTexel) with the kept rows of a batch of NumRows splats
+	template <typename SourceType, typename ConvertType>
+	void ConvertBatch(const SourceType& Source, int32 FirstRow, int32 NumRows, ConvertType&& Convert) {
+		if (!IsActive()) {
+			Convert(Source, NumRows, FirstRow);
+			return;
+		}
+		Rows.Reset();
+		for (int32 i = 0; i < NumRows; i++) {
+			if (Keep[FirstRow + i]) {
+				Rows.Add(i);
+			}
+		}
+		if (Rows.Num() > 0) {
+			Convert(FCroppedSource<SourceType>(Source, Rows.GetData()), Rows.Num(), NumWritten);
+			NumWritten += Rows.Num();
+		}
 	}
-	
-	FString HeaderLog = FString::Printf(TEXT("ply\nformat %s %d.%d\n"), ANSI_TO_TCHAR(kFileTypes[int(reader.file_type())]),
-		reader.version_major(), reader.version_minor());
 
-	// -- Content Parsing --
+private:
+	TArray<int32> Rows;
+	int32 NumWritten = 0;
+};
 
-	for (; reader.has_element() ;reader.next_element()) {
-		// - Element (Set of Vertices, Faces, etc.)
-		const miniply::PLYElement* elem = reader.element();
-		HeaderLog += FString::Printf(TEXT("element %s %u\n"), ANSI_TO_TCHAR(elem->name.c_str()), elem->count);
+// RGB value of spherical harmonics coefficient Coefficient (0 = first coefficient of band 1) of a splat.
+// The file stores each channel's coefficients contiguously, so the channels are RestChannelStride apart.
+template <typename SourceType>
+FORCEINLINE static FLinearColor GetSHCoefficient(const SourceType& Source, int32 Coefficient, int32 Row) {
+	constexpr int32 Rest0 = int32(EGaussianSplatColumn::Rest0);
+	return FLinearColor(
+		Source.Get(Rest0 + Coefficient, Row),
+		Source.Get(Rest0 + Source.RestChannelStride + Coefficient, Row),
+		Source.Get(Rest0 + 2 * Source.RestChannelStride + Coefficient, Row));
+}
 
-		// - Read PLY Header
-		for (const miniply::PLYProperty& prop : elem->properties) {
-			if (prop.countType != miniply::PLYPropertyType::None) {
-				HeaderLog += FString::Printf(TEXT("property list %s %s %s\n"), ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.countType)]),
-					ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.type)]), ANSI_TO_TCHAR(prop.name.c_str()));
+// Writes the higher order harmonics up to SHDegree of splats [Begin, End) of Source, one RGB pixel per coefficient.
+// Splat i goes to texel FirstSplat + i of the page; FirstSplat is negative when the batch started on an earlier page.
+template <int32 SHDegree, typename SourceType>
+static void ConvertHarmonicsRange(const SourceType& Source, int32 Begin, int32 End, int32 FirstSplat, FSplatTexturePage& Page) {
+	for (int32 i = Begin; i < End; i++) {
+		if constexpr (SHDegree >= 1) {
+			// L1 - 3 Pixel per Gaussian
+			FLinearColor* L1 = Page.harmonicsL1TextureData.Texels + int64(FirstSplat + i) * 3;
+			for (int32 y = 0; y < 3; y++) {
+				*L1++ = GetSHCoefficient(Source, y, i);
 			}
-			else {
-				HeaderLog += FString::Printf(TEXT("property %s %s\n"), ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.type)]), ANSI_TO_TCHAR(prop.name.c_str()));
+		}
+		if constexpr (SHDegree >= 2) {
+			// L2 - 5 Pixel per Gaussian
+			FLinearColor* L2 = Page.harmonicsL2TextureData.Texels + int64(FirstSplat + i) * 5;
+			for (int32 y = 3; y < 8; y++) {
+				*L2++ = GetSHCoefficient(Source, y, i);
 			}
 		}
-
-		// - Extract Data from Vertices
-		if (reader.element_is(miniply::kPLYVertexElement) && reader.load_element()) {
-			numVertices = reader.num_rows();
-			uint32_t y = 0;
-			HeaderLog += "Props Read for Vertices\n";
-			for (const miniply::PLYProperty& prop : elem->properties) {
-				HeaderLog += FString::Printf(TEXT("Property: %s "), ANSI_TO_TCHAR(prop.name.c_str()));
-				// Hier was falsch?
-				uint32_t indexes[] = { y };
-				float* columnData = new float[numVertices];
-				reader.extract_properties(indexes, 1, miniply::PLYPropertyType::Float, columnData);
-				vertexData.Add(prop.name.c_str(), columnData);
-				y += 1;
+		if constexpr (SHDegree >= 3) {
+			// L3 - 7 Pixel per Gaussian (divided into 4 and 3)
+			FLinearColor* L31 = Page.harmonicsL31TextureData.Texels + int64(FirstSplat + i) * 4;
+			for (int32 y = 8; y < 12; y++) {
+				*L31++ = GetSHCoefficient(Source, y, i);
+			}
+			FLinearColor* L32 = Page.harmonicsL32TextureData.Texels + int64(FirstSplat + i) * 3;
+			for (int32 y = 12; y < 15; y++) {
+				*L32++ = GetSHCoefficient(Source, y, i);
 			}
 		}
 	}
+}
 
-	// Only for debugging: Print Values
-	uint32_t max_debug_vertices = 10;
-	for (auto& Elem : vertexData) {
-		uint32_t x = 0;
-		HeaderLog += Elem.Key + "\n";
-		for (uint32_t n = 0; n < numVertices; n++) {
-			if (x >= max_debug_vertices) {
-				break;
-			}
-			HeaderLog += FString::FromInt(int(Elem.Value[n])) + " ";
-			x++;
+// Splats converted per SplatKernels call. Small enough for the gathered columns to stay in L1.
+static constexpr int32 KernelChunkSize = 256;
+
+// Converts splats [Begin, End) of Source into the textures of a page, spherical harmonics up to SHDegree.
+// Splat i goes to texel FirstSplat + i of the page, as in ConvertHarmonicsRange.
+template <int32 SHDegree, typename SourceType>
+static void ConvertSplatRange(const SourceType& Source, int32 Begin, int32 End, int32 FirstSplat,
+	FSplatTexturePage& Page, FVector3f& OutMin, FVector3f& OutMax) {
+
+	constexpr int32 X = int32(EGaussianSplatColumn::X);
+	constexpr int32 Y = int32(EGaussianSplatColumn::Y);
+	constexpr int32 Z = int32(EGaussianSplatColumn::Z);
+	constexpr int32 DC0 = int32(EGaussianSplatColumn::DC0);
+	constexpr int32 Opacity = int32(EGaussianSplatColumn::Opacity);
+	constexpr int32 Scale0 = int32(EGaussianSplatColumn::Scale0);
+	constexpr int32 Rot0 = int32(EGaussianSplatColumn::Rot0);
+
+	FLinearColor* Positions = Page.PositionTextureData.Texels;
+	FLinearColor* Scales = Page.ScaleTextureData.Texels;
+	FLinearColor* Rotations = Page.RotationTextureData.Texels;
+	FLinearColor* Colors = Page.ColorTextureData.Texels;
+
+	FVector3f Min(Source.Get(X, Begin), -Source.Get(Z, Begin), -Source.Get(Y, Begin));
+	FVector3f Max = Min;
+	float Scratch[4][KernelChunkSize];
+	for (int32 Chunk = Begin; Chunk < End; Chunk += KernelChunkSize) {
+		const int32 Num = FMath::Min(KernelChunkSize, End - Chunk);
+
+		// Positions - Respect Unreal Engine Position Conversions 100.0f * (x, -z, -y)
+		const float* PosX = Source.Column(X, Chunk, Num, Scratch[0]);
+		const float* PosY = Source.Column(Y, Chunk, Num, Scratch[1]);
+		const float* PosZ = Source.Column(Z, Chunk, Num, Scratch[2]);
+		SplatKernels::ConvertPositions(PosX, PosY, PosZ, Num, Positions + (FirstSplat + Chunk));
+		for (int32 i = 0; i < Num; i++) {
+			const FVector3f Position(PosX[i], -PosZ[i], -PosY[i]);
+			Min = Min.ComponentMin(Position);
+			Max = Max.ComponentMax(Position);
 		}
-		HeaderLog += "\n";
-	}
 
-	HeaderLog += "end_header\n\n";
+		// Scales
+		SplatKernels::ConvertScales(
+			Source.Column(Scale0, Chunk, Num, Scratch[0]),
+			Source.Column(Scale0 + 1, Chunk, Num, Scratch[1]),
+			Source.Column(Scale0 + 2, Chunk, Num, Scratch[2]),
+			Num, Scales + (FirstSplat + Chunk));
 
-	// ---- Conversion to Unreal's TArray Representation ----
-	
-	// TODO: Add Error handling for other ply formats: This code assumes all these properties exist.
-	// TODO: Maybe I can delete this loop for performance.
-	bool PositionExists = vertexData.Contains("x") && vertexData.Contains("y") && vertexData.Contains("z");
-	bool NormalExists = vertexData.Contains("nx") && vertexData.Contains("ny") && vertexData.Contains("nz");
-	bool OrientationExists = vertexData.Contains("rot_0") && vertexData.Contains("rot_1") && vertexData.Contains("rot_2") && vertexData.Contains("rot_3");
-	bool ScaleExists = vertexData.Contains("scale_0") && vertexData.Contains("scale_1") && vertexData.Contains("scale_2");
-	bool OpacityExists = vertexData.Contains("opacity");
-	bool ZeroOrderHarmonicsExists= vertexData.Contains("f_dc_0") && vertexData.Contains("f_dc_1") && vertexData.Contains("f_dc_2");;
-	bool higherOrderHarmonicsExists = true;
-	for (uint32_t y = 0; y < 45; y += 3) {
-		FString index = "f_rest_" + FString::FromInt(y);
-		if (!vertexData.Contains(index)) {
-			higherOrderHarmonicsExists = false;
-		}
+		// Rotation
+		SplatKernels::ConvertRotations(
+			Source.Column(Rot0, Chunk, Num, Scratch[0]),
+			Source.Column(Rot0 + 1, Chunk, Num, Scratch[1]),
+			Source.Column(Rot0 + 2, Chunk, Num, Scratch[2]),
+			Source.Column(Rot0 + 3, Chunk, Num, Scratch[3]),
+			Num, Rotations + (FirstSplat + Chunk));
+
+		// BaseColor and Opacity
+		SplatKernels::ConvertColors(
+			Source.Column(DC0, Chunk, Num, Scratch[0]),
+			Source.Column(DC0 + 1, Chunk, Num, Scratch[1]),
+			Source.Column(DC0 + 2, Chunk, Num, Scratch[2]),
+			Source.Column(Opacity, Chunk, Num, Scratch[3]),
+			Num, Colors + (FirstSplat + Chunk));
+
+		// Higher Order Harmonics
+		ConvertHarmonicsRange<SHDegree>(Source, Chunk, Chunk + Num, FirstSplat, Page);
 	}
+	OutMin = Min;
+	OutMax = Max;
+}
 
-	for (uint32_t i = 0; i < numVertices; i++) {
-		if (PositionExists) {
-			SplatData.Positions.Add(100.0f*FVector(vertexData["x"][i], -vertexData["z"][i], -vertexData["y"][i]));
-		}
-		if (NormalExists) {
-			SplatData.Normals.Add(FVector(vertexData["nx"][i], vertexData["ny"][i], vertexData["nz"][i]));
+// Calls Convert(Page, RowBegin, RowEnd, PageFirstSplat) for every texture page that a batch of NumSplats splats,
+// starting at texel FirstSplat of the model, falls into. Rows [RowBegin, RowEnd) of the batch belong to the page,
+// and row i goes to texel PageFirstSplat + i of it.
+template <typename ConvertType>
+static void ForEachTexturePage(FGaussianSplattingTextureData& TextureData, int32 NumSplats, int32 FirstSplat, ConvertType&& Convert) {
+	if (NumSplats <= 0) {
+		return;
+	}
+	const int32 FirstPage = FirstSplat / TextureData.SplatsPerPage;
+	const int32 LastPage = (FirstSplat + NumSplats - 1) / TextureData.SplatsPerPage;
+	for (int32 PageIndex = FirstPage; PageIndex <= LastPage; PageIndex++) {
+		FSplatTexturePage* Page = AcquireTexturePage(TextureData, PageIndex);
+		if (!Page) {
+			return;
 		}
-		if (OrientationExists) {
-			FQuat Rot = FQuat(vertexData["rot_1"][i], vertexData["rot_2"][i], vertexData["rot_3"][i], vertexData["rot_0"][i]); // Normalize Quaternion
-			Rot.Normalize();
-			FQuat Rot2 = FQuat(Rot.X, -Rot.Z, -Rot.Y, Rot.W);
-			SplatData.Orientations.Add(Rot2);
+		const int32 RowBegin = FMath::Max(Page->FirstSplat - FirstSplat, 0);
+		const int32 RowEnd = FMath::Min(Page->FirstSplat + Page->NumSplats - FirstSplat, NumSplats);
+		Convert(*Page, RowBegin, RowEnd, FirstSplat - Page->FirstSplat);
+	}
+}
+
+// Converts a batch of NumSplats raw splats into the locked output textures, starting at texel FirstSplat,
+// and grows InOutMin/InOutMax by the batch's (Unreal space, unscaled) positions
+template <typename SourceType>
+static void ConvertSplatBatch(const SourceType& Source, int32 NumSplats, int32 FirstSplat, int32 SHDegree,
+	FGaussianSplattingTextureData& TextureData, FVector3f& InOutMin, FVector3f& InOutMax) {
+
+	ForEachTexturePage(TextureData, NumSplats, FirstSplat, [&](FSplatTexturePage& Page, int32 RowBegin, int32 RowEnd, int32 PageFirstSplat) {
+		// Every task reduces the bounds of its own row range; min/max are exact, so the merged
+		// result does not depend on how the rows were split.
+		const int32 NumTasks = FGaussianSplatBuffer::NumTasks(RowEnd - RowBegin);
+		TArray<FVector3f, TInlineAllocator<8>> TaskMin;
+		TArray<FVector3f, TInlineAllocator<8>> TaskMax;
+		TaskMin.SetNumUninitialized(NumTasks);
+		TaskMax.SetNumUninitialized(NumTasks);
+
+		ParallelFor(NumTasks, [&](int32 Task) {
+			const int32 Begin = RowBegin + Task * FGaussianSplatBuffer::RowsPerTask;
+			const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, RowEnd);
+			switch (SHDegree) {
+			case 0: ConvertSplatRange<0>(Source, Begin, End, PageFirstSplat, Page, TaskMin[Task], TaskMax[Task]); break;
+			case 1: ConvertSplatRange<1>(Source, Begin, End, PageFirstSplat, Page, TaskMin[Task], TaskMax[Task]); break;
+			case 2: ConvertSplatRange<2>(Source, Begin, End, PageFirstSplat, Page, TaskMin[Task], TaskMax[Task]); break;
+			default: ConvertSplatRange<3>(Source, Begin, End, PageFirstSplat, Page, TaskMin[Task], TaskMax[Task]); break;
+			}
+		});
+
+		for (int32 Task = 0; Task < NumTasks; Task++) {
+			InOutMin = InOutMin.ComponentMin(TaskMin[Task]);
+			InOutMax = InOutMax.ComponentMax(TaskMax[Task]);
+		}
+	});
+}
+
+// Writes only the higher order harmonics of a batch, for files that store them apart from the other splat data
+template <typename SourceType>
+static void ConvertHarmonicsBatch(const SourceType& Source, int32 NumSplats, int32 FirstSplat, int32 SHDegree, FGaussianSplattingTextureData& TextureData) {
+	ForEachTexturePage(TextureData, NumSplats, FirstSplat, [&](FSplatTexturePage& Page, int32 RowBegin, int32 RowEnd, int32 PageFirstSplat) {
+		ParallelFor(FGaussianSplatBuffer::NumTasks(RowEnd - RowBegin), [&](int32 Task) {
+			const int32 Begin = RowBegin + Task * FGaussianSplatBuffer::RowsPerTask;
+			const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, RowEnd);
+			switch (SHDegree) {
+			case 0: break;
+			case 1: ConvertHarmonicsRange<1>(Source, Begin, End, PageFirstSplat, Page); break;
+			case 2: ConvertHarmonicsRange<2>(Source, Begin, End, PageFirstSplat, Page); break;
+			default: ConvertHarmonicsRange<3>(Source, Begin, End, PageFirstSplat, Page); break;
+			}
+		});
+	});
+}
+
+// Converts one batch of raw splats into the float arrays of Cloud, starting at index FirstSplat
+static void ConvertSplatBatch(const FGaussianSplatBuffer& Splats, int32 FirstSplat, UGaussianSplatCloud& Cloud) {
+	const float* PosX = Splats.Column(EGaussianSplatColumn::X);
+	const float* PosY = Splats.Column(EGaussianSplatColumn::Y);
+	const float* PosZ = Splats.Column(EGaussianSplatColumn::Z);
+	const float* NormX = Splats.Column(EGaussianSplatColumn::NX);
+	const float* NormY = Splats.Column(EGaussianSplatColumn::NY);
+	const float* NormZ = Splats.Column(EGaussianSplatColumn::NZ);
+	const float* Scale0 = Splats.Column(EGaussianSplatColumn::Scale0);
+	const float* Scale1 = Splats.Column(EGaussianSplatColumn::Scale1);
+	const float* Scale2 = Splats.Column(EGaussianSplatColumn::Scale2);
+	const float* Rot0 = Splats.Column(EGaussianSplatColumn::Rot0);
+	const float* Rot1 = Splats.Column(EGaussianSplatColumn::Rot1);
+	const float* Rot2 = Splats.Column(EGaussianSplatColumn::Rot2);
+	const float* Rot3 = Splats.Column(EGaussianSplatColumn::Rot3);
+	const float* DC0 = Splats.Column(EGaussianSplatColumn::DC0);
+	const float* DC1 = Splats.Column(EGaussianSplatColumn::DC1);
+	const float* DC2 = Splats.Column(EGaussianSplatColumn::DC2);
+	const float* OpacityColumn = Splats.Column(EGaussianSplatColumn::Opacity);
+	const float* Rest[FGaussianSplatBuffer::NumRestCoefficients];
+	for (int32 y = 0; y < FGaussianSplatBuffer::NumRestCoefficients; y++) {
+		Rest[y] = Splats.RestColumn(y);
+	}
+	const int32 RestStride = Splats.RestChannelStride();
+	const int32 NumCoefficients = Cloud.GetNumSHCoefficients();
+
+	// Attributes the file does not have are empty views
+	TArrayView<FVector3f> Positions = Cloud.GetPositions();
+	TArrayView<FVector3f> Normals = Cloud.GetNormals();
+	TArrayView<FQuat4f> Orientations = Cloud.GetOrientations();
+	TArrayView<FVector3f> Scales = Cloud.GetScales();
+	TArrayView<float> Opacities = Cloud.GetOpacities();
+	TArrayView<FVector3f> ZeroOrderHarmonics = Cloud.GetZeroOrderHarmonicsArray();
+	float* HigherOrderHarmonics = Cloud.GetHigherOrderHarmonicsArray().GetData();
+
+	const int32 NumSplats = Splats.Num();
+	ParallelFor(FGaussianSplatBuffer::NumTasks(NumSplats), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumSplats);
+		for (int32 i = Begin; i < End; i++) {
+			const int32 Out = FirstSplat + i;
+			if (Positions.Num() > 0) {
+				Positions[Out] = 100.0f*FVector3f(PosX[i], -PosZ[i], -PosY[i]);
+			}
+			if (Normals.Num() > 0) {
+				Normals[Out] = FVector3f(NormX[i], NormY[i], NormZ[i]);
+			}
+			if (Orientations.Num() > 0) {
+				FQuat4f Rot = FQuat4f(Rot1[i], Rot2[i], Rot3[i], Rot0[i]); // Normalize Quaternion
+				Rot.Normalize();
+				Orientations[Out] = FQuat4f(Rot.X, -Rot.Z, -Rot.Y, Rot.W);
+			}
+			if (Scales.Num() > 0) {
+				Scales[Out] = 100.0f*FVector3f(FMath::Exp(Scale0[i]), FMath::Exp(Scale2[i]), FMath::Exp(Scale1[i])); // Apply Exponential Function
+			}
+			if (Opacities.Num() > 0) {
+				Opacities[Out] = FMath::Clamp(1.0f / (1.0f + FMath::Exp(-OpacityColumn[i])), 0.0f, 1.0f); // Apply Sigmoid Function
+			}
+			if (ZeroOrderHarmonics.Num() > 0) {
+				ZeroOrderHarmonics[Out] = FVector3f(DC0[i], DC1[i], DC2[i]);
+			}
+			// Channel-major in the file, RGB triplets per coefficient in the cloud
+			float* Coefficients = HigherOrderHarmonics + SIZE_T(Out) * NumCoefficients * 3;
+			for (int32 y = 0; y < NumCoefficients; y++) {
+				*Coefficients++ = Rest[y][i];
+				*Coefficients++ = Rest[RestStride + y][i];
+				*Coefficients++ = Rest[2 * RestStride + y][i];
+			}
+		}
+	});
+}
+
+// Saves the textures of a successful preprocessing job and returns the rest of its log
+static FString FinishPreprocess(const FString& AbsolutePath, const TCHAR* FormatName, const FString& HeaderLog, const FString& MemoryLog,
+	FGaussianSplattingTextureData& TextureData, TArray<FTextureLocations>& TexLocations) {
+
+	// Save textures directly to model folder (no Emitters subfolder), one FTextureLocations per page
+	FinishSplatTextures(TextureData, TexLocations);
+
+	FString Output;
+	Output += FString::Printf(TEXT("Successfully parsed %s File - %s\n\n-- %s Header --\n\n"), FormatName, *AbsolutePath, FormatName);
+	Output += HeaderLog;
+	Output += FString::Printf(TEXT("-- End of %s Header --\n\n"), FormatName);
+	Output += FString::Printf(TEXT("-- %s Body --\n\n"), FormatName);
+	Output += MemoryLog + "\n";
+	if (TextureData.Pages.Num() > 1) {
+		Output += FString::Printf(TEXT("Texture pages: %d of up to %d splats\n"), TextureData.Pages.Num(), TextureData.SplatsPerPage);
+	}
+	Output += FString::Printf(TEXT("-- End of %s Body --\n\n"), FormatName);
+	Output += FString::Printf(TEXT("---- Finished Parsing %s File ----"), FormatName);
+	return Output;
+}
+
+// Position-only pass over the vertex element of a PLY file, plain or compressed, that evaluates the crop volumes
+// for every splat. Run before the textures are created, so they can be sized for the kept splats.
+static bool CropPLYFile(const FString& AbsolutePath, const FSplatCropFilter& Filter, FSplatCropPass& Crop) {
+	miniply::PLYReader reader(TCHAR_TO_ANSI(*AbsolutePath), true);
+	reader.set_parallel_for(&ParallelForPLY);
+	if (!reader.valid()) {
+		return false;
+	}
+
+	FSplatArena Arena;
+	const bool bCompressed = FCompressedSplatDecoder::IsCompressedLayout(reader);
+	FCompressedSplatDecoder Compressed;
+	FGaussianSplatBuffer Splats;
+	for (; reader.has_element(); reader.next_element()) {
+		if (bCompressed && reader.element_is("chunk")) {
+			if (!Compressed.LoadChunks(reader)) {
+				return false;
+			}
+			continue;
+		}
+		if (!reader.element_is(miniply::kPLYVertexElement)) {
+			continue;
+		}
+
+		const uint32_t count = reader.element()->count;
+		if (count > uint32_t(MAX_int32)) {
+			return false;
+		}
+		Crop.Keep.SetNumUninitialized(int32(count));
+		Crop.NumKept = 0;
+		bool bLoaded = false;
+		if (bCompressed) {
+			// Positions need the chunk bounds, so the whole vertex element is dequantized
+			Arena.Reserve(FCompressedSplatDecoder::GetBatchBytes(FMath::Min(count, FGaussianSplatBuffer::RowsPerBatch), 0));
+			Compressed.SetArena(&Arena, 0);
+			bLoaded = reader.load_element_batches(FGaussianSplatBuffer::RowsPerBatch, [&](uint32_t FirstRow, uint32_t NumRows) {
+				if (!Compressed.DecodeVertices(reader, FirstRow)) {
+					return false;
+				}
+				Crop.NumKept += Filter.FilterPositions(Compressed.Column(EGaussianSplatColumn::X), Compressed.Column(EGaussianSplatColumn::Y),
+					Compressed.Column(EGaussianSplatColumn::Z), Compressed.Num(), Crop.Keep.GetData() + FirstRow);
+				return true;
+			});
+			Compressed.Reset();
+		}
+		else {
+			Splats.Resolve(*reader.element());
+			if (!Splats.HasPosition()) {
+				return false;
+			}
+			Splats.Exclude(EGaussianSplatColumn::NX, FGaussianSplatBuffer::NumColumns - 3);
+			Arena.Reserve(Splats.GetBatchBytes(FMath::Min(count, FGaussianSplatBuffer::RowsPerBatch)));
+			Splats.SetArena(&Arena);
+			bLoaded = Splats.Project(reader)
+				&& reader.load_element_batches(FGaussianSplatBuffer::RowsPerBatch, [&](uint32_t FirstRow, uint32_t NumRows) {
+					if (!Splats.Load(reader)) {
+						return false;
+					}
+					Crop.NumKept += Filter.FilterPositions(Splats.Column(EGaussianSplatColumn::X), Splats.Column(EGaussianSplatColumn::Y),
+						Splats.Column(EGaussianSplatColumn::Z), Splats.Num(), Crop.Keep.GetData() + FirstRow);
+					return true;
+				});
+			Splats.Reset();
+			Splats.SetArena(nullptr);
+		}
+		return bLoaded;
+	}
+	return false;
+}
+
+// Preprocesses a splat file that is not a PLY. ReaderType decodes the file in batches into the same
+// raw columns as FGaussianSplatBuffer: Open(AbsolutePath, Arena), GetNumSplats(), GetSHDegree(),
+// Describe(), GetError() and DecodeBatch(FirstSplat, NumSplats, SHDegree), plus the FSplatColumnSource interface.
+template <typename ReaderType>
+static int32 PreprocessSplatFile(ReaderType& Reader, const TCHAR* FormatName, const FString& FilePath, const FString& OutputFolder,
+	const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations) {
+
+	FString AbsolutePath = FPaths::ProjectContentDir() + FilePath;
+	FString Output = FString::Printf(TEXT("---- Parsing %s File ----\n\n"), FormatName);
+	FGaussianSplattingTextureData TextureData;
+	FVector3f MinPosition(MAX_flt);
+	FVector3f MaxPosition(-MAX_flt);
+
+	// Storage of the reader and the locked texture mips, see Preprocess3DGSModelToFolder
+	FSplatArena Arena;
+	FSplatArena::FExternalBytes TextureBytes(Arena);
+	bOutSuccess = false;
+	if (!Reader.Open(AbsolutePath, Arena)) {
+		OutputString = FString::Printf(TEXT("Parsing %s failed - %s"), FormatName, *Reader.GetError());
+		return -1;
+	}
+
+	const int32 NumSplats = Reader.GetNumSplats();
+	const int32 SHDegree = FMath::Min(Reader.GetSHDegree(), FMath::Clamp(Settings.MaxSHDegree, 0, 3));
+	FString HeaderLog = Reader.Describe();
+	HeaderLog += FString::Printf(TEXT("Spherical harmonics: degree %d in file, degree %d written\n"), Reader.GetSHDegree(), SHDegree);
+
+	// Crop in a position-only pass first, so the textures are sized for the kept splats
+	const FSplatCropFilter CropFilter(Settings.CropVolumes);
+	FSplatCropPass Crop;
+	if (!CropFilter.IsEmpty() && NumSplats > 0) {
+		Crop.Keep.SetNumUninitialized(NumSplats);
+		for (int32 FirstSplat = 0; FirstSplat < NumSplats; FirstSplat += int32(FGaussianSplatBuffer::RowsPerBatch)) {
+			const int32 NumRows = FMath::Min(int32(FGaussianSplatBuffer::RowsPerBatch), NumSplats - FirstSplat);
+			if (!Reader.DecodeBatch(FirstSplat, NumRows, 0)) {
+				OutputString = FString::Printf(TEXT("Parsing %s failed - Cannot decode splats %d to %d"), FormatName, FirstSplat, FirstSplat + NumRows - 1);
+				return -1;
+			}
+			Crop.NumKept += CropFilter.FilterPositions(Reader.Column(EGaussianSplatColumn::X), Reader.Column(EGaussianSplatColumn::Y),
+				Reader.Column(EGaussianSplatColumn::Z), NumRows, Crop.Keep.GetData() + FirstSplat);
+		}
+		HeaderLog += FString::Printf(TEXT("Crop: %d volumes, %d of %d splats kept\n"), Settings.CropVolumes.Num(), Crop.NumKept, NumSplats);
+	}
+	const int32 NumKept = Crop.IsActive() ? Crop.NumKept : NumSplats;
+	if (NumKept <= 100) {
+		OutputString = TEXT("Too few splats to process");
+		return NumKept;
+	}
+
+	FString ModelFolderPath = CreateDirectory(FPaths::ProjectContentDir() + OutputFolder);
+
+	if (!BeginSplatTextures(ModelFolderPath, NumKept, SHDegree, Settings, TextureData)) {
+		AbortSplatTextures(TextureData);
+		return -1;
+	}
+	TextureBytes.Set(EstimateResidentTextureBytes(TextureData));
+
+	for (int32 FirstSplat = 0; FirstSplat < NumSplats; FirstSplat += int32(FGaussianSplatBuffer::RowsPerBatch)) {
+		const int32 NumRows = FMath::Min(int32(FGaussianSplatBuffer::RowsPerBatch), NumSplats - FirstSplat);
+		if (!Reader.DecodeBatch(FirstSplat, NumRows, SHDegree)) {
+			AbortSplatTextures(TextureData);
+			OutputString = FString::Printf(TEXT("Parsing %s failed - Cannot decode splats %d to %d"), FormatName, FirstSplat, FirstSplat + NumRows - 1);
+			return -1;
+		}
+		Crop.ConvertBatch(FSplatColumnSource(Reader), FirstSplat, NumRows, [&](const auto& Source, int32 Num, int32 FirstTexel) {
+			ConvertSplatBatch(Source, Num, FirstTexel, SHDegree, TextureData, MinPosition, MaxPosition);
+		});
+		if (TextureData.bFailed) {
+			AbortSplatTextures(TextureData);
+			OutputString = FString::Printf(TEXT("Parsing %s failed - Cannot create the textures of splats from %d on"), FormatName, FirstSplat);
+			return -1;
+		}
+	}
+
+	const FString MemoryLog = Arena.Describe();
+	UE_LOG(LogTemp, Log, TEXT("Preprocess3DGSModel %s - %s"), *FilePath, *MemoryLog);
+
+	bOutSuccess = true;
+	OutputString = Output + FinishPreprocess(AbsolutePath, FormatName, HeaderLog, MemoryLog, TextureData, TexLocations);
+	return NumKept;
+}
+
+// ---------- Public Class Functions ----------
+
+int UParser::Preprocess3DGSModel(FString FilePath, bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations) {
+	return Preprocess3DGSModelWithSettings(FilePath, FGaussianSplatPreprocessSettings(), bOutSuccess, OutputString, TexLocations);
+}
+
+int UParser::Preprocess3DGSModelWithSettings(FString FilePath, const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations) {
+	// Output to same folder as input file (without extension)
+	const FString OutputFolder = FPaths::GetPath(FilePath) / FPaths::GetBaseFilename(FilePath);
+	return Preprocess3DGSModelToFolder(FilePath, OutputFolder, Settings, bOutSuccess, OutputString, TexLocations);
+}
+
+int UParser::Preprocess3DGSModelToFolder(FString FilePath, FString OutputFolder, const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess,
+	FString& OutputString, TArray<FTextureLocations>& TexLocations) {
+	// ----- Prepare Parsing -----
+	// FilePath is relative to Content/ (e.g., "Splats/mymodel.ply")
+	FString AbsolutePath = FPaths::ProjectContentDir() + FilePath;
+	FString Output = "---- Parsing PLY File ----\n\n";
+	FGaussianSplatBuffer Splats;
+	FGaussianSplattingTextureData TextureData;
+	uint32_t numVertices = 0;
+	bool bValidModel = false;
+	int32 SHDegree = 0;
+	FString MemoryLog;
+	FVector3f MinPosition(MAX_flt);
+	FVector3f MaxPosition(-MAX_flt);
+
+	// ----- Parsing -----
+	// -- Determine File Type --
+	const FString Extension = FPaths::GetExtension(FilePath);
+	if (Extension.Equals(TEXT("spz"), ESearchCase::IgnoreCase)) {
+		FSpzReader SpzReader;
+		return PreprocessSplatFile(SpzReader, TEXT("SPZ"), FilePath, OutputFolder, Settings, bOutSuccess, OutputString, TexLocations);
+	}
+	if (Extension.Equals(TEXT("splat"), ESearchCase::IgnoreCase)) {
+		FSplatReader SplatReader;
+		return PreprocessSplatFile(SplatReader, TEXT("SPLAT"), FilePath, OutputFolder, Settings, bOutSuccess, OutputString, TexLocations);
+	}
+	if (Extension.Equals(TEXT("ksplat"), ESearchCase::IgnoreCase)) {
+		FKSplatReader KSplatReader;
+		return PreprocessSplatFile(KSplatReader, TEXT("KSPLAT"), FilePath, OutputFolder, Settings, bOutSuccess, OutputString, TexLocations);
+	}
+
+	// -- Check Validity --
+	miniply::PLYReader reader(TCHAR_TO_ANSI(*AbsolutePath), true);
+	reader.set_parallel_for(&ParallelForPLY);
+
+	if (!reader.valid()) {
+		bOutSuccess = false;
+		OutputString = FString::Printf(TEXT("Parsing PLY failed - Not a valid PLY file - %s"), *AbsolutePath);
+		return -1;
+	}
+
+	// -- Crop --
+	// Positions are read in a pass of their own first, so the textures are sized for the kept splats
+	const FSplatCropFilter CropFilter(Settings.CropVolumes);
+	FSplatCropPass Crop;
+	if (!CropFilter.IsEmpty() && !CropPLYFile(AbsolutePath, CropFilter, Crop)) {
+		bOutSuccess = false;
+		OutputString = FString::Printf(TEXT("Parsing PLY failed - Cannot read the splat positions to crop - %s"), *AbsolutePath);
+		return -1;
+	}
+
+	// -- Content Parsing --
+	FString HeaderLog = FString::Printf(TEXT("ply\nformat %s %d.%d\n"), ANSI_TO_TCHAR(kFileTypes[int(reader.file_type())]),
+		reader.version_major(), reader.version_minor());
+
+	// All intermediate column storage of the job comes from one arena sized from the header;
+	// the reader's buffers and the locked texture mips are accounted next to it, so the log shows the working set.
+	FSplatArena Arena;
+	FSplatArena::FExternalBytes ReaderBytes(Arena);
+	FSplatArena::FExternalBytes TextureBytes(Arena);
+	ReaderBytes.Set(int64(reader.buffer_bytes()));
+
+	// Compressed files spread every splat over the chunk, vertex and sh elements
+	const bool bCompressed = FCompressedSplatDecoder::IsCompressedLayout(reader);
+	FCompressedSplatDecoder Compressed;
+	bool bTexturesBegun = false;
+
+	for (; reader.has_element(); reader.next_element()) {
+		// - Element (Set of Vertices, Faces, etc.)
+		const miniply::PLYElement* elem = reader.element();
+		HeaderLog += FString::Printf(TEXT("element %s %u\n"), ANSI_TO_TCHAR(elem->name.c_str()), elem->count);
+
+		// - Read PLY Header
+		for (const miniply::PLYProperty& prop : elem->properties) {
+			if (prop.countType != miniply::PLYPropertyType::None) {
+				HeaderLog += FString::Printf(TEXT("property list %s %s %s\n"), ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.countType)]),
+					ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.type)]), ANSI_TO_TCHAR(prop.name.c_str()));
+			}
+			else {
+				HeaderLog += FString::Printf(TEXT("property %s %s\n"), ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.type)]), ANSI_TO_TCHAR(prop.name.c_str()));
+			}
 		}
-		if (ScaleExists) {
-			SplatData.Scales.Add(100.0f*FVector(FMath::Exp(vertexData["scale_0"][i]), FMath::Exp(vertexData["scale_2"][i]), FMath::Exp(vertexData["scale_1"][i]))); // Apply Exponential Function
+
+		// Splats are indexed with int32 from here on; texture pages keep the texel offsets in range
+		if (reader.element_is(miniply::kPLYVertexElement) && elem->count > uint32_t(MAX_int32)) {
+			AbortSplatTextures(TextureData);
+			bOutSuccess = false;
+			OutputString = FString::Printf(TEXT("Parsing PLY failed - %u splats, more than the %d supported - %s"), elem->count, MAX_int32, *AbsolutePath);
+			return -1;
 		}
-		if (OpacityExists) {
-			SplatData.Opacity.Add(FMath::Clamp(1.0f / (1.0f + FMath::Exp(-vertexData["opacity"][i])), 0.0f, 1.0f)); // Apply Sigmoid Function
+
+		// - Dequantize compressed splats into the output textures, element by element
+		if (bCompressed) {
+			if (reader.element_is("chunk")) {
+				bValidModel = Compressed.LoadChunks(reader);
+			}
+			else if (reader.element_is(miniply::kPLYVertexElement) && bValidModel) {
+				const int32 FileSHDegree = FCompressedSplatDecoder::GetSHDegree(reader);
+				SHDegree = FMath::Min(FileSHDegree, FMath::Clamp(Settings.MaxSHDegree, 0, 3));
+				HeaderLog += FString::Printf(TEXT("Compressed splats: spherical harmonics degree %d in file, degree %d written\n"), FileSHDegree, SHDegree);
+				numVertices = Crop.IsActive() ? uint32_t(Crop.NumKept) : elem->count;
+				if (numVertices <= 100) {
+					continue;
+				}
+
+				FString ModelFolderPath = CreateDirectory(FPaths::ProjectContentDir() + OutputFolder);
+
+				Arena.Reserve(FCompressedSplatDecoder::GetBatchBytes(FMath::Min(elem->count, FGaussianSplatBuffer::RowsPerBatch), SHDegree));
+				Compressed.SetArena(&Arena, SHDegree);
+
+				// Harmonics are written by the sh element that follows, so every page stays open until the end
+				bTexturesBegun = BeginSplatTextures(ModelFolderPath, int32(numVertices), SHDegree, Settings, TextureData, false);
+				if (bTexturesBegun) {
+					TextureBytes.Set(EstimateResidentTextureBytes(TextureData));
+				}
+				bValidModel = bTexturesBegun
+					&& reader.load_element_batches(FGaussianSplatBuffer::RowsPerBatch, [&](uint32_t FirstRow, uint32_t NumRows) {
+						ReaderBytes.Set(int64(reader.buffer_bytes()));
+						if (!Compressed.DecodeVertices(reader, FirstRow)) {
+							return false;
+						}
+						Crop.ConvertBatch(FSplatColumnSource(Compressed), int32(FirstRow), Compressed.Num(), [&](const auto& Source, int32 Num, int32 FirstTexel) {
+							ConvertSplatBatch(Source, Num, FirstTexel, 0, TextureData, MinPosition, MaxPosition);
+						});
+						return true;
+					});
+			}
+			else if (reader.element_is("sh") && bValidModel && bTexturesBegun && SHDegree > 0) {
+				Crop.Restart();
+				bValidModel = reader.load_element_batches(FGaussianSplatBuffer::RowsPerBatch, [&](uint32_t FirstRow, uint32_t NumRows) {
+					ReaderBytes.Set(int64(reader.buffer_bytes()));
+					if (!Compressed.DecodeHarmonics(reader, SHDegree)) {
+						return false;
+					}
+					Crop.ConvertBatch(FSplatColumnSource(Compressed), int32(FirstRow), Compressed.Num(), [&](const auto& Source, int32 Num, int32 FirstTexel) {
+						ConvertHarmonicsBatch(Source, Num, FirstTexel, SHDegree, TextureData);
+					});
+					return true;
+				});
+			}
+			continue;
 		}
-		if (ZeroOrderHarmonicsExists) {
-			SplatData.ZeroOrderHarmonicsCoefficients.Add(FVector(vertexData["f_dc_0"][i], vertexData["f_dc_1"][i], vertexData["f_dc_2"][i]));
+
+		// - Stream Vertices straight into the output textures
+		if (reader.element_is(miniply::kPLYVertexElement)) {
+			Splats.Resolve(*elem);
+
+			// Only decode what ends up in the textures: no normals, and no SH bands above the
+			// file's own degree or MaxSHDegree
+			SHDegree = FMath::Min(Splats.SHDegree(), FMath::Clamp(Settings.MaxSHDegree, 0, 3));
+			Splats.Exclude(EGaussianSplatColumn::NX, 3);
+			Splats.ExcludeSHAbove(SHDegree);
+			HeaderLog += FString::Printf(TEXT("Spherical harmonics: degree %d in file, degree %d written\n"), Splats.SHDegree(), SHDegree);
+
+			bValidModel = Splats.HasPosition() && Splats.HasRotation() && Splats.HasScale() && Splats.HasOpacity() && Splats.HasZeroOrderHarmonics() && elem->count > 0;
+			numVertices = Crop.IsActive() ? uint32_t(Crop.NumKept) : elem->count;
+			if (!bValidModel || numVertices <= 100) {
+				continue;
+			}
+
+			// -- Create Folder Structure in Game --
+			FString ModelFolderPath = CreateDirectory(FPaths::ProjectContentDir() + OutputFolder);
+
+			// Only one batch of raw splats is held in memory; every batch is converted
+			// into the locked texture mips as soon as it has been read.
+			// Files with the exact INRIA layout are converted straight from the rows, everything
+			// else goes through per-column extraction into the SoA buffer first.
+			const bool bCanonical = FGaussianSplatBuffer::IsCanonicalLayout(*elem);
+			if (!bCanonical) {
+				Arena.Reserve(Splats.GetBatchBytes(FMath::Min(elem->count, FGaussianSplatBuffer::RowsPerBatch)));
+			}
+			Splats.SetArena(&Arena);
+
+			bTexturesBegun = BeginSplatTextures(ModelFolderPath, int32(numVertices), SHDegree, Settings, TextureData);
+			bValidModel = bTexturesBegun;
+			if (bValidModel) {
+				TextureBytes.Set(EstimateResidentTextureBytes(TextureData));
+			}
+			bValidModel = bValidModel
+				&& (bCanonical || Splats.Project(reader))
+				&& reader.load_element_batches(FGaussianSplatBuffer::RowsPerBatch, [&](uint32_t FirstRow, uint32_t NumRows) {
+					ReaderBytes.Set(int64(reader.buffer_bytes()));
+					auto Convert = [&](const auto& Source, int32 Num, int32 FirstTexel) {
+						ConvertSplatBatch(Source, Num, FirstTexel, SHDegree, TextureData, MinPosition, MaxPosition);
+					};
+					if (bCanonical) {
+						Crop.ConvertBatch(FCanonicalRowSource(reader.element_data()), int32(FirstRow), int32(NumRows), Convert);
+						return true;
+					}
+					if (!Splats.Load(reader)) {
+						return false;
+					}
+					Crop.ConvertBatch(FSplatColumnSource(Splats), int32(FirstRow), Splats.Num(), Convert);
+					return true;
+				});
+			Splats.Reset();
+			Splats.SetArena(nullptr);
+		}
+	}
+
+	if (Crop.IsActive()) {
+		HeaderLog += FString::Printf(TEXT("Crop: %d volumes, %d of %d splats kept\n"), Settings.CropVolumes.Num(), Crop.NumKept, Crop.Keep.Num());
+	}
+	HeaderLog += "end_header\n\n";
+
+	MemoryLog = Arena.Describe();
+	UE_LOG(LogTemp, Log, TEXT("Preprocess3DGSModel %s - %s"), *FilePath, *MemoryLog);
+	Compressed.Reset();
+	bValidModel = bValidModel && !TextureData.bFailed;
+	if (!bValidModel) {
+		AbortSplatTextures(TextureData);
+	}
+
+	// ---- Process Model Data ----
+
+	// -- Check Model Validity --
+	if (!bValidModel) {
+		return -1;
+	}
+
+	if (numVertices <= 100) {
+		bOutSuccess = false;
+		OutputString = TEXT("Too few splats to process");
+		return numVertices;
+	}
+
+	bOutSuccess = true;
+	OutputString = Output + FinishPreprocess(AbsolutePath, TEXT("PLY"), HeaderLog, MemoryLog, TextureData, TexLocations);
+	return numVertices;
+}
+
+FGaussianSplatData UParser::ParseFilePLY(FString FilePath, bool& bOutSuccess, FString& OutputString) {
+	UGaussianSplatCloud* Cloud = ParseFilePLYToCloud(FilePath, bOutSuccess, OutputString);
+	return Cloud ? Cloud->ToSplatData() : FGaussianSplatData();
+}
+
+UGaussianSplatCloud* UParser::ParseFilePLYToCloud(FString FilePath, bool& bOutSuccess, FString& OutputString) {
+
+	// ---- Preparation ----
+	// FilePath is relative to Content/ (e.g., "Splats/mymodel.ply")
+	FString AbsolutePath = FPaths::ProjectContentDir() + FilePath;
+	FString Output = "---- Parsing PLY File ----\n\n";
+	FGaussianSplatBuffer Splats;
+	uint32_t numVertices = 0;
+
+	// ---- PLY Parsing ----
+	
+	miniply::PLYReader reader(TCHAR_TO_ANSI(*AbsolutePath), true);
+	reader.set_parallel_for(&ParallelForPLY);
+	
+	if (!reader.valid()) {
+		bOutSuccess = false;
+		OutputString = FString::Printf(TEXT("Parsing PLY failed - Not a valid PLY file - %s"), *AbsolutePath);
+		return nullptr;
+	}
+
+	UGaussianSplatCloud* Cloud = NewObject<UGaussianSplatCloud>();
+	
+	FString HeaderLog = FString::Printf(TEXT("ply\nformat %s %d.%d\n"), ANSI_TO_TCHAR(kFileTypes[int(reader.file_type())]),
+		reader.version_major(), reader.version_minor());
+
+	// -- Content Parsing --
+
+	for (; reader.has_element() ;reader.next_element()) {
+		// - Element (Set of Vertices, Faces, etc.)
+		const miniply::PLYElement* elem = reader.element();
+		HeaderLog += FString::Printf(TEXT("element %s %u\n"), ANSI_TO_TCHAR(elem->name.c_str()), elem->count);
+
+		// - Read PLY Header
+		for (const miniply::PLYProperty& prop : elem->properties) {
+			if (prop.countType != miniply::PLYPropertyType::None) {
+				HeaderLog += FString::Printf(TEXT("property list %s %s %s\n"), ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.countType)]),
+					ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.type)]), ANSI_TO_TCHAR(prop.name.c_str()));
+			}
+			else {
+				HeaderLog += FString::Printf(TEXT("property %s %s\n"), ANSI_TO_TCHAR(kPropertyTypes[uint32_t(prop.type)]), ANSI_TO_TCHAR(prop.name.c_str()));
+			}
 		}
-		if (higherOrderHarmonicsExists) {
-			FHighOrderHarmonicsCoefficientsStruct higherOrderHarmonics;
-			for (uint32_t y = 0; y < 45; y += 3) {
-				FString index1 = "f_rest_" + FString::FromInt(y);
-				FString index2 = "f_rest_" + FString::FromInt(y+1);
-				FString index3 = "f_rest_" + FString::FromInt(y+2);
 
-				higherOrderHarmonics.Values.Add(FVector(vertexData[index1][i], vertexData[index2][i], vertexData[index3][i]));
+		// - Extract Data from Vertices, one batch at a time
+		if (reader.element_is(miniply::kPLYVertexElement)) {
+			Splats.Resolve(*elem);
+			if (!Splats.Project(reader)) {
+				bOutSuccess = false;
+				OutputString = FString::Printf(TEXT("Parsing PLY failed - Cannot select the vertex properties - %s"), *AbsolutePath);
+				return nullptr;
+			}
+
+			// Size every output array up front so batches can be converted in place
+			uint32_t count = elem->count;
+			if (count > uint32_t(UGaussianSplatCloud::GetMaxSplats(Splats.SHDegree()))) {
+				bOutSuccess = false;
+				OutputString = FString::Printf(TEXT("Parsing PLY failed - %u splats with spherical harmonics degree %d do not fit in a cloud - %s"),
+					count, Splats.SHDegree(), *AbsolutePath);
+				return nullptr;
+			}
+			Cloud->Allocate(int32(count), Splats.HasPosition(), Splats.HasNormals(), Splats.HasRotation(), Splats.HasScale(),
+				Splats.HasOpacity(), Splats.HasZeroOrderHarmonics(), Splats.SHDegree());
+
+			bool bLoaded = reader.load_element_batches(FGaussianSplatBuffer::RowsPerBatch, [&](uint32_t FirstRow, uint32_t NumRows) {
+				if (!Splats.Load(reader)) {
+					return false;
+				}
+				ConvertSplatBatch(Splats, int32(FirstRow), *Cloud);
+				return true;
+			});
+			Splats.Reset();
+
+			if (!bLoaded) {
+				Cloud->Empty();
+				bOutSuccess = false;
+				OutputString = FString::Printf(TEXT("Parsing PLY failed - Cannot read the vertex data - %s"), *AbsolutePath);
+				return nullptr;
+			}
+			numVertices = count;
+			HeaderLog += "Props Read for Vertices\n";
+			for (const miniply::PLYProperty& prop : elem->properties) {
+				HeaderLog += FString::Printf(TEXT("Property: %s "), ANSI_TO_TCHAR(prop.name.c_str()));
 			}
-			SplatData.HighOrderHarmonicsCoefficients.Add(higherOrderHarmonics);
 		}
 	}
 
+	HeaderLog += "end_header\n\n";
+
 	// ---- Finishing up ----
 
 	bOutSuccess = true;
@@ -635,11 +1696,94 @@ FGaussianSplatData UParser::ParseFilePLY(FString FilePath, bool& bOutSuccess, FS
 	Output += "---- Finished Parsing PLY File ----";
 	OutputString = Output;
 
-	return SplatData;
+	return Cloud;
+}
+
+bool UParser::WriteCloudToPLY(const UGaussianSplatCloud* Cloud, FString FilePath, const FGaussianSplatExportSettings& Settings, FString& OutputString) {
+	FString AbsolutePath = FPaths::ProjectContentDir() + FilePath;
+	if (!Cloud || Cloud->GetPositions().Num() != Cloud->Num()) {
+		OutputString = FString::Printf(TEXT("Writing PLY failed - Cloud has no positions - %s"), *AbsolutePath);
+		return false;
+	}
+
+	FSplatPLYWriter Writer(*Cloud, Settings);
+	if (!Writer.Write(AbsolutePath)) {
+		OutputString = FString::Printf(TEXT("Writing PLY failed - %s"), *Writer.GetError());
+		return false;
+	}
+	OutputString = FString::Printf(TEXT("Successfully wrote PLY File - %s\n\n%d splats, %d bytes per splat\n\n-- PLY Header --\n\n%s"),
+		*AbsolutePath, Cloud->Num(), Writer.GetRowStride(), *Writer.GetHeader());
+	return true;
+}
+
+bool UParser::ProbePLY(FString FilePath, FGaussianSplatProbeResult& OutProbe, int32 NumSamples) {
+	return ProbePLYWithSettings(FilePath, FGaussianSplatPreprocessSettings(), OutProbe, NumSamples);
 }
 
-TArray<FLinearColor> UParser::SH2RGB(TArray<FVector> ZeroOrderHarmonics, TArray<FHighOrderHarmonicsCoefficientsStruct> HigherOrderHarmonics) {
+bool UParser::ProbePLYWithSettings(FString FilePath, const FGaussianSplatPreprocessSettings& Settings, FGaussianSplatProbeResult& OutProbe, int32 NumSamples) {
+	FString AbsolutePath = FPaths::ProjectContentDir() + FilePath;
+	OutProbe = FGaussianSplatProbeResult();
+
+	miniply::PLYReader reader(TCHAR_TO_ANSI(*AbsolutePath), true);
+	if (!reader.valid()) {
+		UE_LOG(LogTemp, Warning, TEXT("ProbePLY - Not a valid PLY file - %s"), *AbsolutePath);
+		return false;
+	}
+
+	const uint32_t vertexIdx = reader.find_element(miniply::kPLYVertexElement);
+	if (vertexIdx == miniply::kInvalidIndex) {
+		UE_LOG(LogTemp, Warning, TEXT("ProbePLY - No vertex element - %s"), *AbsolutePath);
+		return false;
+	}
+
+	OutProbe.Format = ANSI_TO_TCHAR(kFileTypes[int(reader.file_type())]);
+	OutProbe.FileSizeBytes = IFileManager::Get().FileSize(*AbsolutePath);
+
+	// Skip whatever precedes the vertex element (normally nothing) without loading it
+	while (reader.has_element() && !reader.element_is(miniply::kPLYVertexElement)) {
+		reader.next_element();
+	}
+	if (!reader.has_element()) {
+		return false;
+	}
+
+	const miniply::PLYElement* elem = reader.element();
+	OutProbe.NumSplats = int64(elem->count);
+	for (const miniply::PLYProperty& prop : elem->properties) {
+		OutProbe.PropertyNames.Add(ANSI_TO_TCHAR(prop.name.c_str()));
+		OutProbe.PropertyTypes.Add(prop.countType == miniply::PLYPropertyType::None
+			? FString(ANSI_TO_TCHAR(kPropertyTypes[int(prop.type)]))
+			: FString::Printf(TEXT("list %s %s"), ANSI_TO_TCHAR(kPropertyTypes[int(prop.countType)]), ANSI_TO_TCHAR(kPropertyTypes[int(prop.type)])));
+	}
+
+	// Compressed files keep their harmonics in a separate element and have no float positions to sample
+	const bool bCompressed = FCompressedSplatDecoder::IsCompressedLayout(reader);
+	FGaussianSplatBuffer Splats;
+	Splats.Resolve(*elem);
+	OutProbe.SHDegree = bCompressed ? FCompressedSplatDecoder::GetSHDegree(reader) : Splats.SHDegree();
+	OutProbe.EstimatedTextureBytes = EstimateSplatTextureBytes(FMath::Min<int64>(OutProbe.NumSplats, MAX_int32),
+		FMath::Min(OutProbe.SHDegree, Settings.MaxSHDegree), Settings, false);
+
+	// Approximate bounds from a sample of positions; nothing else is decoded
+	uint32_t posIdx[3];
+	if (!bCompressed && NumSamples > 0 && elem->count > 0 && elem->fixedSize && reader.find_pos(posIdx)
+		&& reader.set_projection(posIdx, 3) && reader.load_element_sample(uint32_t(NumSamples))) {
+		const uint32_t NumSampled = reader.num_loaded_rows();
+		TArray<FVector3f> Positions;
+		Positions.SetNumUninitialized(NumSampled);
+		if (reader.extract_properties(posIdx, 3, miniply::PLYPropertyType::Float, Positions.GetData())) {
+			for (const FVector3f& Position : Positions) {
+				OutProbe.ApproximateBounds += 100.0f * FVector(Position.X, -Position.Z, -Position.Y);
+			}
+			OutProbe.NumSampledSplats = int32(NumSampled);
+		}
+	}
+	return true;
+}
+
+TArray<FLinearColor> UParser::SH2RGB(const TArray<FVector>& ZeroOrderHarmonics, const TArray<FHighOrderHarmonicsCoefficientsStruct>& HigherOrderHarmonics) {
 	TArray<FLinearColor> result;
+	result.Reserve(ZeroOrderHarmonics.Num());
 	for (int i = 0; i < ZeroOrderHarmonics.Num(); i++) {
 		FLinearColor col = FLinearColor(0.5 + C0 * ZeroOrderHarmonics[i].X, 0.5 + C0 * ZeroOrderHarmonics[i].Y, 0.5 + C0 * ZeroOrderHarmonics[i].Z);
 		result.Add(col);
@@ -647,7 +1791,183 @@ TArray<FLinearColor> UParser::SH2RGB(TArray<FVector> ZeroOrderHarmonics, TArray<
 	return result;
 }
 
+TArray<FLinearColor> UParser::EvaluateSplatColors(const UGaussianSplatCloud* Cloud, FVector CameraPosition, int32 MaxSHDegree) {
+	TArray<FLinearColor> Colors;
+	if (!Cloud || Cloud->GetZeroOrderHarmonicsArray().Num() != Cloud->Num() || Cloud->GetPositions().Num() != Cloud->Num()) {
+		UE_LOG(LogTemp, Warning, TEXT("EvaluateSplatColors - Cloud needs positions and zero order harmonics"));
+		return Colors;
+	}
+
+	const int32 NumSplats = Cloud->Num();
+	const int32 SHDegree = FMath::Min(Cloud->GetSHDegree(), FMath::Clamp(MaxSHDegree, 0, 3));
+	const int32 Stride = Cloud->GetNumSHCoefficients();
+	const FVector3f Camera(CameraPosition);
+	Colors.SetNumUninitialized(NumSplats);
+
+	ParallelFor(FGaussianSplatBuffer::NumTasks(NumSplats), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 Num = FMath::Min(FGaussianSplatBuffer::RowsPerTask, NumSplats - Begin);
+		TConstArrayView<FVector3f> ZeroOrder = Cloud->GetZeroOrderHarmonicsArray().Slice(Begin, Num);
+		TConstArrayView<FVector3f> Positions = Cloud->GetPositions().Slice(Begin, Num);
+		TConstArrayView<float> HigherOrder = Stride > 0 ? Cloud->GetHigherOrderHarmonicsArray().Slice(Begin * Stride * 3, Num * Stride * 3) : TConstArrayView<float>();
+		TArrayView<FLinearColor> Out = TArrayView<FLinearColor>(Colors).Slice(Begin, Num);
+		switch (SHDegree) {
+		case 0: SplatKernels::EvaluateSH<0>(ZeroOrder, HigherOrder, Stride, Positions, Camera, Out); break;
+		case 1: SplatKernels::EvaluateSH<1>(ZeroOrder, HigherOrder, Stride, Positions, Camera, Out); break;
+		case 2: SplatKernels::EvaluateSH<2>(ZeroOrder, HigherOrder, Stride, Positions, Camera, Out); break;
+		default: SplatKernels::EvaluateSH<3>(ZeroOrder, HigherOrder, Stride, Positions, Camera, Out); break;
+		}
+	});
+	return Colors;
+}
+
+// Writes the textures of a cloud to AbsolutePath, after cropping it with the crop volumes of Settings, which are placed
+// in its space. The cloud goes through the same conversion as file data, read back as raw columns, and pages are saved
+// as soon as conversion moves past them. FailurePrefix starts the message of a failure.
+// Returns the number of splats written, or -1 on failure.
+static int PreprocessCloud(const UGaussianSplatCloud* Cloud, const FString& AbsolutePath, const TCHAR* FormatName, const TCHAR* FailurePrefix,
+	const FGaussianSplatPreprocessSettings& Settings, FString HeaderLog, bool& bOutSuccess, FString& OutputString,
+	TArray<FTextureLocations>& TexLocations, int64* OutPeakTextureBytes) {
+
+	bOutSuccess = false;
+	const FSplatCropFilter CropFilter(Settings.CropVolumes);
+	if (!CropFilter.IsEmpty()) {
+		TConstArrayView<FVector3f> Positions = Cloud->GetPositions();
+		TArray<bool> Cropped;
+		Cropped.SetNumUninitialized(Cloud->Num());
+		ParallelFor(FGaussianSplatBuffer::NumTasks(Cloud->Num()), [&](int32 Task) {
+			const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+			const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, Positions.Num());
+			for (int32 i = Begin; i < End; i++) {
+				Cropped[i] = !CropFilter.Contains(Positions[i]);
+			}
+		});
+		const int32 NumBeforeCrop = Cloud->Num();
+		Cloud = FSplatCloudMerge::Compact(*Cloud, Cropped);
+		HeaderLog += FString::Printf(TEXT("Crop: %d volumes, %d of %d splats kept\n"), Settings.CropVolumes.Num(), Cloud->Num(), NumBeforeCrop);
+	}
+
+	const int32 NumSplats = Cloud->Num();
+	const int32 SHDegree = FMath::Min(Cloud->GetSHDegree(), FMath::Clamp(Settings.MaxSHDegree, 0, 3));
+	if (Cloud->GetOrientations().Num() != NumSplats || Cloud->GetScales().Num() != NumSplats
+		|| Cloud->GetOpacities().Num() != NumSplats || Cloud->GetZeroOrderHarmonicsArray().Num() != NumSplats) {
+		OutputString = FString::Printf(TEXT("%s - Not every splat has a rotation, scale, opacity and base color"), FailurePrefix);
+		return -1;
+	}
+	if (NumSplats <= 100) {
+		OutputString = TEXT("Too few splats to process");
+		return NumSplats;
+	}
+	HeaderLog += FString::Printf(TEXT("Spherical harmonics: degree %d in the cloud, degree %d written\n"), Cloud->GetSHDegree(), SHDegree);
+
+	FString ModelFolderPath = CreateDirectory(AbsolutePath);
+	FGaussianSplattingTextureData TextureData;
+	if (!BeginSplatTextures(ModelFolderPath, NumSplats, SHDegree, Settings, TextureData)) {
+		AbortSplatTextures(TextureData);
+		OutputString = FString::Printf(TEXT("%s - Cannot create the textures"), FailurePrefix);
+		return -1;
+	}
+	FSplatArena Arena;
+	FSplatArena::FExternalBytes TextureBytes(Arena);
+	TextureBytes.Set(EstimateResidentTextureBytes(TextureData));
+
+	FVector3f MinPosition(MAX_flt);
+	FVector3f MaxPosition(-MAX_flt);
+	ConvertSplatBatch(FGaussianSplatCloudSource(*Cloud), NumSplats, 0, SHDegree, TextureData, MinPosition, MaxPosition);
+	if (TextureData.bFailed) {
+		AbortSplatTextures(TextureData);
+		OutputString = FString::Printf(TEXT("%s - Cannot create the textures"), FailurePrefix);
+		return -1;
+	}
+
+	const FString MemoryLog = Arena.Describe();
+	bOutSuccess = true;
+	OutputString = FinishPreprocess(AbsolutePath, FormatName, HeaderLog, MemoryLog, TextureData, TexLocations);
+	if (OutPeakTextureBytes) {
+		*OutPeakTextureBytes = TextureData.PeakHeldTextureBytes;
+	}
+	return NumSplats;
+}
+
+int UParser::PreprocessMerge(const TArray<FGaussianSplatMergeInput>& Inputs, FString ModelPath, const FGaussianSplatMergeSettings& MergeSettings,
+	const FGaussianSplatPreprocessSettings& Settings, int32& OutNumRemoved, bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations) {
+
+	// ModelPath is relative to Content/ (e.g., "Splats/site")
+	FString AbsolutePath = FPaths::ProjectContentDir() + ModelPath;
+	FString Output = "---- Merging PLY Files ----\n\n";
+	FString HeaderLog;
+	OutNumRemoved = 0;
+	bOutSuccess = false;
+
+	// ---- Load every capture ----
+	TArray<UGaussianSplatCloud*> Clouds;
+	TArray<FTransform> Transforms;
+	for (int32 Index = 0; Index < Inputs.Num(); Index++) {
+		bool bParsed = false;
+		FString ParseOutput;
+		UGaussianSplatCloud* Cloud = ParseFilePLYToCloud(Inputs[Index].FilePath, bParsed, ParseOutput);
+		if (!bParsed || !Cloud || Cloud->GetPositions().Num() != Cloud->Num()) {
+			OutputString = FString::Printf(TEXT("Merging PLY failed - Cannot read capture %d - %s"), Index, *ParseOutput);
+			return -1;
+		}
+		HeaderLog += FString::Printf(TEXT("capture %d: %s, %d splats, spherical harmonics degree %d\n"),
+			Index, *Inputs[Index].FilePath, Cloud->Num(), Cloud->GetSHDegree());
+		if (!Inputs[Index].Transform.GetRotation().IsIdentity(UE_KINDA_SMALL_NUMBER) && Cloud->GetSHDegree() > 0) {
+			HeaderLog += FString::Printf(TEXT("capture %d: rotated by %.2f degrees, spherical harmonics rotated with it\n"),
+				Index, FMath::RadiansToDegrees(Inputs[Index].Transform.GetRotation().GetAngle()));
+		}
+		Clouds.Add(Cloud);
+		Transforms.Add(Inputs[Index].Transform);
+	}
+
+	// ---- Merge and remove overlaps ----
+	TArray<int32> SourceIndices;
+	FString MergeError;
+	UGaussianSplatCloud* Merged = FSplatCloudMerge::Concatenate(TArray<const UGaussianSplatCloud*>(Clouds), Transforms, SourceIndices, MergeError);
+	if (!Merged) {
+		OutputString = FString::Printf(TEXT("Merging PLY failed - %s"), *MergeError);
+		return -1;
+	}
+	Clouds.Reset();
+	HeaderLog += FString::Printf(TEXT("merged %d splats\n"), Merged->Num());
+
+	if (MergeSettings.bRemoveOverlaps) {
+		TArray<bool> Removed;
+		OutNumRemoved = FSplatCloudMerge::FindOverlaps(*Merged, SourceIndices, MergeSettings, Removed);
+		if (OutNumRemoved > 0) {
+			Merged = FSplatCloudMerge::Compact(*Merged, Removed);
+		}
+		HeaderLog += FString::Printf(TEXT("removed %d overlapping splats (cell size %g), %d remaining\n"), OutNumRemoved, MergeSettings.CellSize, Merged->Num());
+	}
+
+	const int32 NumSplats = PreprocessCloud(Merged, AbsolutePath, TEXT("Merged PLY"), TEXT("Merging PLY failed"), Settings, HeaderLog,
+		bOutSuccess, OutputString, TexLocations, nullptr);
+	if (bOutSuccess) {
+		UE_LOG(LogTemp, Log, TEXT("PreprocessMerge %s - %d splats, %d overlapping splats removed"), *ModelPath, NumSplats, OutNumRemoved);
+		OutputString = Output + OutputString;
+	}
+	return NumSplats;
+}
+
+int UParser::PreprocessCloudToFolder(const UGaussianSplatCloud* Cloud, FString OutputFolder, const FGaussianSplatPreprocessSettings& Settings,
+	bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations, int64* OutPeakTextureBytes) {
+
+	bOutSuccess = false;
+	if (!Cloud || Cloud->GetPositions().Num() != Cloud->Num()) {
+		OutputString = TEXT("Preprocessing cloud failed - Cloud has no positions");
+		return -1;
+	}
+	const FString HeaderLog = FString::Printf(TEXT("%d splats, spherical harmonics degree %d\n"), Cloud->Num(), Cloud->GetSHDegree());
+	return PreprocessCloud(Cloud, FPaths::ProjectContentDir() + OutputFolder, TEXT("Splat Cloud"), TEXT("Preprocessing cloud failed"), Settings, HeaderLog,
+		bOutSuccess, OutputString, TexLocations, OutPeakTextureBytes);
+}
+
 int UParser::PreprocessSequence(FString ModelName, FString SourceDirectory, bool& bOutSuccess, FString& OutputString)
+{
+	return PreprocessSequenceWithSettings(ModelName, SourceDirectory, FGaussianSplatPreprocessSettings(), bOutSuccess, OutputString);
+}
+
+int UParser::PreprocessSequenceWithSettings(FString ModelName, FString SourceDirectory, const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess, FString& OutputString)
 {
 	bOutSuccess = false;
 	OutputString = TEXT("---- Preprocessing Sequence ----\n");
@@ -658,51 +1978,42 @@ int UParser::PreprocessSequence(FString ModelName, FString SourceDirectory, bool
 		return 0;
 	}
 
+	if (FImageSplatSequence::IsImageSequence(FPaths::ProjectContentDir() / SourceDirectory))
+	{
+		return PreprocessImageSequence(ModelName, SourceDirectory, Settings, bOutSuccess, OutputString);
+	}
+
 	// Find PLY files in source directory
 	// SourceDirectory is relative to Content/ (e.g., "Splats/sequence_folder")
 	FString SourcePath = FPaths::ProjectContentDir() / SourceDirectory;
 	TArray<FString> PlyFiles;
-	IFileManager::Get().FindFiles(PlyFiles, *(SourcePath / TEXT("*.ply")), true, false);
-	PlyFiles.Sort();
+	FindSplatFiles(SourcePath, PlyFiles);
 
 	if (PlyFiles.Num() == 0)
 	{
-		OutputString += FString::Printf(TEXT("Error: No PLY files found in %s\n"), *SourcePath);
+		OutputString += FString::Printf(TEXT("Error: No splat files found in %s\n"), *SourcePath);
 		return 0;
 	}
 
-	OutputString += FString::Printf(TEXT("Found %d PLY files in %s\n"), PlyFiles.Num(), *SourcePath);
+	OutputString += FString::Printf(TEXT("Found %d splat files in %s\n"), PlyFiles.Num(), *SourcePath);
 
 	// Create output directory (same parent as source, with ModelName subfolder)
-	FString OutputBasePath = FPaths::ProjectContentDir() / FPaths::GetPath(SourceDirectory) / ModelName;
-	IFileManager::Get().MakeDirectory(*OutputBasePath, true);
+	const FString OutputBaseFolder = FPaths::GetPath(SourceDirectory) / ModelName;
+	IFileManager::Get().MakeDirectory(*(FPaths::ProjectContentDir() / OutputBaseFolder), true);
 
 	int FramesProcessed = 0;
 
 	for (int32 FrameIdx = 0; FrameIdx < PlyFiles.Num(); FrameIdx++)
 	{
 		const FString& PlyFile = PlyFiles[FrameIdx];
-		FString PlyPath = SourcePath / PlyFile;
-
-		// Create frame folder: ModelName/frame_00000/
-		FString FrameFolderName = FString::Printf(TEXT("frame_%05d"), FrameIdx);
-		FString FrameFolderPath = OutputBasePath / FrameFolderName;
-		IFileManager::Get().MakeDirectory(*FrameFolderPath, true);
+		OutputString += FString::Printf(TEXT("Processing frame %d: %s\n"), FrameIdx, *PlyFile);
 
-		// Parse PLY and create textures directly in frame folder (no Emitters subfolder)
+		// Textures go straight into ModelName/frame_00000/
 		bool bParseSuccess = false;
 		FString ParseOutput;
 		TArray<FTextureLocations> TempLocations;
-
-		// Use existing preprocessing but we'll need the textures saved to a different location
-		// For now, call Preprocess3DGSModel with the individual PLY, then move/copy results
-		// This is a workaround - ideally we'd refactor to share the core parsing logic
-
-		OutputString += FString::Printf(TEXT("Processing frame %d: %s\n"), FrameIdx, *PlyFile);
-
-		// Process the PLY file - note: this creates in the old structure
-		// A proper implementation would refactor the core parsing into a shared function
-		int NumVerts = Preprocess3DGSModel(SourceDirectory / PlyFile, bParseSuccess, ParseOutput, TempLocations);
+		int NumVerts = Preprocess3DGSModelToFolder(SourceDirectory / PlyFile, OutputBaseFolder / GetSequenceFrameFolderName(FrameIdx), Settings,
+			bParseSuccess, ParseOutput, TempLocations);
 
 		if (bParseSuccess && NumVerts > 0)
 		{
@@ -717,9 +2028,156 @@ int UParser::PreprocessSequence(FString ModelName, FString SourceDirectory, bool
 
 	bOutSuccess = FramesProcessed > 0;
 	OutputString += FString::Printf(TEXT("\n---- Sequence Complete: %d/%d frames processed ----\n"), FramesProcessed, PlyFiles.Num());
-	OutputString += FString::Printf(TEXT("Note: Textures saved to old structure. Move manually to %s/frame_XXXXX/ or refactor Parser.\n"), *ModelName);
 
 	return FramesProcessed;
 }
 
+int UParser::PreprocessImageSequence(FString ModelName, FString SourceDirectory, const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess, FString& OutputString)
+{
+	bOutSuccess = false;
+	OutputString = TEXT("---- Preprocessing Image Sequence ----\n");
+
+	if (ModelName.IsEmpty())
+	{
+		OutputString += TEXT("Error: ModelName is empty!\n");
+		return 0;
+	}
 
+	// SourceDirectory is relative to Content/ (e.g., "Splats/sequence_folder")
+	FString SourcePath = FPaths::ProjectContentDir() / SourceDirectory;
+	FImageSplatSequence Sequence;
+	if (!Sequence.Open(SourcePath))
+	{
+		OutputString += FString::Printf(TEXT("Error: %s\n"), *Sequence.GetError());
+		return 0;
+	}
+	const int32 NumFrames = Sequence.GetNumFrames();
+	OutputString += FString::Printf(TEXT("Found %d image frames in %s\n"), NumFrames, *SourcePath);
+
+	FString OutputBasePath = FPaths::ProjectContentDir() / FPaths::GetPath(SourceDirectory) / ModelName;
+	IFileManager::Get().MakeDirectory(*OutputBasePath, true);
+
+	// Worker threads decode the next frames while this thread creates and saves the textures of the current one.
+	// Only MaxFramesInFlight decoded frames exist at any time.
+	const int32 MaxFramesInFlight = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() / 2, 1, 4);
+	TArray<TFuture<TSharedPtr<FImageSplatFrame>>> DecodedFrames;
+	DecodedFrames.SetNum(NumFrames);
+	auto LaunchDecode = [&Sequence, &DecodedFrames](int32 FrameIdx)
+	{
+		DecodedFrames[FrameIdx] = Async(EAsyncExecution::ThreadPool, [&Sequence, FrameIdx]()
+		{
+			TSharedPtr<FImageSplatFrame> Frame = MakeShared<FImageSplatFrame>();
+			Sequence.DecodeFrame(FrameIdx, *Frame);
+			return Frame;
+		});
+	};
+	for (int32 FrameIdx = 0; FrameIdx < FMath::Min(MaxFramesInFlight, NumFrames); FrameIdx++)
+	{
+		LaunchDecode(FrameIdx);
+	}
+
+	const FSplatCropFilter CropFilter(Settings.CropVolumes);
+	int FramesProcessed = 0;
+
+	// Every launched decode is waited for before returning, since the tasks reference Sequence
+	for (int32 FrameIdx = 0; FrameIdx < NumFrames; FrameIdx++)
+	{
+		TSharedPtr<FImageSplatFrame> Frame = DecodedFrames[FrameIdx].Get();
+		DecodedFrames[FrameIdx].Reset();
+		if (FrameIdx + MaxFramesInFlight < NumFrames)
+		{
+			LaunchDecode(FrameIdx + MaxFramesInFlight);
+		}
+
+		OutputString += FString::Printf(TEXT("Processing frame %d: %s\n"), FrameIdx, *Sequence.GetFrameFolder(FrameIdx));
+		if (!Frame->Error.IsEmpty())
+		{
+			OutputString += FString::Printf(TEXT("  -> FAILED: %s\n"), *Frame->Error);
+			continue;
+		}
+
+		FSplatCropPass Crop;
+		if (!CropFilter.IsEmpty() && Frame->Num() > 0)
+		{
+			Crop.Keep.SetNumUninitialized(Frame->Num());
+			Crop.NumKept = CropFilter.FilterPositions(Frame->Column(EGaussianSplatColumn::X), Frame->Column(EGaussianSplatColumn::Y),
+				Frame->Column(EGaussianSplatColumn::Z), Frame->Num(), Crop.Keep.GetData());
+		}
+		const int32 NumKept = Crop.IsActive() ? Crop.NumKept : Frame->Num();
+		if (NumKept <= 100)
+		{
+			OutputString += TEXT("  -> FAILED: Too few splats to process\n");
+			continue;
+		}
+
+		// Create frame folder: ModelName/frame_00000/
+		FString FrameFolderPath = CreateDirectory(OutputBasePath / GetSequenceFrameFolderName(FrameIdx));
+		FGaussianSplattingTextureData TextureData;
+		if (!BeginSplatTextures(FrameFolderPath, NumKept, 0, Settings, TextureData))
+		{
+			AbortSplatTextures(TextureData);
+			OutputString += TEXT("  -> FAILED: Cannot create the textures\n");
+			continue;
+		}
+		FVector3f MinPosition(MAX_flt);
+		FVector3f MaxPosition(-MAX_flt);
+		Crop.ConvertBatch(FSplatColumnSource(*Frame), 0, Frame->Num(), [&](const auto& Source, int32 Num, int32 FirstTexel)
+		{
+			ConvertSplatBatch(Source, Num, FirstTexel, 0, TextureData, MinPosition, MaxPosition);
+		});
+		if (TextureData.bFailed)
+		{
+			AbortSplatTextures(TextureData);
+			OutputString += TEXT("  -> FAILED: Cannot create the textures\n");
+			continue;
+		}
+		TArray<FTextureLocations> TextureLocations;
+		FinishSplatTextures(TextureData, TextureLocations);
+
+		FramesProcessed++;
+		OutputString += FString::Printf(TEXT("  -> %d splats processed\n"), NumKept);
+	}
+
+	bOutSuccess = FramesProcessed > 0;
+	OutputString += FString::Printf(TEXT("\n---- Image Sequence Complete: %d/%d frames processed into %s ----\n"), FramesProcessed, NumFrames, *OutputBasePath);
+	return FramesProcessed;
+}
+
+const TArray<FString>& UParser::GetSupportedFileExtensions()
+{
+	static const TArray<FString> Extensions = { TEXT("ply"), TEXT("spz"), TEXT("splat"), TEXT("ksplat") };
+	return Extensions;
+}
+
+FString UParser::GetSequenceFrameFolderName(int32 FrameIndex)
+{
+	return FString::Printf(TEXT("frame_%05d"), FrameIndex);
+}
+
+FString UParser::GetFileDialogFilter()
+{
+	TArray<FString> Patterns;
+	for (const FString& Extension : GetSupportedFileExtensions())
+	{
+		Patterns.Add(TEXT("*.") + Extension);
+	}
+	const FString AllPatterns = FString::Join(Patterns, TEXT(";"));
+	FString Filter = FString::Printf(TEXT("Splat Files (%s)|%s"), *AllPatterns, *AllPatterns);
+	for (const FString& Pattern : Patterns)
+	{
+		Filter += FString::Printf(TEXT("|%s Files (%s)|%s"), *Pattern.RightChop(2).ToUpper(), *Pattern, *Pattern);
+	}
+	return Filter;
+}
+
+void UParser::FindSplatFiles(const FString& AbsoluteDirectory, TArray<FString>& OutFileNames)
+{
+	OutFileNames.Reset();
+	for (const FString& Extension : GetSupportedFileExtensions())
+	{
+		TArray<FString> Found;
+		IFileManager::Get().FindFiles(Found, *(AbsoluteDirectory / (TEXT("*.") + Extension)), true, false);
+		OutFileNames.Append(Found);
+	}
+	OutFileNames.Sort();
+}
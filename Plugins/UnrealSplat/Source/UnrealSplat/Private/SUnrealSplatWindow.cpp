@@ -2,6 +2,7 @@
 
 #include "SUnrealSplatWindow.h"
 #include "Parser.h"
+#include "ImageSplatSequence.h"
 #include "DesktopPlatformModule.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SSeparator.h"
@@ -11,11 +12,22 @@
 #include "Misc/ScopedSlowTask.h"
 #include "HAL/PlatformFileManager.h"
 #include "HAL/FileManager.h"
+#include "PropertyEditorModule.h"
+#include "IStructureDetailsView.h"
+#include "UObject/StructOnScope.h"
 
 #define LOCTEXT_NAMESPACE "UnrealSplatWindow"
 
 void SUnrealSplatWindow::Construct(const FArguments& InArgs)
 {
+	SettingsStruct = MakeShared<FStructOnScope>(FGaussianSplatPreprocessSettings::StaticStruct());
+
+	FPropertyEditorModule& PropertyEditor = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	FDetailsViewArgs DetailsViewArgs;
+	DetailsViewArgs.bAllowSearch = false;
+	DetailsViewArgs.NameAreaSettings = FDetailsViewArgs::HideNameArea;
+	SettingsView = PropertyEditor.CreateStructureDetailView(DetailsViewArgs, FStructureDetailsViewArgs(), SettingsStruct);
+
 	ChildSlot
 	[
 		SNew(SVerticalBox)
@@ -86,14 +98,14 @@ void SUnrealSplatWindow::Construct(const FArguments& InArgs)
 					.WidthOverride(100)
 					[
 						SNew(STextBlock)
-						.Text(LOCTEXT("FilePath", "PLY File:"))
+						.Text(LOCTEXT("FilePath", "Splat File:"))
 					]
 				]
 				+ SHorizontalBox::Slot()
 				.FillWidth(1.0f)
 				[
 					SAssignNew(FilePathInput, SEditableTextBox)
-					.HintText(LOCTEXT("FilePathHint", "model.ply or folder with *.ply files"))
+					.HintText(LOCTEXT("FilePathHint", "model.ply/.spz/.splat/.ksplat or folder with splat files"))
 				]
 				+ SHorizontalBox::Slot()
 				.AutoWidth()
@@ -160,7 +172,19 @@ void SUnrealSplatWindow::Construct(const FArguments& InArgs)
 				.Padding(5, 0, 0, 0)
 				[
 					SNew(STextBlock)
-					.Text(LOCTEXT("SequenceMode", "Sequence Mode (process folder of PLY files as frames)"))
+					.Text(LOCTEXT("SequenceMode", "Sequence Mode (process folder of splat files as frames)"))
+				]
+			]
+
+			// Settings: SH degree and crop volumes, applied to every processed file
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0, 5)
+			[
+				SNew(SBox)
+				.MaxDesiredHeight(300)
+				[
+					SettingsView->GetWidget().ToSharedRef()
 				]
 			]
 		]
@@ -230,7 +254,7 @@ void SUnrealSplatWindow::Construct(const FArguments& InArgs)
 	// Initial log message
 	AppendLog(TEXT("UnrealSplat Preprocessor Ready"));
 	AppendLog(TEXT("---"));
-	AppendLog(TEXT("Place PLY files in Content/Splats/ folder"));
+	AppendLog(TEXT("Place splat files in Content/Splats/ folder"));
 	AppendLog(TEXT("Enter relative path (e.g., 'mymodel.ply' or 'sequence_folder')"));
 }
 
@@ -253,7 +277,7 @@ FReply SUnrealSplatWindow::OnBrowseClicked()
 		FString SelectedFolder;
 		if (DesktopPlatform->OpenDirectoryDialog(
 			FSlateApplication::Get().GetActiveTopLevelWindow()->GetNativeWindow()->GetOSWindowHandle(),
-			TEXT("Select folder with PLY sequence"),
+			TEXT("Select folder with splat sequence"),
 			StartDirectory,
 			SelectedFolder))
 		{
@@ -290,10 +314,10 @@ FReply SUnrealSplatWindow::OnBrowseClicked()
 		TArray<FString> OutFiles;
 		if (DesktopPlatform->OpenFileDialog(
 			FSlateApplication::Get().GetActiveTopLevelWindow()->GetNativeWindow()->GetOSWindowHandle(),
-			TEXT("Select PLY file"),
+			TEXT("Select splat file"),
 			StartDirectory,
 			TEXT(""),
-			TEXT("PLY Files (*.ply)|*.ply"),
+			UParser::GetFileDialogFilter(),
 			EFileDialogFlags::None,
 			OutFiles))
 		{
@@ -358,35 +382,47 @@ FReply SUnrealSplatWindow::OnPreprocessClicked()
 	AppendLog(FString::Printf(TEXT("  Full Path: Content/%s"), *FullPath));
 	AppendLog(FString::Printf(TEXT("  Model Name: %s"), *ModelName));
 	AppendLog(FString::Printf(TEXT("  Mode: %s"), bSequenceMode ? TEXT("Sequence") : TEXT("Single")));
+	AppendLog(FString::Printf(TEXT("  Max SH Degree: %d, Crop Volumes: %d"), GetSettings().MaxSHDegree, GetSettings().CropVolumes.Num()));
 
 	bool bSuccess = false;
 	FString OutputString;
 	int32 Result = 0;
 
-	if (bSequenceMode)
+	if (bSequenceMode && FImageSplatSequence::IsImageSequence(FPaths::ProjectContentDir() / FullPath))
+	{
+		// Image-packed sequence - frames are decoded in parallel inside the parser
+		AppendLog(TEXT("Found image sequence sidecar"));
+		FScopedSlowTask SlowTask(1, LOCTEXT("ProcessingImageSequence", "Decoding image sequence..."));
+		SlowTask.MakeDialog(false);
+		SlowTask.EnterProgressFrame(1);
+
+		Result = UParser::PreprocessImageSequence(ModelName, FullPath, GetSettings(), bSuccess, OutputString);
+		AppendLog(OutputString);
+		OutputString.Reset();
+	}
+	else if (bSequenceMode)
 	{
-		// Count PLY files first for progress bar
+		// Count splat files first for progress bar
 		FString SourcePath = FPaths::ProjectContentDir() / FullPath;
 		TArray<FString> PlyFiles;
-		IFileManager::Get().FindFiles(PlyFiles, *(SourcePath / TEXT("*.ply")), true, false);
+		UParser::FindSplatFiles(SourcePath, PlyFiles);
 		int32 NumFiles = PlyFiles.Num();
 
 		if (NumFiles == 0)
 		{
-			AppendLog(FString::Printf(TEXT("ERROR: No PLY files found in %s"), *SourcePath));
+			AppendLog(FString::Printf(TEXT("ERROR: No splat files found in %s"), *SourcePath));
 			return FReply::Handled();
 		}
 
-		AppendLog(FString::Printf(TEXT("Found %d PLY files"), NumFiles));
+		AppendLog(FString::Printf(TEXT("Found %d splat files"), NumFiles));
 
 		// Show progress dialog
 		FScopedSlowTask SlowTask(NumFiles, FText::FromString(FString::Printf(TEXT("Processing %d frames..."), NumFiles)));
 		SlowTask.MakeDialog(true);
 
-		// Process each file manually with progress updates
-		PlyFiles.Sort();
-		FString OutputBasePath = FPaths::ProjectContentDir() / FPaths::GetPath(FullPath) / ModelName;
-		IFileManager::Get().MakeDirectory(*OutputBasePath, true);
+		// Process each file manually with progress updates, into the frame folders PreprocessSequence writes
+		const FString OutputBaseFolder = FPaths::GetPath(FullPath) / ModelName;
+		IFileManager::Get().MakeDirectory(*(FPaths::ProjectContentDir() / OutputBaseFolder), true);
 
 		int32 FramesProcessed = 0;
 		for (int32 i = 0; i < NumFiles; i++)
@@ -406,7 +442,8 @@ FReply SUnrealSplatWindow::OnPreprocessClicked()
 			FString FrameOutput;
 			TArray<FTextureLocations> FrameLocations;
 
-			int32 NumVerts = UParser::Preprocess3DGSModel(FramePlyPath, bFrameSuccess, FrameOutput, FrameLocations);
+			int32 NumVerts = UParser::Preprocess3DGSModelToFolder(FramePlyPath, OutputBaseFolder / UParser::GetSequenceFrameFolderName(i), GetSettings(),
+				bFrameSuccess, FrameOutput, FrameLocations);
 
 			if (bFrameSuccess && NumVerts > 0)
 			{
@@ -425,13 +462,17 @@ FReply SUnrealSplatWindow::OnPreprocessClicked()
 	else
 	{
 		// Single file - simple progress
-		FScopedSlowTask SlowTask(1, LOCTEXT("ProcessingSingle", "Processing PLY file..."));
+		FScopedSlowTask SlowTask(1, LOCTEXT("ProcessingSingle", "Processing splat file..."));
 		SlowTask.MakeDialog(true);
 		SlowTask.EnterProgressFrame(1);
 
 		TArray<FTextureLocations> TexLocations;
-		Result = UParser::Preprocess3DGSModel(FullPath, bSuccess, OutputString, TexLocations);
+		Result = UParser::Preprocess3DGSModelWithSettings(FullPath, GetSettings(), bSuccess, OutputString, TexLocations);
 		AppendLog(FString::Printf(TEXT("Vertices processed: %d"), Result));
+		if (TexLocations.Num() > 1)
+		{
+			AppendLog(FString::Printf(TEXT("Texture pages: %d, one Niagara system each (Apply Texture Pages)"), TexLocations.Num()));
+		}
 	}
 
 	if (bSuccess)
@@ -475,4 +516,9 @@ FString SUnrealSplatWindow::GetDefaultModelName(const FString& FilePath)
 	return FPaths::GetBaseFilename(FilePath);
 }
 
+const FGaussianSplatPreprocessSettings& SUnrealSplatWindow::GetSettings() const
+{
+	return *reinterpret_cast<const FGaussianSplatPreprocessSettings*>(SettingsStruct->GetStructMemory());
+}
+
 #undef LOCTEXT_NAMESPACE
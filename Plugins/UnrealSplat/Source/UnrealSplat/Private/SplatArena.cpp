@@ -0,0 +1,107 @@
+// SplatArena.cpp
+
+#include "SplatArena.h"
+
+FSplatArena::FSplatArena(int64 InitialCapacity)
+	: Blocks()
+	, AllocatedBytes(0)
+	, ExternalBytes(0)
+	, PeakBytes(0)
+{
+	if (InitialCapacity > 0)
+	{
+		AddBlock(InitialCapacity);
+	}
+}
+
+FSplatArena::~FSplatArena()
+{
+	for (FBlock& Block : Blocks)
+	{
+		FMemory::Free(Block.Data);
+	}
+}
+
+void* FSplatArena::Allocate(int64 Bytes, int64 Alignment)
+{
+	check(Bytes >= 0 && FMath::IsPowerOfTwo(Alignment));
+
+	// Only the newest block is allocated from; earlier blocks are full or abandoned
+	FBlock* Block = Blocks.Num() > 0 ? &Blocks.Last() : nullptr;
+	int64 Offset = Block ? Align(Block->Used, Alignment) : 0;
+	if (!Block || Offset + Bytes > Block->Size)
+	{
+		// Grow geometrically so a badly underestimated job does not degrade into one block per request
+		AddBlock(FMath::Max(Bytes, Blocks.Num() > 0 ? Blocks.Last().Size * 2 : Bytes));
+		Block = &Blocks.Last();
+		Offset = 0;
+	}
+
+	AllocatedBytes += Offset + Bytes - Block->Used;
+	Block->Used = Offset + Bytes;
+	UpdatePeak();
+	return Block->Data + Offset;
+}
+
+void FSplatArena::Reserve(int64 Bytes)
+{
+	const FBlock* Block = Blocks.Num() > 0 ? &Blocks.Last() : nullptr;
+	if (Bytes > 0 && (!Block || Align(Block->Used, DefaultAlignment) + Bytes > Block->Size))
+	{
+		AddBlock(Bytes);
+	}
+}
+
+void FSplatArena::TrackExternalBytes(int64 Delta)
+{
+	ExternalBytes += Delta;
+	UpdatePeak();
+}
+
+void FSplatArena::Reset()
+{
+	for (int32 Index = 1; Index < Blocks.Num(); Index++)
+	{
+		FMemory::Free(Blocks[Index].Data);
+	}
+	if (Blocks.Num() > 1)
+	{
+		Blocks.SetNum(1);
+	}
+	if (Blocks.Num() > 0)
+	{
+		Blocks[0].Used = 0;
+	}
+	AllocatedBytes = 0;
+}
+
+int64 FSplatArena::GetCapacity() const
+{
+	int64 Capacity = 0;
+	for (const FBlock& Block : Blocks)
+	{
+		Capacity += Block.Size;
+	}
+	return Capacity;
+}
+
+FString FSplatArena::Describe() const
+{
+	constexpr double MB = 1024.0 * 1024.0;
+	return FString::Printf(TEXT("Memory (arena and tracked external buffers, a lower bound): peak %.1f MB, current %.1f MB (arena %.1f MB in %d block(s), external %.1f MB)"),
+		GetPeakBytes() / MB, GetCurrentBytes() / MB, GetCapacity() / MB, Blocks.Num(), ExternalBytes / MB);
+}
+
+void FSplatArena::AddBlock(int64 MinSize)
+{
+	FBlock Block;
+	Block.Size = Align(FMath::Max<int64>(MinSize, DefaultAlignment), DefaultAlignment);
+	Block.Data = static_cast<uint8*>(FMemory::Malloc(SIZE_T(Block.Size), DefaultAlignment));
+	Block.Used = 0;
+	Blocks.Add(Block);
+}
+
+void FSplatArena::UpdatePeak()
+{
+	PeakBytes = FMath::Max(PeakBytes, GetCurrentBytes());
+}
@@ -0,0 +1,346 @@
+// SplatCloudMerge.cpp
+
+#include "SplatCloudMerge.h"
+#include "GaussianSplatCloud.h"
+#include "GaussianSplatBuffer.h"
+#include "Parser.h"
+#include "SplatKernels.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Sort.h"
+#include "Algo/BinarySearch.h"
+
+static constexpr float SH_C0 = 0.28209479177387814f;
+
+static_assert(FSplatCloudMerge::NumShards == 64, "ShardOf() takes the top 6 bits of the hashed cell");
+
+// Grid cell of a position
+static FORCEINLINE FIntVector CellOf(const FVector3f& Position, float InvCellSize) {
+	return FIntVector(FMath::FloorToInt32(Position.X * InvCellSize), FMath::FloorToInt32(Position.Y * InvCellSize),
+		FMath::FloorToInt32(Position.Z * InvCellSize));
+}
+
+// Key of a grid cell, 21 bits per axis. Cells 2^21 apart share a key, which the distance test sorts out.
+static FORCEINLINE uint64 CellKey(const FIntVector& Cell) {
+	constexpr uint64 Mask = (uint64(1) << 21) - 1;
+	return (uint64(Cell.X) & Mask) | ((uint64(Cell.Y) & Mask) << 21) | ((uint64(Cell.Z) & Mask) << 42);
+}
+
+// Fibonacci hashing spreads neighbouring cells evenly over the shards
+static FORCEINLINE int32 ShardOf(uint64 Key) {
+	return int32((Key * 0x9E3779B97F4A7C15ull) >> 58);
+}
+
+UGaussianSplatCloud* FSplatCloudMerge::Concatenate(TConstArrayView<const UGaussianSplatCloud*> Sources, TConstArrayView<FTransform> Transforms,
+	TArray<int32>& OutSourceIndices, FString& OutError) {
+
+	OutSourceIndices.Reset();
+	if (Sources.Num() == 0) {
+		OutError = TEXT("No captures");
+		return nullptr;
+	}
+	if (Sources.Num() != Transforms.Num()) {
+		OutError = FString::Printf(TEXT("%d captures but %d transforms"), Sources.Num(), Transforms.Num());
+		return nullptr;
+	}
+
+	int64 TotalSplats = 0;
+	bool bOrientations = true;
+	bool bScales = true;
+	bool bOpacities = true;
+	bool bZeroOrderHarmonics = true;
+	int32 SHDegree = 3;
+	for (int32 SourceIndex = 0; SourceIndex < Sources.Num(); SourceIndex++) {
+		const UGaussianSplatCloud* Source = Sources[SourceIndex];
+		if (!Source || Source->GetPositions().Num() != Source->Num()) {
+			OutError = FString::Printf(TEXT("Capture %d has no positions"), SourceIndex);
+			return nullptr;
+		}
+		// A splat is an ellipsoid along its own axes, which only a uniform positive scale keeps aligned
+		const FVector Scale3D = Transforms[SourceIndex].GetScale3D();
+		if (Scale3D.GetMin() <= 0.0 || Scale3D.GetMax() - Scale3D.GetMin() > UE_KINDA_SMALL_NUMBER * Scale3D.GetMax()) {
+			OutError = FString::Printf(TEXT("The transform of capture %d scales by %s, only uniform positive scales are supported"),
+				SourceIndex, *Scale3D.ToString());
+			return nullptr;
+		}
+		TotalSplats += Source->Num();
+		bOrientations &= Source->GetOrientations().Num() == Source->Num();
+		bScales &= Source->GetScales().Num() == Source->Num();
+		bOpacities &= Source->GetOpacities().Num() == Source->Num();
+		bZeroOrderHarmonics &= Source->GetZeroOrderHarmonicsArray().Num() == Source->Num();
+		SHDegree = FMath::Min(SHDegree, Source->GetSHDegree());
+	}
+	if (TotalSplats > UGaussianSplatCloud::GetMaxSplats(SHDegree)) {
+		OutError = FString::Printf(TEXT("Too many splats in total (%lld)"), TotalSplats);
+		return nullptr;
+	}
+
+	UGaussianSplatCloud* Merged = NewObject<UGaussianSplatCloud>();
+	Merged->Allocate(int32(TotalSplats), true, false, bOrientations, bScales, bOpacities, bZeroOrderHarmonics, SHDegree);
+	OutSourceIndices.SetNumUninitialized(int32(TotalSplats));
+
+	TArrayView<FVector3f> Positions = Merged->GetPositions();
+	TArrayView<FQuat4f> Orientations = Merged->GetOrientations();
+	TArrayView<FVector3f> Scales = Merged->GetScales();
+	TArrayView<float> Opacities = Merged->GetOpacities();
+	TArrayView<FVector3f> ZeroOrderHarmonics = Merged->GetZeroOrderHarmonicsArray();
+	float* HigherOrderHarmonics = Merged->GetHigherOrderHarmonicsArray().GetData();
+	const int32 NumCoefficients = Merged->GetNumSHCoefficients();
+
+	int32 FirstSplat = 0;
+	for (int32 SourceIndex = 0; SourceIndex < Sources.Num(); SourceIndex++) {
+		const UGaussianSplatCloud& Source = *Sources[SourceIndex];
+		const FTransform3f Transform(Transforms[SourceIndex]);
+		const FQuat4f Rotation = Transform.GetRotation();
+		const float Scale = Transform.GetScale3D().X;
+		const bool bRotateHarmonics = NumCoefficients > 0 && !Rotation.IsIdentity(UE_KINDA_SMALL_NUMBER);
+		const SplatKernels::FSHRotation HarmonicsRotation(Rotation);
+		const int32 SourceCoefficients = Source.GetNumSHCoefficients();
+		const int32 NumSplats = Source.Num();
+
+		ParallelFor(FGaussianSplatBuffer::NumTasks(NumSplats), [&](int32 Task) {
+			const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+			const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumSplats);
+			for (int32 i = Begin; i < End; i++) {
+				const int32 Out = FirstSplat + i;
+				OutSourceIndices[Out] = SourceIndex;
+				Positions[Out] = Transform.TransformPosition(Source.GetPositions()[i]);
+				if (bOrientations) {
+					Orientations[Out] = (Rotation * Source.GetOrientations()[i]).GetNormalized();
+				}
+				if (bScales) {
+					Scales[Out] = Source.GetScales()[i] * Scale;
+				}
+				if (bOpacities) {
+					Opacities[Out] = Source.GetOpacities()[i];
+				}
+				if (bZeroOrderHarmonics) {
+					ZeroOrderHarmonics[Out] = Source.GetZeroOrderHarmonicsArray()[i];
+				}
+				// Coefficients are ordered by band, so the lower bands are a prefix of every splat's triplets
+				const float* SourceHarmonics = Source.GetHigherOrderHarmonicsArray().GetData() + SIZE_T(i) * SourceCoefficients * 3;
+				float* MergedHarmonics = HigherOrderHarmonics + SIZE_T(Out) * NumCoefficients * 3;
+				if (bRotateHarmonics) {
+					HarmonicsRotation.Apply(SourceHarmonics, NumCoefficients, MergedHarmonics);
+				} else {
+					FMemory::Memcpy(MergedHarmonics, SourceHarmonics, NumCoefficients * 3 * sizeof(float));
+				}
+			}
+		});
+		FirstSplat += NumSplats;
+	}
+	return Merged;
+}
+
+int32 FSplatCloudMerge::FindOverlaps(const UGaussianSplatCloud& Cloud, TConstArrayView<int32> SourceIndices, const FGaussianSplatMergeSettings& Settings,
+	TArray<bool>& OutRemoved) {
+
+	const int32 NumSplats = Cloud.Num();
+	OutRemoved.Init(false, NumSplats);
+	if (NumSplats == 0 || SourceIndices.Num() != NumSplats || Settings.CellSize <= 0.0f) {
+		return 0;
+	}
+
+	TConstArrayView<FVector3f> Positions = Cloud.GetPositions();
+	TConstArrayView<FVector3f> Scales = Cloud.GetScales();
+	TConstArrayView<float> Opacities = Cloud.GetOpacities();
+	TConstArrayView<FVector3f> ZeroOrderHarmonics = Cloud.GetZeroOrderHarmonicsArray();
+
+	// Cell of every splat and the shard its cell hashes to
+	const float InvCellSize = 1.0f / Settings.CellSize;
+	TArray<FIntVector> Cells;
+	TArray<uint64> Keys;
+	TArray<uint8> Shards;
+	Cells.SetNumUninitialized(NumSplats);
+	Keys.SetNumUninitialized(NumSplats);
+	Shards.SetNumUninitialized(NumSplats);
+	ParallelFor(FGaussianSplatBuffer::NumTasks(NumSplats), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumSplats);
+		for (int32 i = Begin; i < End; i++) {
+			Cells[i] = CellOf(Positions[i], InvCellSize);
+			Keys[i] = CellKey(Cells[i]);
+			Shards[i] = uint8(ShardOf(Keys[i]));
+		}
+	});
+
+	// Counting sort of the splats by shard
+	TArray<int32> ShardStart;
+	ShardStart.SetNumZeroed(NumShards + 1);
+	for (int32 i = 0; i < NumSplats; i++) {
+		ShardStart[Shards[i] + 1]++;
+	}
+	for (int32 Shard = 0; Shard < NumShards; Shard++) {
+		ShardStart[Shard + 1] += ShardStart[Shard];
+	}
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumSplats);
+	TArray<int32> ShardNext(ShardStart);
+	for (int32 i = 0; i < NumSplats; i++) {
+		Order[ShardNext[Shards[i]]++] = i;
+	}
+
+	const float MaxDistanceSquared = FMath::Square(Settings.CellSize);
+	auto SizeRatio = [](float A, float B) {
+		return FMath::Max(A, B) / FMath::Max(FMath::Min(A, B), UE_SMALL_NUMBER);
+	};
+	auto IsDuplicate = [&](int32 A, int32 B) {
+		if (FVector3f::DistSquared(Positions[A], Positions[B]) > MaxDistanceSquared) {
+			return false;
+		}
+		if (ZeroOrderHarmonics.Num() > 0 && ((ZeroOrderHarmonics[A] - ZeroOrderHarmonics[B]).GetAbs() * SH_C0).GetMax() > Settings.MaxColorDifference) {
+			return false;
+		}
+		// Largest and smallest axis, so the comparison does not depend on how either splat is rotated
+		if (Scales.Num() > 0 && (SizeRatio(Scales[A].GetMax(), Scales[B].GetMax()) > Settings.MaxScaleRatio
+			|| SizeRatio(Scales[A].GetMin(), Scales[B].GetMin()) > Settings.MaxScaleRatio)) {
+			return false;
+		}
+		return true;
+	};
+
+	// A cell is a run of equal keys in its shard once every shard is sorted by key
+	ParallelFor(NumShards, [&](int32 Shard) {
+		TArrayView<int32> Indices(Order.GetData() + ShardStart[Shard], ShardStart[Shard + 1] - ShardStart[Shard]);
+		Algo::Sort(Indices, [&](int32 A, int32 B) {
+			return Keys[A] != Keys[B] ? Keys[A] < Keys[B] : A < B;
+		});
+	});
+	auto FindCell = [&](uint64 Key) {
+		const int32 Shard = ShardOf(Key);
+		const TConstArrayView<int32> Indices(Order.GetData() + ShardStart[Shard], ShardStart[Shard + 1] - ShardStart[Shard]);
+		const int32 Begin = Algo::LowerBoundBy(Indices, Key, [&](int32 Index) { return Keys[Index]; });
+		int32 End = Begin;
+		while (End < Indices.Num() && Keys[Indices[End]] == Key) {
+			End++;
+		}
+		return Indices.Slice(Begin, End - Begin);
+	};
+
+	// Of two duplicates the more opaque one is kept, the lower index on a tie
+	auto IsPreferred = [&](int32 A, int32 B) {
+		const float OpacityA = Opacities.Num() > 0 ? Opacities[A] : 1.0f;
+		const float OpacityB = Opacities.Num() > 0 ? Opacities[B] : 1.0f;
+		return OpacityA != OpacityB ? OpacityA > OpacityB : A < B;
+	};
+
+	// Duplicates within MaxDistance can sit in any of the 27 cells around a splat. Every splat collects the
+	// preferred duplicates of other sources there, in parallel and without writes to shared state.
+	const int32 NumTasks = FGaussianSplatBuffer::NumTasks(NumSplats);
+	TArray<TArray<TPair<int32, int32>>> TaskDuplicates;
+	TaskDuplicates.SetNum(NumTasks);
+	ParallelFor(NumTasks, [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumSplats);
+		for (int32 i = Begin; i < End; i++) {
+			for (int32 z = -1; z <= 1; z++) {
+				for (int32 y = -1; y <= 1; y++) {
+					for (int32 x = -1; x <= 1; x++) {
+						for (int32 Other : FindCell(CellKey(Cells[i] + FIntVector(x, y, z)))) {
+							if (SourceIndices[Other] != SourceIndices[i] && IsPreferred(Other, i) && IsDuplicate(Other, i)) {
+								TaskDuplicates[Task].Emplace(i, Other);
+							}
+						}
+					}
+				}
+			}
+		}
+	});
+
+	// Tasks cover ascending rows, so their lists concatenate into one sorted by splat
+	TArray<int32> DuplicateStart;
+	DuplicateStart.SetNumZeroed(NumSplats + 1);
+	TArray<int32> Duplicates;
+	TArray<int32> Candidates;
+	int32 NumDuplicates = 0;
+	for (const TArray<TPair<int32, int32>>& Pairs : TaskDuplicates) {
+		NumDuplicates += Pairs.Num();
+	}
+	Duplicates.Reserve(NumDuplicates);
+	for (const TArray<TPair<int32, int32>>& Pairs : TaskDuplicates) {
+		for (const TPair<int32, int32>& Pair : Pairs) {
+			if (Candidates.Num() == 0 || Candidates.Last() != Pair.Key) {
+				Candidates.Add(Pair.Key);
+			}
+			DuplicateStart[Pair.Key + 1]++;
+			Duplicates.Add(Pair.Value);
+		}
+	}
+	TaskDuplicates.Empty();
+	for (int32 i = 0; i < NumSplats; i++) {
+		DuplicateStart[i + 1] += DuplicateStart[i];
+	}
+
+	// A splat is removed if one of its preferred duplicates is kept. Going from the most preferred splat down,
+	// every duplicate is decided before the splats it would remove; splats without duplicates are always kept.
+	Algo::Sort(Candidates, IsPreferred);
+	int32 NumRemoved = 0;
+	for (int32 Candidate : Candidates) {
+		for (int32 d = DuplicateStart[Candidate]; d < DuplicateStart[Candidate + 1]; d++) {
+			if (!OutRemoved[Duplicates[d]]) {
+				OutRemoved[Candidate] = true;
+				NumRemoved++;
+				break;
+			}
+		}
+	}
+	return NumRemoved;
+}
+
+UGaussianSplatCloud* FSplatCloudMerge::Compact(const UGaussianSplatCloud& Cloud, TConstArrayView<bool> Removed) {
+	TArray<int32> Kept;
+	Kept.Reserve(Cloud.Num());
+	for (int32 i = 0; i < Cloud.Num(); i++) {
+		if (!Removed[i]) {
+			Kept.Add(i);
+		}
+	}
+
+	TConstArrayView<FVector3f> InPositions = Cloud.GetPositions();
+	TConstArrayView<FVector3f> InNormals = Cloud.GetNormals();
+	TConstArrayView<FQuat4f> InOrientations = Cloud.GetOrientations();
+	TConstArrayView<FVector3f> InScales = Cloud.GetScales();
+	TConstArrayView<float> InOpacities = Cloud.GetOpacities();
+	TConstArrayView<FVector3f> InZeroOrderHarmonics = Cloud.GetZeroOrderHarmonicsArray();
+	const float* InHigherOrderHarmonics = Cloud.GetHigherOrderHarmonicsArray().GetData();
+
+	UGaussianSplatCloud* Result = NewObject<UGaussianSplatCloud>();
+	Result->Allocate(Kept.Num(), InPositions.Num() > 0, InNormals.Num() > 0, InOrientations.Num() > 0, InScales.Num() > 0,
+		InOpacities.Num() > 0, InZeroOrderHarmonics.Num() > 0, Cloud.GetSHDegree());
+
+	TArrayView<FVector3f> Positions = Result->GetPositions();
+	TArrayView<FVector3f> Normals = Result->GetNormals();
+	TArrayView<FQuat4f> Orientations = Result->GetOrientations();
+	TArrayView<FVector3f> Scales = Result->GetScales();
+	TArrayView<float> Opacities = Result->GetOpacities();
+	TArrayView<FVector3f> ZeroOrderHarmonics = Result->GetZeroOrderHarmonicsArray();
+	float* HigherOrderHarmonics = Result->GetHigherOrderHarmonicsArray().GetData();
+	const int32 NumValues = Cloud.GetNumSHCoefficients() * 3;
+
+	ParallelFor(FGaussianSplatBuffer::NumTasks(Kept.Num()), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, Kept.Num());
+		for (int32 Out = Begin; Out < End; Out++) {
+			const int32 In = Kept[Out];
+			if (Positions.Num() > 0) {
+				Positions[Out] = InPositions[In];
+			}
+			if (Normals.Num() > 0) {
+				Normals[Out] = InNormals[In];
+			}
+			if (Orientations.Num() > 0) {
+				Orientations[Out] = InOrientations[In];
+			}
+			if (Scales.Num() > 0) {
+				Scales[Out] = InScales[In];
+			}
+			if (Opacities.Num() > 0) {
+				Opacities[Out] = InOpacities[In];
+			}
+			if (ZeroOrderHarmonics.Num() > 0) {
+				ZeroOrderHarmonics[Out] = InZeroOrderHarmonics[In];
+			}
+			FMemory::Memcpy(HigherOrderHarmonics + SIZE_T(Out) * NumValues, InHigherOrderHarmonics + SIZE_T(In) * NumValues, NumValues * sizeof(float));
+		}
+	});
+	return Result;
+}
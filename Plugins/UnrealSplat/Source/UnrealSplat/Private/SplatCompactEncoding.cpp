@@ -0,0 +1,112 @@
+// SplatCompactEncoding.cpp
+
+#include "SplatCompactEncoding.h"
+#include "Async/ParallelFor.h"
+
+FORCEINLINE static uint32 QuantizeUnorm(float Value, uint32 MaxValue) {
+	return uint32(FMath::RoundToInt(FMath::Clamp(Value, 0.0f, 1.0f) * float(MaxValue)));
+}
+
+uint32 FSplatCompactEncoding::EncodeUnorm111110(const FVector3f& Normalized) {
+	return QuantizeUnorm(Normalized.X, 2047) << 21 | QuantizeUnorm(Normalized.Y, 2047) << 10 | QuantizeUnorm(Normalized.Z, 1023);
+}
+
+FVector3f FSplatCompactEncoding::DecodeUnorm111110(uint32 Word) {
+	return FVector3f(float(Word >> 21) / 2047.0f, float((Word >> 10) & 2047) / 2047.0f, float(Word & 1023) / 1023.0f);
+}
+
+uint32 FSplatCompactEncoding::EncodeRotation(const FQuat4f& Rotation) {
+	const float Components[4] = { Rotation.X, Rotation.Y, Rotation.Z, Rotation.W };
+	int32 Largest = 0;
+	for (int32 c = 1; c < 4; c++) {
+		if (FMath::Abs(Components[c]) > FMath::Abs(Components[Largest])) {
+			Largest = c;
+		}
+	}
+	const float Sign = Components[Largest] < 0.0f ? -1.0f : 1.0f;
+	uint32 Word = uint32(Largest) << 30;
+	int32 Shift = 0;
+	for (int32 c = 0; c < 4; c++) {
+		if (c != Largest) {
+			Word |= QuantizeUnorm((Sign * Components[c] * UE_SQRT_2 + 1.0f) * 0.5f, 1023) << Shift;
+			Shift += 10;
+		}
+	}
+	return Word;
+}
+
+FQuat4f FSplatCompactEncoding::DecodeRotation(uint32 Word) {
+	const int32 Largest = int32(Word >> 30);
+	float Components[4];
+	float SumSquares = 0.0f;
+	int32 Shift = 0;
+	for (int32 c = 0; c < 4; c++) {
+		if (c != Largest) {
+			Components[c] = (float((Word >> Shift) & 1023) / 1023.0f * 2.0f - 1.0f) * UE_INV_SQRT_2;
+			SumSquares += Components[c] * Components[c];
+			Shift += 10;
+		}
+	}
+	Components[Largest] = FMath::Sqrt(FMath::Max(1.0f - SumSquares, 0.0f));
+	return FQuat4f(Components[0], Components[1], Components[2], Components[3]);
+}
+
+FColor FSplatCompactEncoding::EncodeColor(const FVector3f& NormalizedDC, float Opacity) {
+	return FColor(uint8(QuantizeUnorm(NormalizedDC.X, 255)), uint8(QuantizeUnorm(NormalizedDC.Y, 255)), uint8(QuantizeUnorm(NormalizedDC.Z, 255)),
+		uint8(QuantizeUnorm(Opacity, 255)));
+}
+
+FVector3f FSplatCompactEncoding::DecodeColor(const FColor& Color, float& OutOpacity) {
+	OutOpacity = float(Color.A) / 255.0f;
+	return FVector3f(float(Color.R), float(Color.G), float(Color.B)) / 255.0f;
+}
+
+FVector3f FSplatCompactEncoding::GetNormalizationScale(const FVector3f& Min, const FVector3f& Max) {
+	const FVector3f Size = Max - Min;
+	return FVector3f(Size.X > 0.0f ? 1.0f / Size.X : 0.0f, Size.Y > 0.0f ? 1.0f / Size.Y : 0.0f, Size.Z > 0.0f ? 1.0f / Size.Z : 0.0f);
+}
+
+// Spreads the low 21 bits of Value to every third bit
+FORCEINLINE static uint64 SpreadBits3(uint64 Value) {
+	Value &= 0x1FFFFF;
+	Value = (Value | Value << 32) & 0x1F00000000FFFFull;
+	Value = (Value | Value << 16) & 0x1F0000FF0000FFull;
+	Value = (Value | Value << 8) & 0x100F00F00F00F00Full;
+	Value = (Value | Value << 4) & 0x10C30C30C30C30C3ull;
+	Value = (Value | Value << 2) & 0x1249249249249249ull;
+	return Value;
+}
+
+void FSplatCompactEncoding::GetMortonOrder(const FLinearColor* Positions, int32 NumSplats, TArray<int32>& OutOrder) {
+	FVector3f Min(MAX_flt), Max(-MAX_flt);
+	for (int32 i = 0; i < NumSplats; i++) {
+		const FVector3f Position(Positions[i].R, Positions[i].G, Positions[i].B);
+		Min = Min.ComponentMin(Position);
+		Max = Max.ComponentMax(Position);
+	}
+	const FVector3f Scale = GetNormalizationScale(Min, Max);
+
+	// Ties keep their original order, so the result does not depend on the sort
+	struct FMortonKey {
+		uint64 Code;
+		int32 Index;
+		bool operator<(const FMortonKey& Other) const {
+			return Code != Other.Code ? Code < Other.Code : Index < Other.Index;
+		}
+	};
+	TArray<FMortonKey> Keys;
+	Keys.SetNumUninitialized(NumSplats);
+	ParallelFor(NumSplats, [&](int32 i) {
+		const FVector3f Normalized = (FVector3f(Positions[i].R, Positions[i].G, Positions[i].B) - Min) * Scale;
+		constexpr uint32 MaxCell = (1u << 21) - 1;
+		Keys[i].Code = SpreadBits3(QuantizeUnorm(Normalized.X, MaxCell)) | SpreadBits3(QuantizeUnorm(Normalized.Y, MaxCell)) << 1
+			| SpreadBits3(QuantizeUnorm(Normalized.Z, MaxCell)) << 2;
+		Keys[i].Index = i;
+	});
+	Keys.Sort();
+
+	OutOrder.SetNumUninitialized(NumSplats);
+	for (int32 k = 0; k < NumSplats; k++) {
+		OutOrder[k] = Keys[k].Index;
+	}
+}
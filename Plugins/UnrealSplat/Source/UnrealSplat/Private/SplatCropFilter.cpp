@@ -0,0 +1,69 @@
+// SplatCropFilter.cpp
+
+#include "SplatCropFilter.h"
+#include "Parser.h"
+#include "GaussianSplatBuffer.h"
+#include "Async/ParallelFor.h"
+
+bool FSplatCropFilter::FVolume::Contains(const FVector3f& Position) const {
+	// Scale is part of the transform, so the test runs against the unscaled shape in local space
+	const FVector3f Local = Transform.InverseTransformPosition(Position);
+	if (bSphere) {
+		return Local.SizeSquared() <= SphereRadiusSquared;
+	}
+	return FMath::Abs(Local.X) <= BoxExtent.X && FMath::Abs(Local.Y) <= BoxExtent.Y && FMath::Abs(Local.Z) <= BoxExtent.Z;
+}
+
+FSplatCropFilter::FSplatCropFilter(TConstArrayView<FGaussianSplatCropVolume> InVolumes)
+	: Volumes()
+	, bHasInclusive(false)
+{
+	for (const FGaussianSplatCropVolume& InVolume : InVolumes) {
+		FVolume& Volume = Volumes.AddDefaulted_GetRef();
+		Volume.Transform = FTransform3f(InVolume.Transform);
+		Volume.BoxExtent = FVector3f(InVolume.BoxExtent);
+		Volume.SphereRadiusSquared = FMath::Square(InVolume.SphereRadius);
+		Volume.bSphere = InVolume.Shape == EGaussianSplatCropShape::Sphere;
+		Volume.bExclude = InVolume.bExclude;
+		bHasInclusive |= !InVolume.bExclude;
+	}
+}
+
+bool FSplatCropFilter::Contains(const FVector3f& Position) const {
+	bool bIncluded = !bHasInclusive;
+	for (const FVolume& Volume : Volumes) {
+		if (Volume.bExclude) {
+			if (Volume.Contains(Position)) {
+				return false;
+			}
+		}
+		else if (!bIncluded) {
+			bIncluded = Volume.Contains(Position);
+		}
+	}
+	return bIncluded;
+}
+
+int32 FSplatCropFilter::FilterPositions(const float* X, const float* Y, const float* Z, int32 NumSplats, bool* OutKeep) const {
+	const int32 NumTasks = FGaussianSplatBuffer::NumTasks(NumSplats);
+	TArray<int32, TInlineAllocator<8>> TaskKept;
+	TaskKept.SetNumZeroed(NumTasks);
+
+	ParallelFor(NumTasks, [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumSplats);
+		int32 Kept = 0;
+		for (int32 i = Begin; i < End; i++) {
+			// Same conversion as the position texture: 100 * (x, -z, -y)
+			OutKeep[i] = Contains(100.0f * FVector3f(X[i], -Z[i], -Y[i]));
+			Kept += OutKeep[i] ? 1 : 0;
+		}
+		TaskKept[Task] = Kept;
+	});
+
+	int32 NumKept = 0;
+	for (int32 Kept : TaskKept) {
+		NumKept += Kept;
+	}
+	return NumKept;
+}
@@ -0,0 +1,681 @@
+// SplatKernels.cpp
+
+#include "SplatKernels.h"
+#include "HAL/IConsoleManager.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#define SPLAT_KERNELS_SIMD 1
+#elif PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#include <immintrin.h>
+#define SPLAT_KERNELS_SIMD 1
+#else
+#define SPLAT_KERNELS_SIMD 0
+#endif
+
+static TAutoConsoleVariable<bool> CVarSplatReferenceKernels(
+	TEXT("UnrealSplat.ReferenceKernels"),
+	false,
+	TEXT("Convert splats with the scalar reference kernels instead of the SIMD ones, e.g. to validate them."));
+
+// ---------- Reference Kernels ----------
+
+void SplatKernels::Reference::ConvertPositions(const float* X, const float* Y, const float* Z, int32 Num, FLinearColor* Out)
+{
+	for (int32 i = 0; i < Num; i++)
+	{
+		Out[i] = 100.0f * FLinearColor(X[i], -Z[i], -Y[i]);
+	}
+}
+
+void SplatKernels::Reference::ConvertScales(const float* Scale0, const float* Scale1, const float* Scale2, int32 Num, FLinearColor* Out)
+{
+	for (int32 i = 0; i < Num; i++)
+	{
+		Out[i] = 100.0f * FLinearColor(FMath::Exp(Scale0[i]), FMath::Exp(Scale2[i]), FMath::Exp(Scale1[i]));
+	}
+}
+
+void SplatKernels::Reference::ConvertRotations(const float* Rot0, const float* Rot1, const float* Rot2, const float* Rot3, int32 Num, FLinearColor* Out)
+{
+	for (int32 i = 0; i < Num; i++)
+	{
+		FQuat Rot = FQuat(Rot1[i], Rot2[i], Rot3[i], Rot0[i]);
+		Rot.Normalize();
+		Out[i] = FLinearColor(Rot.X, -Rot.Z, -Rot.Y, Rot.W);
+	}
+}
+
+void SplatKernels::Reference::ConvertColors(const float* DC0, const float* DC1, const float* DC2, const float* Opacity, int32 Num, FLinearColor* Out)
+{
+	for (int32 i = 0; i < Num; i++)
+	{
+		float Alpha = FMath::Clamp(1.0f / (1.0f + FMath::Exp(-Opacity[i])), 0.0f, 1.0f);
+		Out[i] = FLinearColor(DC0[i], DC1[i], DC2[i], Alpha);
+	}
+}
+
+void SplatKernels::Reference::EncodeHalf(const FLinearColor* In, int32 Num, const FLinearColor& Offset, const FLinearColor& Scale, FFloat16Color* Out)
+{
+	for (int32 i = 0; i < Num; i++)
+	{
+		Out[i] = FFloat16Color((In[i] - Offset) * Scale);
+	}
+}
+
+// ---------- Spherical Harmonics ----------
+
+// Real SH basis constants used by the INRIA renderer
+static constexpr float SH_C0 = 0.28209479177387814f;
+static constexpr float SH_C1 = 0.4886025119029199f;
+static constexpr float SH_C2[] = { 1.0925484305920792f, -1.0925484305920792f, 0.31539156525252005f, -1.0925484305920792f, 0.5462742152960396f };
+static constexpr float SH_C3[] = { -0.5900435899266435f, 2.890611442640554f, -0.4570457994644658f, 0.3731763325901154f, -0.4570457994644658f, 1.445305721320277f, -0.5900435899266435f };
+
+// Higher order coefficients per color channel up to Degree
+template <int32 Degree>
+static constexpr int32 NumSHCoefficients = (Degree + 1) * (Degree + 1) - 1;
+
+// Higher order SH basis functions up to Degree for the unit direction (X, Y, Z) in the PLY frame, in f_rest_* order.
+// T is float for the reference path and a SIMD vector wrapper for the kernels.
+template <int32 Degree, typename T>
+FORCEINLINE static void SHBasis(T X, T Y, T Z, T* Basis)
+{
+	if constexpr (Degree >= 1)
+	{
+		Basis[0] = T(-SH_C1) * Y;
+		Basis[1] = T(SH_C1) * Z;
+		Basis[2] = T(-SH_C1) * X;
+	}
+	if constexpr (Degree >= 2)
+	{
+		const T XX = X * X, YY = Y * Y, ZZ = Z * Z;
+		Basis[3] = T(SH_C2[0]) * (X * Y);
+		Basis[4] = T(SH_C2[1]) * (Y * Z);
+		Basis[5] = T(SH_C2[2]) * (T(2.0f) * ZZ - XX - YY);
+		Basis[6] = T(SH_C2[3]) * (X * Z);
+		Basis[7] = T(SH_C2[4]) * (XX - YY);
+		if constexpr (Degree >= 3)
+		{
+			Basis[8] = T(SH_C3[0]) * Y * (T(3.0f) * XX - YY);
+			Basis[9] = T(SH_C3[1]) * X * Y * Z;
+			Basis[10] = T(SH_C3[2]) * Y * (T(4.0f) * ZZ - XX - YY);
+			Basis[11] = T(SH_C3[3]) * Z * (T(2.0f) * ZZ - T(3.0f) * XX - T(3.0f) * YY);
+			Basis[12] = T(SH_C3[4]) * X * (T(4.0f) * ZZ - XX - YY);
+			Basis[13] = T(SH_C3[5]) * Z * (XX - YY);
+			Basis[14] = T(SH_C3[6]) * X * (XX - T(3.0f) * YY);
+		}
+	}
+}
+
+// Color of one splat seen along Direction (Unreal space, any length)
+template <int32 Degree>
+static FLinearColor EvaluateSHReference(const FVector3f& DC, const float* Rest, const FVector3f& Direction)
+{
+	const FVector3f Dir = Direction.GetSafeNormal();
+	float Basis[NumSHCoefficients<3>];
+	SHBasis<Degree>(Dir.X, -Dir.Z, -Dir.Y, Basis);
+
+	FVector3f Color = SH_C0 * DC;
+	for (int32 y = 0; y < NumSHCoefficients<Degree>; y++)
+	{
+		Color += Basis[y] * FVector3f(Rest[3 * y], Rest[3 * y + 1], Rest[3 * y + 2]);
+	}
+	return FLinearColor(FMath::Max(Color.X + 0.5f, 0.0f), FMath::Max(Color.Y + 0.5f, 0.0f), FMath::Max(Color.Z + 0.5f, 0.0f));
+}
+
+template <int32 Degree>
+void SplatKernels::Reference::EvaluateSH(TConstArrayView<FVector3f> ZeroOrder, TConstArrayView<float> HigherOrder, int32 CoefficientStride,
+	const FVector3f& ViewDirection, TArrayView<FLinearColor> Out)
+{
+	for (int32 i = 0; i < Out.Num(); i++)
+	{
+		const float* Rest = Degree > 0 ? HigherOrder.GetData() + SIZE_T(i) * CoefficientStride * 3 : nullptr;
+		Out[i] = EvaluateSHReference<Degree>(ZeroOrder[i], Rest, ViewDirection);
+	}
+}
+
+template <int32 Degree>
+void SplatKernels::Reference::EvaluateSH(TConstArrayView<FVector3f> ZeroOrder, TConstArrayView<float> HigherOrder, int32 CoefficientStride,
+	TConstArrayView<FVector3f> Positions, const FVector3f& CameraPosition, TArrayView<FLinearColor> Out)
+{
+	for (int32 i = 0; i < Out.Num(); i++)
+	{
+		const float* Rest = Degree > 0 ? HigherOrder.GetData() + SIZE_T(i) * CoefficientStride * 3 : nullptr;
+		Out[i] = EvaluateSHReference<Degree>(ZeroOrder[i], Rest, Positions[i] - CameraPosition);
+	}
+}
+
+// ---------- Spherical Harmonics Rotation ----------
+
+// Fits the N x N matrix of the band whose basis functions start at f_rest_* index First.
+// A band rotated by R satisfies SH'(dir) = SH(R^-1 dir), which is linear in the band's coefficients,
+// so the matrix is the least squares solution of that equation over directions spread over the sphere.
+template <int32 N>
+static void FitSHBandRotation(const FQuat4d& Rotation, int32 First, float (&OutMatrix)[N][N])
+{
+	constexpr int32 NumDirections = 64;
+	double Normal[N][N] = {};
+	double RightHandSide[N][N] = {};
+	for (int32 k = 0; k < NumDirections; k++)
+	{
+		// Fibonacci sphere, in the PLY frame
+		const double Z = 1.0 - (2.0 * k + 1.0) / NumDirections;
+		const double Radius = FMath::Sqrt(1.0 - Z * Z);
+		const double Angle = k * UE_DOUBLE_PI * (3.0 - FMath::Sqrt(5.0));
+		const FVector3d Direction(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), Z);
+
+		// The swap between the frames is its own inverse: (x, y, z) -> (x, -z, -y)
+		const FVector3d Source = Rotation.UnrotateVector(FVector3d(Direction.X, -Direction.Z, -Direction.Y));
+
+		double Basis[NumSHCoefficients<3>];
+		double SourceBasis[NumSHCoefficients<3>];
+		SHBasis<3>(Direction.X, Direction.Y, Direction.Z, Basis);
+		SHBasis<3>(Source.X, -Source.Z, -Source.Y, SourceBasis);
+		for (int32 Row = 0; Row < N; Row++)
+		{
+			for (int32 Column = 0; Column < N; Column++)
+			{
+				Normal[Row][Column] += Basis[First + Row] * Basis[First + Column];
+				RightHandSide[Row][Column] += Basis[First + Row] * SourceBasis[First + Column];
+			}
+		}
+	}
+
+	// Gauss-Jordan elimination; the normal matrix is symmetric positive definite, so no pivoting
+	for (int32 Pivot = 0; Pivot < N; Pivot++)
+	{
+		for (int32 Row = 0; Row < N; Row++)
+		{
+			if (Row == Pivot)
+			{
+				continue;
+			}
+			const double Factor = Normal[Row][Pivot] / Normal[Pivot][Pivot];
+			for (int32 Column = 0; Column < N; Column++)
+			{
+				Normal[Row][Column] -= Factor * Normal[Pivot][Column];
+				RightHandSide[Row][Column] -= Factor * RightHandSide[Pivot][Column];
+			}
+		}
+	}
+	for (int32 Row = 0; Row < N; Row++)
+	{
+		for (int32 Column = 0; Column < N; Column++)
+		{
+			OutMatrix[Row][Column] = float(RightHandSide[Row][Column] / Normal[Row][Row]);
+		}
+	}
+}
+
+template <int32 N>
+static void RotateSHBand(const float (&Matrix)[N][N], const float* In, float* Out)
+{
+	for (int32 Row = 0; Row < N; Row++)
+	{
+		FVector3f Sum(0.0f);
+		for (int32 Column = 0; Column < N; Column++)
+		{
+			Sum += Matrix[Row][Column] * FVector3f(In[3 * Column], In[3 * Column + 1], In[3 * Column + 2]);
+		}
+		Out[3 * Row] = Sum.X;
+		Out[3 * Row + 1] = Sum.Y;
+		Out[3 * Row + 2] = Sum.Z;
+	}
+}
+
+SplatKernels::FSHRotation::FSHRotation(const FQuat4f& Rotation)
+{
+	const FQuat4d Normalized = FQuat4d(Rotation).GetNormalized();
+	FitSHBandRotation(Normalized, 0, Band1);
+	FitSHBandRotation(Normalized, 3, Band2);
+	FitSHBandRotation(Normalized, 8, Band3);
+}
+
+void SplatKernels::FSHRotation::Apply(const float* In, int32 NumCoefficients, float* Out) const
+{
+	check(NumCoefficients == 0 || NumCoefficients == 3 || NumCoefficients == 8 || NumCoefficients == 15);
+	if (NumCoefficients >= 3)
+	{
+		RotateSHBand(Band1, In, Out);
+	}
+	if (NumCoefficients >= 8)
+	{
+		RotateSHBand(Band2, In + 3 * 3, Out + 3 * 3);
+	}
+	if (NumCoefficients >= 15)
+	{
+		RotateSHBand(Band3, In + 8 * 3, Out + 8 * 3);
+	}
+}
+
+#if SPLAT_KERNELS_SIMD
+
+// ---------- SIMD Primitives ----------
+
+namespace
+{
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+
+	typedef float32x4_t VecF;
+	typedef uint32x4_t VecMask;
+	constexpr int32 Lanes = 4;
+
+	FORCEINLINE VecF Load(const float* P) { return vld1q_f32(P); }
+	FORCEINLINE void Store(float* P, VecF V) { vst1q_f32(P, V); }
+	FORCEINLINE VecF Set(float V) { return vdupq_n_f32(V); }
+	FORCEINLINE VecF Add(VecF A, VecF B) { return vaddq_f32(A, B); }
+	FORCEINLINE VecF Sub(VecF A, VecF B) { return vsubq_f32(A, B); }
+	FORCEINLINE VecF Mul(VecF A, VecF B) { return vmulq_f32(A, B); }
+	FORCEINLINE VecF Div(VecF A, VecF B) { return vdivq_f32(A, B); }
+	FORCEINLINE VecF Min(VecF A, VecF B) { return vminq_f32(A, B); }
+	FORCEINLINE VecF Max(VecF A, VecF B) { return vmaxq_f32(A, B); }
+	FORCEINLINE VecF Sqrt(VecF A) { return vsqrtq_f32(A); }
+	FORCEINLINE VecF Floor(VecF A) { return vrndmq_f32(A); }
+	FORCEINLINE VecMask GreaterEqual(VecF A, VecF B) { return vcgeq_f32(A, B); }
+	FORCEINLINE VecF Select(VecMask Mask, VecF A, VecF B) { return vbslq_f32(Mask, A, B); }
+
+	// 2^N for integral N in [-126, 127], built directly in the exponent bits
+	FORCEINLINE VecF Pow2(VecF N)
+	{
+		return vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(N), vdupq_n_s32(127)), 23));
+	}
+
+	// Writes Lanes texels, taking channel c of texel i from lane i of the c-th vector
+	FORCEINLINE void StoreTexels(FLinearColor* Out, VecF R, VecF G, VecF B, VecF A)
+	{
+		float32x4x4_t Texels = { { R, G, B, A } };
+		vst4q_f32(reinterpret_cast<float*>(Out), Texels);
+	}
+
+#elif PLATFORM_ALWAYS_HAS_AVX_2
+
+	typedef __m256 VecF;
+	typedef __m256 VecMask;
+	constexpr int32 Lanes = 8;
+
+	FORCEINLINE VecF Load(const float* P) { return _mm256_loadu_ps(P); }
+	FORCEINLINE void Store(float* P, VecF V) { _mm256_storeu_ps(P, V); }
+	FORCEINLINE VecF Set(float V) { return _mm256_set1_ps(V); }
+	FORCEINLINE VecF Add(VecF A, VecF B) { return _mm256_add_ps(A, B); }
+	FORCEINLINE VecF Sub(VecF A, VecF B) { return _mm256_sub_ps(A, B); }
+	FORCEINLINE VecF Mul(VecF A, VecF B) { return _mm256_mul_ps(A, B); }
+	FORCEINLINE VecF Div(VecF A, VecF B) { return _mm256_div_ps(A, B); }
+	FORCEINLINE VecF Min(VecF A, VecF B) { return _mm256_min_ps(A, B); }
+	FORCEINLINE VecF Max(VecF A, VecF B) { return _mm256_max_ps(A, B); }
+	FORCEINLINE VecF Sqrt(VecF A) { return _mm256_sqrt_ps(A); }
+	FORCEINLINE VecF Floor(VecF A) { return _mm256_floor_ps(A); }
+	FORCEINLINE VecMask GreaterEqual(VecF A, VecF B) { return _mm256_cmp_ps(A, B, _CMP_GE_OQ); }
+	FORCEINLINE VecF Select(VecMask Mask, VecF A, VecF B) { return _mm256_blendv_ps(B, A, Mask); }
+
+	// 2^N for integral N in [-126, 127], built directly in the exponent bits
+	FORCEINLINE VecF Pow2(VecF N)
+	{
+		return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(N), _mm256_set1_epi32(127)), 23));
+	}
+
+	// Writes Lanes texels, taking channel c of texel i from lane i of the c-th vector
+	FORCEINLINE void StoreTexels(FLinearColor* Out, VecF R, VecF G, VecF B, VecF A)
+	{
+		float* Dest = reinterpret_cast<float*>(Out);
+		__m128 R0 = _mm256_castps256_ps128(R), G0 = _mm256_castps256_ps128(G), B0 = _mm256_castps256_ps128(B), A0 = _mm256_castps256_ps128(A);
+		__m128 R1 = _mm256_extractf128_ps(R, 1), G1 = _mm256_extractf128_ps(G, 1), B1 = _mm256_extractf128_ps(B, 1), A1 = _mm256_extractf128_ps(A, 1);
+		_MM_TRANSPOSE4_PS(R0, G0, B0, A0);
+		_MM_TRANSPOSE4_PS(R1, G1, B1, A1);
+		_mm_storeu_ps(Dest + 0, R0);
+		_mm_storeu_ps(Dest + 4, G0);
+		_mm_storeu_ps(Dest + 8, B0);
+		_mm_storeu_ps(Dest + 12, A0);
+		_mm_storeu_ps(Dest + 16, R1);
+		_mm_storeu_ps(Dest + 20, G1);
+		_mm_storeu_ps(Dest + 24, B1);
+		_mm_storeu_ps(Dest + 28, A1);
+	}
+
+#else // SSE2
+
+	typedef __m128 VecF;
+	typedef __m128 VecMask;
+	constexpr int32 Lanes = 4;
+
+	FORCEINLINE VecF Load(const float* P) { return _mm_loadu_ps(P); }
+	FORCEINLINE void Store(float* P, VecF V) { _mm_storeu_ps(P, V); }
+	FORCEINLINE VecF Set(float V) { return _mm_set1_ps(V); }
+	FORCEINLINE VecF Add(VecF A, VecF B) { return _mm_add_ps(A, B); }
+	FORCEINLINE VecF Sub(VecF A, VecF B) { return _mm_sub_ps(A, B); }
+	FORCEINLINE VecF Mul(VecF A, VecF B) { return _mm_mul_ps(A, B); }
+	FORCEINLINE VecF Div(VecF A, VecF B) { return _mm_div_ps(A, B); }
+	FORCEINLINE VecF Min(VecF A, VecF B) { return _mm_min_ps(A, B); }
+	FORCEINLINE VecF Max(VecF A, VecF B) { return _mm_max_ps(A, B); }
+	FORCEINLINE VecF Sqrt(VecF A) { return _mm_sqrt_ps(A); }
+	FORCEINLINE VecMask GreaterEqual(VecF A, VecF B) { return _mm_cmpge_ps(A, B); }
+	FORCEINLINE VecF Select(VecMask Mask, VecF A, VecF B) { return _mm_or_ps(_mm_and_ps(Mask, A), _mm_andnot_ps(Mask, B)); }
+
+	// SSE2 has no floor: truncate, then step down where truncation rounded up (negative inputs)
+	FORCEINLINE VecF Floor(VecF A)
+	{
+		VecF Truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(A));
+		return _mm_sub_ps(Truncated, _mm_and_ps(_mm_cmpgt_ps(Truncated, A), _mm_set1_ps(1.0f)));
+	}
+
+	// 2^N for integral N in [-126, 127], built directly in the exponent bits
+	FORCEINLINE VecF Pow2(VecF N)
+	{
+		return _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(N), _mm_set1_epi32(127)), 23));
+	}
+
+	// Writes Lanes texels, taking channel c of texel i from lane i of the c-th vector
+	FORCEINLINE void StoreTexels(FLinearColor* Out, VecF R, VecF G, VecF B, VecF A)
+	{
+		float* Dest = reinterpret_cast<float*>(Out);
+		_MM_TRANSPOSE4_PS(R, G, B, A);
+		_mm_storeu_ps(Dest + 0, R);
+		_mm_storeu_ps(Dest + 4, G);
+		_mm_storeu_ps(Dest + 8, B);
+		_mm_storeu_ps(Dest + 12, A);
+	}
+
+#endif
+
+	// exp(x) after Cephes' expf: x = n ln2 + r with |r| <= ln2 / 2, exp(r) from a degree 7 polynomial.
+	// The input is clamped so that n stays in the normal exponent range.
+	FORCEINLINE VecF Exp(VecF X)
+	{
+		X = Min(Max(X, Set(-87.3365478515625f)), Set(88.3762626647949f));
+
+		VecF N = Floor(Add(Mul(X, Set(1.44269504088896341f)), Set(0.5f)));
+		X = Sub(X, Mul(N, Set(0.693359375f)));
+		X = Sub(X, Mul(N, Set(-2.12194440e-4f)));
+
+		VecF P = Set(1.9875691500e-4f);
+		P = Add(Mul(P, X), Set(1.3981999507e-3f));
+		P = Add(Mul(P, X), Set(8.3334519073e-3f));
+		P = Add(Mul(P, X), Set(4.1665795894e-2f));
+		P = Add(Mul(P, X), Set(1.6666665459e-1f));
+		P = Add(Mul(P, X), Set(5.0000001201e-1f));
+		P = Add(Mul(Mul(P, X), X), Add(X, Set(1.0f)));
+		return Mul(P, Pow2(N));
+	}
+
+	// Runs Block over Num splats, Lanes at a time. The tail is zero-padded to a full block so every
+	// splat goes through the same code, whatever batch or task boundaries it ends up next to.
+	template <int32 NumInputs, typename BlockType>
+	FORCEINLINE void RunKernel(const float* const (&Inputs)[NumInputs], int32 Num, FLinearColor* Out, BlockType Block)
+	{
+		VecF In[NumInputs];
+		int32 i = 0;
+		for (; i + Lanes <= Num; i += Lanes)
+		{
+			for (int32 Input = 0; Input < NumInputs; Input++)
+			{
+				In[Input] = Load(Inputs[Input] + i);
+			}
+			Block(In, Out + i);
+		}
+
+		if (i < Num)
+		{
+			float Tail[NumInputs][Lanes] = {};
+			FLinearColor TailOut[Lanes];
+			for (int32 Input = 0; Input < NumInputs; Input++)
+			{
+				FMemory::Memcpy(Tail[Input], Inputs[Input] + i, (Num - i) * sizeof(float));
+				In[Input] = Load(Tail[Input]);
+			}
+			Block(In, TailOut);
+			FMemory::Memcpy(Out + i, TailOut, (Num - i) * sizeof(FLinearColor));
+		}
+	}
+
+	// Operators on top of the primitives, so that SHBasis can be instantiated for whole vectors
+	struct FVecF
+	{
+		VecF V;
+
+		FORCEINLINE FVecF() {}
+		FORCEINLINE FVecF(VecF In) : V(In) {}
+		FORCEINLINE explicit FVecF(float In) : V(Set(In)) {}
+	};
+
+	FORCEINLINE FVecF operator+(FVecF A, FVecF B) { return Add(A.V, B.V); }
+	FORCEINLINE FVecF operator-(FVecF A, FVecF B) { return Sub(A.V, B.V); }
+	FORCEINLINE FVecF operator*(FVecF A, FVecF B) { return Mul(A.V, B.V); }
+
+	// Evaluates the SH color of Num splats, Lanes at a time. DirectionOf(i) is splat i's view direction in Unreal space.
+	// The splats of a block are transposed into one lane each; tail lanes are zero and never written out.
+	template <int32 Degree, typename DirectionFuncType>
+	void EvaluateSHBlocks(const FVector3f* ZeroOrder, const float* HigherOrder, int32 CoefficientStride, int32 Num, FLinearColor* Out,
+		DirectionFuncType DirectionOf)
+	{
+		constexpr int32 NumCoefficients = NumSHCoefficients<Degree>;
+		for (int32 i = 0; i < Num; i += Lanes)
+		{
+			const int32 NumLanes = FMath::Min(Lanes, Num - i);
+
+			// Rows 0-2 hold f_dc_0..2, the rest the higher order RGB triplets in storage order
+			float Dir[3][Lanes] = {};
+			float Coefficients[3 + 3 * NumCoefficients][Lanes] = {};
+			for (int32 Lane = 0; Lane < NumLanes; Lane++)
+			{
+				const FVector3f Direction = DirectionOf(i + Lane);
+				Dir[0][Lane] = Direction.X;
+				Dir[1][Lane] = -Direction.Z;
+				Dir[2][Lane] = -Direction.Y;
+
+				const FVector3f& DC = ZeroOrder[i + Lane];
+				Coefficients[0][Lane] = DC.X;
+				Coefficients[1][Lane] = DC.Y;
+				Coefficients[2][Lane] = DC.Z;
+				if constexpr (NumCoefficients > 0)
+				{
+					const float* Rest = HigherOrder + SIZE_T(i + Lane) * CoefficientStride * 3;
+					for (int32 c = 0; c < 3 * NumCoefficients; c++)
+					{
+						Coefficients[3 + c][Lane] = Rest[c];
+					}
+				}
+			}
+
+			// Normalize; directions too short to normalize keep only the DC term, like GetSafeNormal
+			VecF X = Load(Dir[0]), Y = Load(Dir[1]), Z = Load(Dir[2]);
+			const VecF SquareSum = Add(Add(Mul(X, X), Mul(Y, Y)), Mul(Z, Z));
+			const VecF Scale = Select(GreaterEqual(SquareSum, Set(UE_SMALL_NUMBER)),
+				Div(Set(1.0f), Sqrt(Max(SquareSum, Set(UE_SMALL_NUMBER)))), Set(0.0f));
+			FVecF Basis[NumSHCoefficients<3>];
+			SHBasis<Degree>(FVecF(Mul(X, Scale)), FVecF(Mul(Y, Scale)), FVecF(Mul(Z, Scale)), Basis);
+
+			FVecF Color[3];
+			for (int32 c = 0; c < 3; c++)
+			{
+				Color[c] = FVecF(SH_C0) * FVecF(Load(Coefficients[c]));
+			}
+			for (int32 y = 0; y < NumCoefficients; y++)
+			{
+				for (int32 c = 0; c < 3; c++)
+				{
+					Color[c] = Color[c] + Basis[y] * FVecF(Load(Coefficients[3 + 3 * y + c]));
+				}
+			}
+
+			const VecF Half = Set(0.5f), Zero = Set(0.0f);
+			const VecF R = Max(Add(Color[0].V, Half), Zero);
+			const VecF G = Max(Add(Color[1].V, Half), Zero);
+			const VecF B = Max(Add(Color[2].V, Half), Zero);
+			if (NumLanes == Lanes)
+			{
+				StoreTexels(Out + i, R, G, B, Set(1.0f));
+			}
+			else
+			{
+				FLinearColor TailOut[Lanes];
+				StoreTexels(TailOut, R, G, B, Set(1.0f));
+				FMemory::Memcpy(Out + i, TailOut, NumLanes * sizeof(FLinearColor));
+			}
+		}
+	}
+}
+
+#endif // SPLAT_KERNELS_SIMD
+
+// ---------- Kernels ----------
+
+void SplatKernels::ConvertPositions(const float* X, const float* Y, const float* Z, int32 Num, FLinearColor* Out)
+{
+#if SPLAT_KERNELS_SIMD
+	if (!CVarSplatReferenceKernels.GetValueOnAnyThread())
+	{
+		const float* const Inputs[] = { X, Y, Z };
+		RunKernel(Inputs, Num, Out, [](const VecF* In, FLinearColor* Texels)
+		{
+			const VecF Hundred = Set(100.0f);
+			const VecF MinusHundred = Set(-100.0f);
+			StoreTexels(Texels, Mul(In[0], Hundred), Mul(In[2], MinusHundred), Mul(In[1], MinusHundred), Hundred);
+		});
+		return;
+	}
+#endif
+	Reference::ConvertPositions(X, Y, Z, Num, Out);
+}
+
+void SplatKernels::ConvertScales(const float* Scale0, const float* Scale1, const float* Scale2, int32 Num, FLinearColor* Out)
+{
+#if SPLAT_KERNELS_SIMD
+	if (!CVarSplatReferenceKernels.GetValueOnAnyThread())
+	{
+		const float* const Inputs[] = { Scale0, Scale1, Scale2 };
+		RunKernel(Inputs, Num, Out, [](const VecF* In, FLinearColor* Texels)
+		{
+			const VecF Hundred = Set(100.0f);
+			StoreTexels(Texels, Mul(Exp(In[0]), Hundred), Mul(Exp(In[2]), Hundred), Mul(Exp(In[1]), Hundred), Hundred);
+		});
+		return;
+	}
+#endif
+	Reference::ConvertScales(Scale0, Scale1, Scale2, Num, Out);
+}
+
+void SplatKernels::ConvertRotations(const float* Rot0, const float* Rot1, const float* Rot2, const float* Rot3, int32 Num, FLinearColor* Out)
+{
+#if SPLAT_KERNELS_SIMD
+	if (!CVarSplatReferenceKernels.GetValueOnAnyThread())
+	{
+		const float* const Inputs[] = { Rot0, Rot1, Rot2, Rot3 };
+		RunKernel(Inputs, Num, Out, [](const VecF* In, FLinearColor* Texels)
+		{
+			const VecF W = In[0], X = In[1], Y = In[2], Z = In[3];
+			const VecF SquareSum = Add(Add(Mul(X, X), Mul(Y, Y)), Add(Mul(Z, Z), Mul(W, W)));
+			const VecMask Valid = GreaterEqual(SquareSum, Set(UE_SMALL_NUMBER));
+			const VecF Scale = Div(Set(1.0f), Sqrt(Max(SquareSum, Set(UE_SMALL_NUMBER))));
+			const VecF Zero = Set(0.0f);
+
+			// Degenerate quaternions become the identity, like FQuat::Normalize
+			StoreTexels(Texels,
+				Select(Valid, Mul(X, Scale), Zero),
+				Select(Valid, Sub(Zero, Mul(Z, Scale)), Zero),
+				Select(Valid, Sub(Zero, Mul(Y, Scale)), Zero),
+				Select(Valid, Mul(W, Scale), Set(1.0f)));
+		});
+		return;
+	}
+#endif
+	Reference::ConvertRotations(Rot0, Rot1, Rot2, Rot3, Num, Out);
+}
+
+void SplatKernels::ConvertColors(const float* DC0, const float* DC1, const float* DC2, const float* Opacity, int32 Num, FLinearColor* Out)
+{
+#if SPLAT_KERNELS_SIMD
+	if (!CVarSplatReferenceKernels.GetValueOnAnyThread())
+	{
+		const float* const Inputs[] = { DC0, DC1, DC2, Opacity };
+		RunKernel(Inputs, Num, Out, [](const VecF* In, FLinearColor* Texels)
+		{
+			const VecF One = Set(1.0f);
+			const VecF Alpha = Div(One, Add(One, Exp(Sub(Set(0.0f), In[3]))));
+			StoreTexels(Texels, In[0], In[1], In[2], Min(Max(Alpha, Set(0.0f)), One));
+		});
+		return;
+	}
+#endif
+	Reference::ConvertColors(DC0, DC1, DC2, Opacity, Num, Out);
+}
+
+void SplatKernels::EncodeHalf(const FLinearColor* In, int32 Num, const FLinearColor& Offset, const FLinearColor& Scale, FFloat16Color* Out)
+{
+#if SPLAT_KERNELS_SIMD
+	if (!CVarSplatReferenceKernels.GetValueOnAnyThread())
+	{
+		// A vector holds whole texels, so Offset and Scale repeat every four lanes
+		float OffsetLanes[Lanes], ScaleLanes[Lanes];
+		for (int32 Lane = 0; Lane < Lanes; Lane++)
+		{
+			OffsetLanes[Lane] = Offset.Component(Lane % 4);
+			ScaleLanes[Lane] = Scale.Component(Lane % 4);
+		}
+		const VecF OffsetV = Load(OffsetLanes);
+		const VecF ScaleV = Load(ScaleLanes);
+
+		// Two texels per conversion: WideVectorStoreHalf turns eight floats into halves with a single
+		// F16C (x64) or FCVTN (ARM) instruction where the build allows it
+		const float* Src = reinterpret_cast<const float*>(In);
+		uint16* Dest = reinterpret_cast<uint16*>(Out);
+		const int32 NumPairs = Num / 2;
+		alignas(32) float Block[8];
+		for (int32 Pair = 0; Pair < NumPairs; Pair++)
+		{
+			for (int32 Lane = 0; Lane < 8; Lane += Lanes)
+			{
+				Store(Block + Lane, Mul(Sub(Load(Src + 8 * Pair + Lane), OffsetV), ScaleV));
+			}
+			FPlatformMath::WideVectorStoreHalf(Dest + 8 * Pair, Block);
+		}
+		Reference::EncodeHalf(In + 2 * NumPairs, Num - 2 * NumPairs, Offset, Scale, Out + 2 * NumPairs);
+		return;
+	}
+#endif
+	Reference::EncodeHalf(In, Num, Offset, Scale, Out);
+}
+
+template <int32 Degree>
+void SplatKernels::EvaluateSH(TConstArrayView<FVector3f> ZeroOrder, TConstArrayView<float> HigherOrder, int32 CoefficientStride,
+	const FVector3f& ViewDirection, TArrayView<FLinearColor> Out)
+{
+	check(ZeroOrder.Num() >= Out.Num() && (Degree == 0 || HigherOrder.Num() >= Out.Num() * CoefficientStride * 3));
+#if SPLAT_KERNELS_SIMD
+	if (!CVarSplatReferenceKernels.GetValueOnAnyThread())
+	{
+		EvaluateSHBlocks<Degree>(ZeroOrder.GetData(), HigherOrder.GetData(), CoefficientStride, Out.Num(), Out.GetData(),
+			[&ViewDirection](int32 Index) { return ViewDirection; });
+		return;
+	}
+#endif
+	Reference::EvaluateSH<Degree>(ZeroOrder, HigherOrder, CoefficientStride, ViewDirection, Out);
+}
+
+template <int32 Degree>
+void SplatKernels::EvaluateSH(TConstArrayView<FVector3f> ZeroOrder, TConstArrayView<float> HigherOrder, int32 CoefficientStride,
+	TConstArrayView<FVector3f> Positions, const FVector3f& CameraPosition, TArrayView<FLinearColor> Out)
+{
+	check(ZeroOrder.Num() >= Out.Num() && Positions.Num() >= Out.Num() && (Degree == 0 || HigherOrder.Num() >= Out.Num() * CoefficientStride * 3));
+#if SPLAT_KERNELS_SIMD
+	if (!CVarSplatReferenceKernels.GetValueOnAnyThread())
+	{
+		const FVector3f* PositionData = Positions.GetData();
+		EvaluateSHBlocks<Degree>(ZeroOrder.GetData(), HigherOrder.GetData(), CoefficientStride, Out.Num(), Out.GetData(),
+			[PositionData, &CameraPosition](int32 Index) { return PositionData[Index] - CameraPosition; });
+		return;
+	}
+#endif
+	Reference::EvaluateSH<Degree>(ZeroOrder, HigherOrder, CoefficientStride, Positions, CameraPosition, Out);
+}
+
+#define INSTANTIATE_EVALUATE_SH(Degree) \
+	template void SplatKernels::EvaluateSH<Degree>(TConstArrayView<FVector3f>, TConstArrayView<float>, int32, const FVector3f&, TArrayView<FLinearColor>); \
+	template void SplatKernels::EvaluateSH<Degree>(TConstArrayView<FVector3f>, TConstArrayView<float>, int32, TConstArrayView<FVector3f>, const FVector3f&, TArrayView<FLinearColor>); \
+	template void SplatKernels::Reference::EvaluateSH<Degree>(TConstArrayView<FVector3f>, TConstArrayView<float>, int32, const FVector3f&, TArrayView<FLinearColor>); \
+	template void SplatKernels::Reference::EvaluateSH<Degree>(TConstArrayView<FVector3f>, TConstArrayView<float>, int32, TConstArrayView<FVector3f>, const FVector3f&, TArrayView<FLinearColor>);
+
+INSTANTIATE_EVALUATE_SH(0)
+INSTANTIATE_EVALUATE_SH(1)
+INSTANTIATE_EVALUATE_SH(2)
+INSTANTIATE_EVALUATE_SH(3)
+
+#undef INSTANTIATE_EVALUATE_SH
@@ -0,0 +1,102 @@
+// SplatPLYWriter.cpp
+
+#include "SplatPLYWriter.h"
+#include "GaussianSplatCloud.h"
+#include "GaussianSplatBuffer.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/ParallelFor.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Rows are written in native byte order as binary_little_endian");
+
+FSplatPLYWriter::FSplatPLYWriter(const UGaussianSplatCloud& InCloud, const FGaussianSplatExportSettings& Settings)
+	: Cloud(InCloud)
+	, Columns()
+	, Error()
+{
+	const int32 NumSplats = InCloud.Num();
+	auto AddColumns = [this](EGaussianSplatColumn First, int32 Num) {
+		for (int32 Col = int32(First); Col < int32(First) + Num; Col++) {
+			Columns.Add(Col);
+		}
+	};
+	AddColumns(EGaussianSplatColumn::X, 3);
+	if (Settings.bWriteNormals && InCloud.GetNormals().Num() == NumSplats) {
+		AddColumns(EGaussianSplatColumn::NX, 3);
+	}
+	if (Settings.bWriteZeroOrderHarmonics && InCloud.GetZeroOrderHarmonicsArray().Num() == NumSplats) {
+		AddColumns(EGaussianSplatColumn::DC0, 3);
+	}
+	// f_rest_* are numbered densely in the file, so only the written degree's channel stride is used
+	const int32 NumCoefficients = FGaussianSplatBuffer::NumSHCoefficientsForDegree(FMath::Min(InCloud.GetSHDegree(), FMath::Clamp(Settings.MaxSHDegree, 0, 3)));
+	for (int32 Channel = 0; Channel < 3; Channel++) {
+		AddColumns(EGaussianSplatColumn(int32(EGaussianSplatColumn::Rest0) + Channel * InCloud.GetNumSHCoefficients()), NumCoefficients);
+	}
+	if (Settings.bWriteOpacity && InCloud.GetOpacities().Num() == NumSplats) {
+		AddColumns(EGaussianSplatColumn::Opacity, 1);
+	}
+	if (Settings.bWriteScale && InCloud.GetScales().Num() == NumSplats) {
+		AddColumns(EGaussianSplatColumn::Scale0, 3);
+	}
+	if (Settings.bWriteRotation && InCloud.GetOrientations().Num() == NumSplats) {
+		AddColumns(EGaussianSplatColumn::Rot0, 4);
+	}
+}
+
+FString FSplatPLYWriter::GetHeader() const {
+	FString Header = FString::Printf(TEXT("ply\nformat binary_little_endian 1.0\nelement vertex %d\n"), Cloud.Num());
+	int32 Rest = 0;
+	for (int32 Col : Columns) {
+		if (Col >= int32(EGaussianSplatColumn::Rest0) && Col < int32(EGaussianSplatColumn::Opacity)) {
+			Header += FString::Printf(TEXT("property float f_rest_%d\n"), Rest++);
+		}
+		else {
+			Header += FString::Printf(TEXT("property float %s\n"), ANSI_TO_TCHAR(FGaussianSplatBuffer::ColumnName(Col)));
+		}
+	}
+	Header += TEXT("end_header\n");
+	return Header;
+}
+
+void FSplatPLYWriter::EncodeRows(int32 FirstRow, int32 NumRows, float* Out) const {
+	const FGaussianSplatCloudSource Source(Cloud);
+	for (int32 Row = FirstRow; Row < FirstRow + NumRows; Row++) {
+		for (int32 Col : Columns) {
+			*Out++ = Source.Get(Col, Row);
+		}
+	}
+}
+
+bool FSplatPLYWriter::Write(const FString& AbsolutePath) {
+	TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*AbsolutePath));
+	if (!File) {
+		Error = FString::Printf(TEXT("Cannot open %s for writing"), *AbsolutePath);
+		return false;
+	}
+
+	const FTCHARToUTF8 Header(*GetHeader());
+	if (!File->Write(reinterpret_cast<const uint8*>(Header.Get()), Header.Length())) {
+		Error = FString::Printf(TEXT("Cannot write the header of %s"), *AbsolutePath);
+		return false;
+	}
+
+	const int32 NumSplats = Cloud.Num();
+	TArray<float> Block;
+	Block.SetNumUninitialized(FMath::Min(NumSplats, RowsPerBlock) * Columns.Num());
+	for (int32 FirstRow = 0; FirstRow < NumSplats; FirstRow += RowsPerBlock) {
+		const int32 NumRows = FMath::Min(RowsPerBlock, NumSplats - FirstRow);
+		ParallelFor(FGaussianSplatBuffer::NumTasks(NumRows), [&](int32 Task) {
+			const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+			const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumRows);
+			EncodeRows(FirstRow + Begin, End - Begin, Block.GetData() + SIZE_T(Begin) * Columns.Num());
+		});
+		if (!File->Write(reinterpret_cast<const uint8*>(Block.GetData()), int64(NumRows) * GetRowStride())) {
+			Error = FString::Printf(TEXT("Cannot write splats %d to %d of %s"), FirstRow, FirstRow + NumRows - 1, *AbsolutePath);
+			return false;
+		}
+	}
+	if (!File->Flush()) {
+		Error = FString::Printf(TEXT("Cannot flush %s"), *AbsolutePath);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,35 @@
+// SplatTexturePages.cpp
+
+#include "SplatTexturePages.h"
+
+int32 FSplatTexturePages::GetMaxTexelsPerSplat(int32 SHDegree) {
+	return SHDegree >= 2 ? 5 : SHDegree == 1 ? 3 : 1;
+}
+
+void FSplatTexturePages::GetTextureSize(int64 NumPixels, int32& OutWidth, int32& OutHeight) {
+	int64 Width = FMath::Max<int64>(int64(FMath::Sqrt(double(NumPixels))), 1);
+	while (Width * Width < NumPixels) {
+		Width++;
+	}
+	OutWidth = int32(Width);
+	OutHeight = int32(FMath::Max<int64>((NumPixels + Width - 1) / Width, 1));
+}
+
+int32 FSplatTexturePages::GetSplatsPerPage(int32 SHDegree, int64 MaxTexelsPerTexture) {
+	return int32(FMath::Clamp<int64>(MaxTexelsPerTexture / GetMaxTexelsPerSplat(SHDegree), 1, MAX_int32));
+}
+
+FString FSplatTexturePages::GetPageTextureName(const TCHAR* Name, int32 PageIndex) {
+	return PageIndex == 0 ? FString(Name) : FString::Printf(TEXT("%s_%d"), Name, PageIndex);
+}
+
+TArray<FSplatPageRange> FSplatTexturePages::GetPages(int64 NumSplats, int32 SplatsPerPage) {
+	check(NumSplats <= MAX_int32 && SplatsPerPage > 0);
+	TArray<FSplatPageRange> Pages;
+	for (int64 FirstSplat = 0; FirstSplat < NumSplats; FirstSplat += SplatsPerPage) {
+		FSplatPageRange& Page = Pages.AddDefaulted_GetRef();
+		Page.FirstSplat = int32(FirstSplat);
+		Page.NumSplats = int32(FMath::Min<int64>(SplatsPerPage, NumSplats - FirstSplat));
+	}
+	return Pages;
+}
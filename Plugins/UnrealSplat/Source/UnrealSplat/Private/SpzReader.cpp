@@ -0,0 +1,294 @@
+// SpzReader.cpp
+
+#include "SpzReader.h"
+#include "SplatArena.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/ParallelFor.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+static constexpr uint32 SpzMagic = 0x5053474e; // "NGSP"
+static constexpr int32 SpzMinVersion = 2;
+static constexpr int32 SpzMaxVersion = 3;
+static constexpr uint8 SpzFlagAntialiased = 0x1;
+static constexpr float SpzColorScale = 0.15f;
+
+// Compressed bytes read from the file per inflate step
+static constexpr int32 SpzInputChunkBytes = 1024 * 1024;
+
+struct FSpzHeader {
+	uint32 Magic;
+	uint32 Version;
+	uint32 NumPoints;
+	uint8 SHDegree;
+	uint8 FractionalBits;
+	uint8 Flags;
+	uint8 Reserved;
+};
+static_assert(sizeof(FSpzHeader) == 16, "The .spz header is 16 bytes");
+
+// Columns every decoded batch fills, followed by the kept f_rest_* columns
+static const EGaussianSplatColumn kSpzVertexColumns[] = {
+	EGaussianSplatColumn::X, EGaussianSplatColumn::Y, EGaussianSplatColumn::Z,
+	EGaussianSplatColumn::Scale0, EGaussianSplatColumn::Scale1, EGaussianSplatColumn::Scale2,
+	EGaussianSplatColumn::Rot0, EGaussianSplatColumn::Rot1, EGaussianSplatColumn::Rot2, EGaussianSplatColumn::Rot3,
+	EGaussianSplatColumn::DC0, EGaussianSplatColumn::DC1, EGaussianSplatColumn::DC2, EGaussianSplatColumn::Opacity,
+};
+static constexpr int32 NumSpzVertexColumns = UE_ARRAY_COUNT(kSpzVertexColumns);
+
+// Sign of every harmonics coefficient under the RUB -> RDF axis flip (y and z negated)
+static constexpr float kSpzFlipSH[FGaussianSplatBuffer::NumSHCoefficientsForDegree(3)] = {
+	-1.0f, -1.0f, 1.0f,
+	-1.0f, 1.0f, 1.0f, -1.0f, 1.0f,
+	-1.0f, 1.0f, -1.0f, -1.0f, 1.0f, -1.0f, 1.0f,
+};
+
+// Inflates a gzip file in fixed-size chunks, so the compressed file is never held in memory as a whole
+class FGzipFileReader {
+public:
+	explicit FGzipFileReader(const FString& Path)
+		: File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Path))
+		, bInitialized(false)
+		, bEnded(false)
+	{
+		FMemory::Memzero(Stream);
+		if (File) {
+			Input.SetNumUninitialized(SpzInputChunkBytes);
+			// 16 + MAX_WBITS: expect a gzip header and trailer around the deflate stream
+			bInitialized = inflateInit2(&Stream, 16 + MAX_WBITS) == Z_OK;
+		}
+	}
+
+	~FGzipFileReader() {
+		if (bInitialized) {
+			inflateEnd(&Stream);
+		}
+	}
+
+	bool IsOpen() const { return bInitialized; }
+
+	// Inflates exactly Bytes bytes into Dest. False on read or zlib errors, or if the stream ends first.
+	bool Read(void* Dest, int64 Bytes) {
+		uint8* Out = static_cast<uint8*>(Dest);
+		while (Bytes > 0) {
+			if (bEnded) {
+				return false;
+			}
+			if (Stream.avail_in == 0) {
+				const int64 ChunkBytes = FMath::Min<int64>(File->Size() - File->Tell(), Input.Num());
+				if (ChunkBytes <= 0 || !File->Read(Input.GetData(), ChunkBytes)) {
+					return false;
+				}
+				Stream.next_in = Input.GetData();
+				Stream.avail_in = uInt(ChunkBytes);
+			}
+
+			// avail_out is 32 bits wide
+			const uInt Slice = uInt(FMath::Min<int64>(Bytes, 1 << 30));
+			Stream.next_out = Out;
+			Stream.avail_out = Slice;
+			const int Result = inflate(&Stream, Z_NO_FLUSH);
+			if (Result == Z_STREAM_END) {
+				bEnded = true;
+			}
+			else if (Result != Z_OK) {
+				return false;
+			}
+			const uInt Produced = Slice - Stream.avail_out;
+			Out += Produced;
+			Bytes -= Produced;
+		}
+		return true;
+	}
+
+private:
+	TUniquePtr<IFileHandle> File;
+	TArray<uint8> Input;
+	z_stream Stream;
+	bool bInitialized;
+	bool bEnded;
+};
+
+FSpzReader::FSpzReader()
+	: Arena(nullptr)
+	, Positions(nullptr)
+	, Alphas(nullptr)
+	, Colors(nullptr)
+	, Scales(nullptr)
+	, Rotations(nullptr)
+	, Harmonics(nullptr)
+	, BatchStorage(nullptr)
+	, BatchStorageSize(0)
+	, NumSplats(0)
+	, Version(0)
+	, NumPoints(0)
+	, FileSHDegree(0)
+	, FractionalBits(0)
+	, bAntialiased(false)
+{
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		Columns[Col] = nullptr;
+	}
+}
+
+bool FSpzReader::Open(const FString& AbsolutePath, FSplatArena& InArena) {
+	FGzipFileReader Gzip(AbsolutePath);
+	if (!Gzip.IsOpen()) {
+		Error = FString::Printf(TEXT("Cannot open %s"), *AbsolutePath);
+		return false;
+	}
+
+	FSpzHeader Header;
+	if (!Gzip.Read(&Header, sizeof(Header)) || Header.Magic != SpzMagic) {
+		Error = FString::Printf(TEXT("Not a gzip-compressed .spz file - %s"), *AbsolutePath);
+		return false;
+	}
+	if (Header.Version < SpzMinVersion || Header.Version > SpzMaxVersion || Header.SHDegree > 3 || Header.NumPoints > uint32(MAX_int32)) {
+		Error = FString::Printf(TEXT("Unsupported .spz file (version %u, %u points, SH degree %u) - %s"),
+			Header.Version, Header.NumPoints, uint32(Header.SHDegree), *AbsolutePath);
+		return false;
+	}
+	Version = int32(Header.Version);
+	NumPoints = int32(Header.NumPoints);
+	FileSHDegree = int32(Header.SHDegree);
+	FractionalBits = int32(Header.FractionalBits);
+	bAntialiased = (Header.Flags & SpzFlagAntialiased) != 0;
+
+	// Quantized attributes stay resident for the whole job, next to one batch of float columns
+	const int64 N = NumPoints;
+	const int32 NumCoefficients = RestChannelStride();
+	const int64 PayloadBytes = N * (9 + 1 + 3 + 3 + RotationBytes() + 3 * NumCoefficients);
+	const int64 BatchBytes = FMath::Min<int64>(N, FGaussianSplatBuffer::RowsPerBatch) * (NumSpzVertexColumns + 3 * NumCoefficients) * sizeof(float);
+	Arena = &InArena;
+	Arena->Reserve(PayloadBytes + FSplatArena::DefaultAlignment + BatchBytes);
+
+	uint8* Payload = Arena->AllocateArray<uint8>(PayloadBytes);
+	if (!Gzip.Read(Payload, PayloadBytes)) {
+		Error = FString::Printf(TEXT("Truncated or corrupt .spz file, expected %lld bytes of splat data - %s"), PayloadBytes, *AbsolutePath);
+		return false;
+	}
+	Positions = Payload;
+	Alphas = Positions + N * 9;
+	Colors = Alphas + N;
+	Scales = Colors + N * 3;
+	Rotations = Scales + N * 3;
+	Harmonics = Rotations + N * RotationBytes();
+	return true;
+}
+
+FString FSpzReader::Describe() const {
+	return FString::Printf(TEXT("spz version %d\npoints %d\nspherical harmonics degree %d\nfractional bits %d\nantialiased %d\n"),
+		Version, NumPoints, FileSHDegree, FractionalBits, bAntialiased ? 1 : 0);
+}
+
+bool FSpzReader::DecodeBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree) {
+	if (!Positions || FirstSplat < 0 || InNumSplats < 0 || FirstSplat + InNumSplats > NumPoints) {
+		return false;
+	}
+	SHDegree = FMath::Clamp(SHDegree, 0, FileSHDegree);
+	const int32 NumKept = FGaussianSplatBuffer::NumSHCoefficientsForDegree(SHDegree);
+	const int32 Stride = RestChannelStride();
+
+	NumSplats = InNumSplats;
+	for (int32 Col = 0; Col < FGaussianSplatBuffer::NumColumns; Col++) {
+		Columns[Col] = nullptr;
+	}
+	const int64 NumValues = int64(NumSpzVertexColumns + 3 * NumKept) * NumSplats;
+	if (NumValues > BatchStorageSize) {
+		BatchStorage = Arena->AllocateArray<float>(NumValues);
+		BatchStorageSize = NumValues;
+	}
+	float* Next = BatchStorage;
+	for (EGaussianSplatColumn Col : kSpzVertexColumns) {
+		Columns[int32(Col)] = Next;
+		Next += NumSplats;
+	}
+	for (int32 Channel = 0; Channel < 3; Channel++) {
+		for (int32 y = 0; y < NumKept; y++) {
+			Columns[int32(EGaussianSplatColumn::Rest0) + Channel * Stride + y] = Next;
+			Next += NumSplats;
+		}
+	}
+
+	float* PosX = Columns[int32(EGaussianSplatColumn::X)];
+	float* PosY = Columns[int32(EGaussianSplatColumn::Y)];
+	float* PosZ = Columns[int32(EGaussianSplatColumn::Z)];
+	float* Scale[3] = { Columns[int32(EGaussianSplatColumn::Scale0)], Columns[int32(EGaussianSplatColumn::Scale1)], Columns[int32(EGaussianSplatColumn::Scale2)] };
+	float* Rot[4] = { Columns[int32(EGaussianSplatColumn::Rot0)], Columns[int32(EGaussianSplatColumn::Rot1)], Columns[int32(EGaussianSplatColumn::Rot2)], Columns[int32(EGaussianSplatColumn::Rot3)] };
+	float* DC[3] = { Columns[int32(EGaussianSplatColumn::DC0)], Columns[int32(EGaussianSplatColumn::DC1)], Columns[int32(EGaussianSplatColumn::DC2)] };
+	float* Opacity = Columns[int32(EGaussianSplatColumn::Opacity)];
+	float* const* Rest = Columns + int32(EGaussianSplatColumn::Rest0);
+	const float PositionScale = 1.0f / float(1 << FractionalBits);
+	const int32 NumRotationBytes = RotationBytes();
+
+	ParallelFor(FGaussianSplatBuffer::NumTasks(NumSplats), [&](int32 Task) {
+		const int32 Begin = Task * FGaussianSplatBuffer::RowsPerTask;
+		const int32 End = FMath::Min(Begin + FGaussianSplatBuffer::RowsPerTask, NumSplats);
+		for (int32 i = Begin; i < End; i++) {
+			const int64 Row = int64(FirstSplat) + i;
+
+			// Position: 24-bit two's complement fixed point. RUB -> RDF negates y and z.
+			const uint8* P = Positions + Row * 9;
+			float Position[3];
+			for (int32 Axis = 0; Axis < 3; Axis++, P += 3) {
+				const int32 Fixed = int32(uint32(P[0]) | (uint32(P[1]) << 8) | (uint32(P[2]) << 16));
+				Position[Axis] = float((Fixed ^ 0x800000) - 0x800000) * PositionScale;
+			}
+			PosX[i] = Position[0];
+			PosY[i] = -Position[1];
+			PosZ[i] = -Position[2];
+
+			const uint8* S = Scales + Row * 3;
+			for (int32 Axis = 0; Axis < 3; Axis++) {
+				Scale[Axis][i] = float(S[Axis]) / 16.0f - 10.0f;
+			}
+
+			// Rotation as x, y, z, w
+			const uint8* R = Rotations + Row * NumRotationBytes;
+			float Q[4];
+			if (NumRotationBytes == 4) {
+				// Smallest three: index of the largest component in the top 2 bits, then 9-bit magnitude + sign per component
+				uint32 Packed = uint32(R[0]) | (uint32(R[1]) << 8) | (uint32(R[2]) << 16) | (uint32(R[3]) << 24);
+				const uint32 Largest = Packed >> 30;
+				float SumSquares = 0.0f;
+				for (int32 Component = 3; Component >= 0; Component--) {
+					if (uint32(Component) != Largest) {
+						const float Magnitude = UE_INV_SQRT_2 * float(Packed & 511) / 511.0f;
+						Q[Component] = ((Packed >> 9) & 1) ? -Magnitude : Magnitude;
+						SumSquares += Q[Component] * Q[Component];
+						Packed >>= 10;
+					}
+				}
+				Q[Largest] = FMath::Sqrt(FMath::Max(1.0f - SumSquares, 0.0f));
+			}
+			else {
+				Q[0] = float(R[0]) / 127.5f - 1.0f;
+				Q[1] = float(R[1]) / 127.5f - 1.0f;
+				Q[2] = float(R[2]) / 127.5f - 1.0f;
+				Q[3] = FMath::Sqrt(FMath::Max(1.0f - (Q[0] * Q[0] + Q[1] * Q[1] + Q[2] * Q[2]), 0.0f));
+			}
+			Rot[0][i] = Q[3];
+			Rot[1][i] = Q[0];
+			Rot[2][i] = -Q[1];
+			Rot[3][i] = -Q[2];
+
+			const uint8* C = Colors + Row * 3;
+			for (int32 Channel = 0; Channel < 3; Channel++) {
+				DC[Channel][i] = (float(C[Channel]) / 255.0f - 0.5f) / SpzColorScale;
+			}
+			const float Alpha = float(Alphas[Row]) / 255.0f;
+			Opacity[i] = -FMath::Loge(1.0f / Alpha - 1.0f);
+
+			// Coefficient-major RGB in the file, channel-major columns like f_rest_*
+			const uint8* H = Harmonics + Row * Stride * 3;
+			for (int32 y = 0; y < NumKept; y++) {
+				for (int32 Channel = 0; Channel < 3; Channel++) {
+					Rest[Channel * Stride + y][i] = (float(H[y * 3 + Channel]) - 128.0f) / 128.0f * kSpzFlipSH[y];
+				}
+			}
+		}
+	});
+	return true;
+}
@@ -0,0 +1,266 @@
+// ImageSplatSequenceTest.cpp
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ImageSplatSequence.h"
+#include "IImageWrapperModule.h"
+#include "ImageCore.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+BEGIN_DEFINE_SPEC(FImageSplatSequenceSpec, "UnrealSplat.ImageSequence",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+	// Images of 3 x 2 pixels, one more than the splats, as the reader allows
+	static constexpr int32 NumSplats = 5;
+	static constexpr int32 Width = 3;
+	static constexpr int32 Height = 2;
+
+	// Ranges in the sidecar below: the sequence's, and those of frame "00001", which only overrides the positions
+	static constexpr float PositionMin[3] = { -10.0f, -20.0f, -30.0f };
+	static constexpr float PositionMax[3] = { 10.0f, 20.0f, 30.0f };
+	static constexpr float FramePositionMin[3] = { 0.0f, 100.0f, -500.0f };
+	static constexpr float FramePositionMax[3] = { 1000.0f, 300.0f, 500.0f };
+	static constexpr float ScaleMin[3] = { -8.0f, -7.0f, -6.0f };
+	static constexpr float ScaleMax[3] = { 2.0f, 3.0f, 4.0f };
+	static constexpr float ColorMin[4] = { -2.0f, -1.5f, -1.0f, -6.0f };
+	static constexpr float ColorMax[4] = { 2.0f, 1.5f, 1.0f, 6.0f };
+
+	FString Directory;
+	FImageSplatSequence Sequence;
+
+	// Columns of each attribute image, in channel order
+	static TArray<EGaussianSplatColumn> GetAttributeColumns(int32 Attribute)
+	{
+		switch (Attribute)
+		{
+		case 0: return { EGaussianSplatColumn::X, EGaussianSplatColumn::Y, EGaussianSplatColumn::Z };
+		case 1: return { EGaussianSplatColumn::Scale0, EGaussianSplatColumn::Scale1, EGaussianSplatColumn::Scale2 };
+		case 2: return { EGaussianSplatColumn::Rot0, EGaussianSplatColumn::Rot1, EGaussianSplatColumn::Rot2, EGaussianSplatColumn::Rot3 };
+		default: return { EGaussianSplatColumn::DC0, EGaussianSplatColumn::DC1, EGaussianSplatColumn::DC2, EGaussianSplatColumn::Opacity };
+		}
+	}
+
+	static const TCHAR* GetAttributeName(int32 Attribute)
+	{
+		static const TCHAR* const Names[FImageSplatSequence::NumAttributes] = { TEXT("position"), TEXT("scale"), TEXT("rotation"), TEXT("color") };
+		return Names[Attribute];
+	}
+
+	// 16-bit value of a channel of a splat, spread over the whole range and including both ends
+	static uint16 GetQuantizedValue(int32 Frame, int32 Attribute, int32 Channel, int32 Splat)
+	{
+		if (Splat == 0)
+		{
+			return 0;
+		}
+		if (Splat == 1)
+		{
+			return MAX_uint16;
+		}
+		return uint16((Splat * 7919 + Channel * 104729 + Attribute * 1299709 + Frame * 31) % 65536);
+	}
+
+	// Value of a channel of a splat in the float images, outside [0, 1] and exact in half precision as well
+	static float GetFloatValue(int32 Attribute, int32 Channel, int32 Splat)
+	{
+		return float(Splat * 8 - 20) * 0.25f + float(Channel) * 0.125f - float(Attribute) * 4.0f;
+	}
+
+	static bool WriteImage(const FString& Path, const FImage& Image, EImageFormat Format)
+	{
+		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+		TArray64<uint8> Compressed;
+		return ImageWrapperModule.CompressImage(Compressed, Format, Image, 0) && FFileHelper::SaveArrayToFile(Compressed, *Path);
+	}
+
+	// Writes the four attribute images of a frame as 16-bit PNG
+	bool WriteQuantizedFrame(int32 Frame, const FString& Folder)
+	{
+		for (int32 Attribute = 0; Attribute < FImageSplatSequence::NumAttributes; Attribute++)
+		{
+			FImage Image(Width, Height, ERawImageFormat::RGBA16, EGammaSpace::Linear);
+			TArrayView64<uint16> Pixels = Image.AsRGBA16();
+			for (int32 Splat = 0; Splat < Width * Height; Splat++)
+			{
+				for (int32 Channel = 0; Channel < 4; Channel++)
+				{
+					Pixels[Splat * 4 + Channel] = Splat < NumSplats ? GetQuantizedValue(Frame, Attribute, Channel, Splat) : 0;
+				}
+			}
+			if (!WriteImage(Directory / Folder / FString::Printf(TEXT("%s.png"), GetAttributeName(Attribute)), Image, EImageFormat::PNG))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Writes the four attribute images of a frame as 32-bit float EXR
+	bool WriteFloatFrame(const FString& Folder)
+	{
+		for (int32 Attribute = 0; Attribute < FImageSplatSequence::NumAttributes; Attribute++)
+		{
+			FImage Image(Width, Height, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+			TArrayView64<FLinearColor> Pixels = Image.AsRGBA32F();
+			for (int32 Splat = 0; Splat < Width * Height; Splat++)
+			{
+				for (int32 Channel = 0; Channel < 4; Channel++)
+				{
+					Pixels[Splat].Component(Channel) = GetFloatValue(Attribute, Channel, Splat);
+				}
+			}
+			if (!WriteImage(Directory / Folder / FString::Printf(TEXT("%s.exr"), GetAttributeName(Attribute)), Image, EImageFormat::EXR))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Checks every column of a quantized frame against min + v * (max - min) of its range
+	void TestQuantizedFrame(int32 Frame, const FImageSplatFrame& Decoded, const float* Min[], const float* Max[])
+	{
+		for (int32 Attribute = 0; Attribute < FImageSplatSequence::NumAttributes; Attribute++)
+		{
+			const TArray<EGaussianSplatColumn> Columns = GetAttributeColumns(Attribute);
+			for (int32 Channel = 0; Channel < Columns.Num(); Channel++)
+			{
+				const float* Column = Decoded.Column(Columns[Channel]);
+				if (!TestNotNull(FString::Printf(TEXT("Frame %d, %s channel %d"), Frame, GetAttributeName(Attribute), Channel), Column))
+				{
+					continue;
+				}
+				// Attributes without a range are normalized to [0, 1]
+				const float ChannelMin = Min[Attribute] ? Min[Attribute][Channel] : 0.0f;
+				const float ChannelMax = Max[Attribute] ? Max[Attribute][Channel] : 1.0f;
+				for (int32 Splat = 0; Splat < NumSplats; Splat++)
+				{
+					const float Normalized = float(GetQuantizedValue(Frame, Attribute, Channel, Splat)) / float(MAX_uint16);
+					const float Expected = ChannelMin + Normalized * (ChannelMax - ChannelMin);
+					TestTrue(FString::Printf(TEXT("Frame %d, %s channel %d, splat %d: expected %g, got %g"), Frame, GetAttributeName(Attribute), Channel, Splat,
+						Expected, Column[Splat]), FMath::IsNearlyEqual(Column[Splat], Expected, 1.0e-5f * FMath::Max(1.0f, ChannelMax - ChannelMin)));
+				}
+			}
+		}
+	}
+
+END_DEFINE_SPEC(FImageSplatSequenceSpec)
+
+void FImageSplatSequenceSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Directory = FPaths::ProjectSavedDir() / TEXT("Automation/UnrealSplat/ImageSequence");
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		IFileManager::Get().MakeDirectory(*Directory, true);
+
+		const FString Sidecar = TEXT(R"({
+			"ranges": {
+				"position": { "min": [-10, -20, -30], "max": [10, 20, 30] },
+				"scale": { "min": [-8, -7, -6], "max": [2, 3, 4] },
+				"color": { "min": [-2, -1.5, -1, -6], "max": [2, 1.5, 1, 6] }
+			},
+			"frames": [
+				{ "folder": "00000", "count": 5 },
+				{ "folder": "00001", "count": 5, "ranges": { "position": { "min": [0, 100, -500], "max": [1000, 300, 500] } } },
+				{ "folder": "00002", "count": 5 }
+			]
+		})");
+		TestTrue("Sidecar written", FFileHelper::SaveStringToFile(Sidecar, *(Directory / FImageSplatSequence::SidecarFileName)));
+		TestTrue("Frame 0 written", WriteQuantizedFrame(0, TEXT("00000")));
+		TestTrue("Frame 1 written", WriteQuantizedFrame(1, TEXT("00001")));
+		TestTrue("Frame 2 written", WriteFloatFrame(TEXT("00002")));
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	});
+
+	It("parses the frames of the sidecar", [this]()
+	{
+		TestTrue("Is an image sequence", FImageSplatSequence::IsImageSequence(Directory));
+		if (!TestTrue(FString::Printf(TEXT("Open: %s"), *Sequence.GetError()), Sequence.Open(Directory)))
+		{
+			return;
+		}
+		TestEqual("Frames", Sequence.GetNumFrames(), 3);
+		TestEqual("Folder of frame 1", Sequence.GetFrameFolder(1), FString(TEXT("00001")));
+
+		// A frame without a count is rejected
+		FFileHelper::SaveStringToFile(FString(TEXT(R"({ "frames": [ { "folder": "00000" } ] })")), *(Directory / FImageSplatSequence::SidecarFileName));
+		FImageSplatSequence Invalid;
+		TestFalse("Frame without count", Invalid.Open(Directory));
+		TestFalse("Frame without count is reported", Invalid.GetError().IsEmpty());
+	});
+
+	It("dequantizes 16-bit images with the sequence ranges", [this]()
+	{
+		if (!TestTrue(FString::Printf(TEXT("Open: %s"), *Sequence.GetError()), Sequence.Open(Directory)))
+		{
+			return;
+		}
+		FImageSplatFrame Frame;
+		if (!TestTrue(FString::Printf(TEXT("DecodeFrame: %s"), *Frame.Error), Sequence.DecodeFrame(0, Frame)))
+		{
+			return;
+		}
+		TestEqual("Num", Frame.Num(), NumSplats);
+		const float* Min[FImageSplatSequence::NumAttributes] = { PositionMin, ScaleMin, nullptr, ColorMin };
+		const float* Max[FImageSplatSequence::NumAttributes] = { PositionMax, ScaleMax, nullptr, ColorMax };
+		TestQuantizedFrame(0, Frame, Min, Max);
+	});
+
+	It("lets the ranges of a frame override those of the sequence", [this]()
+	{
+		if (!TestTrue(FString::Printf(TEXT("Open: %s"), *Sequence.GetError()), Sequence.Open(Directory)))
+		{
+			return;
+		}
+		FImageSplatFrame Frame;
+		if (!TestTrue(FString::Printf(TEXT("DecodeFrame: %s"), *Frame.Error), Sequence.DecodeFrame(1, Frame)))
+		{
+			return;
+		}
+		// The other attributes keep the sequence ranges
+		const float* Min[FImageSplatSequence::NumAttributes] = { FramePositionMin, ScaleMin, nullptr, ColorMin };
+		const float* Max[FImageSplatSequence::NumAttributes] = { FramePositionMax, ScaleMax, nullptr, ColorMax };
+		TestQuantizedFrame(1, Frame, Min, Max);
+	});
+
+	It("reads float images as the values themselves", [this]()
+	{
+		if (!TestTrue(FString::Printf(TEXT("Open: %s"), *Sequence.GetError()), Sequence.Open(Directory)))
+		{
+			return;
+		}
+		FImageSplatFrame Frame;
+		if (!TestTrue(FString::Printf(TEXT("DecodeFrame: %s"), *Frame.Error), Sequence.DecodeFrame(2, Frame)))
+		{
+			return;
+		}
+		for (int32 Attribute = 0; Attribute < FImageSplatSequence::NumAttributes; Attribute++)
+		{
+			const TArray<EGaussianSplatColumn> Columns = GetAttributeColumns(Attribute);
+			for (int32 Channel = 0; Channel < Columns.Num(); Channel++)
+			{
+				const float* Column = Frame.Column(Columns[Channel]);
+				if (!TestNotNull(FString::Printf(TEXT("%s channel %d"), GetAttributeName(Attribute), Channel), Column))
+				{
+					continue;
+				}
+				for (int32 Splat = 0; Splat < NumSplats; Splat++)
+				{
+					TestEqual(FString::Printf(TEXT("%s channel %d, splat %d"), GetAttributeName(Attribute), Channel, Splat),
+						Column[Splat], GetFloatValue(Attribute, Channel, Splat));
+				}
+			}
+		}
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,177 @@
+// SplatCloudMergeTest.cpp
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SplatCloudMerge.h"
+#include "SplatKernels.h"
+#include "Parser.h"
+#include "GaussianSplatCloud.h"
+
+BEGIN_DEFINE_SPEC(FSplatCloudMergeSpec, "UnrealSplat.Merge",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+	// Splats at Positions with the same color and size, one opacity each
+	static UGaussianSplatCloud* MakeCloud(TConstArrayView<FVector3f> Positions, TConstArrayView<float> Opacities, int32 SHDegree = 0)
+	{
+		UGaussianSplatCloud* Cloud = NewObject<UGaussianSplatCloud>();
+		Cloud->Allocate(Positions.Num(), true, false, true, true, true, true, SHDegree);
+		for (int32 i = 0; i < Positions.Num(); i++)
+		{
+			Cloud->GetPositions()[i] = Positions[i];
+			Cloud->GetOrientations()[i] = FQuat4f::Identity;
+			Cloud->GetScales()[i] = FVector3f(1.0f);
+			Cloud->GetOpacities()[i] = Opacities[i];
+			Cloud->GetZeroOrderHarmonicsArray()[i] = FVector3f(0.5f);
+		}
+		for (float& Coefficient : Cloud->GetHigherOrderHarmonicsArray())
+		{
+			Coefficient = 0.0f;
+		}
+		return Cloud;
+	}
+
+	// Flags of the concatenated sources, in source order
+	TArray<bool> FindOverlaps(TConstArrayView<const UGaussianSplatCloud*> Sources, const FGaussianSplatMergeSettings& Settings)
+	{
+		TArray<FTransform> Transforms;
+		Transforms.Init(FTransform::Identity, Sources.Num());
+		TArray<int32> SourceIndices;
+		FString Error;
+		TArray<bool> Removed;
+		const UGaussianSplatCloud* Merged = FSplatCloudMerge::Concatenate(Sources, Transforms, SourceIndices, Error);
+		if (TestNotNull(FString::Printf(TEXT("Concatenate: %s"), *Error), Merged))
+		{
+			FSplatCloudMerge::FindOverlaps(*Merged, SourceIndices, Settings, Removed);
+		}
+		return Removed;
+	}
+
+END_DEFINE_SPEC(FSplatCloudMergeSpec)
+
+void FSplatCloudMergeSpec::Define()
+{
+	Describe("FindOverlaps", [this]()
+	{
+		It("finds duplicates on either side of a cell boundary", [this]()
+		{
+			FGaussianSplatMergeSettings Settings;
+			Settings.CellSize = 10.0f;
+			// Cells (0, 0, 0), (-1, 0, 0) and (-1, -1, -1)
+			const UGaussianSplatCloud* A = MakeCloud({ FVector3f(0.1f, 0.1f, 0.1f) }, { 0.9f });
+			const UGaussianSplatCloud* B = MakeCloud({ FVector3f(-0.1f, 0.1f, 0.1f) }, { 0.8f });
+			const UGaussianSplatCloud* C = MakeCloud({ FVector3f(-0.1f, -0.1f, -0.1f) }, { 0.7f });
+			const TArray<bool> Removed = FindOverlaps({ A, B, C }, Settings);
+			if (Removed.Num() == 3)
+			{
+				TestFalse("The more opaque splat is kept", Removed[0]);
+				TestTrue("Its neighbour across the X boundary is removed", Removed[1]);
+				TestTrue("The splat across the corner of three cells is removed", Removed[2]);
+			}
+		});
+
+		It("keeps splats whose only duplicate is removed itself", [this]()
+		{
+			FGaussianSplatMergeSettings Settings;
+			Settings.CellSize = 10.0f;
+			// A0 removes B0; B0 would remove A1, but is gone
+			const UGaussianSplatCloud* A = MakeCloud({ FVector3f(0.0f), FVector3f(16.0f, 0.0f, 0.0f) }, { 0.9f, 0.7f });
+			const UGaussianSplatCloud* B = MakeCloud({ FVector3f(8.0f, 0.0f, 0.0f) }, { 0.8f });
+			const TArray<bool> Removed = FindOverlaps({ A, B }, Settings);
+			if (Removed.Num() == 3)
+			{
+				TestFalse("A0 kept", Removed[0]);
+				TestFalse("A1 kept", Removed[1]);
+				TestTrue("B0 removed", Removed[2]);
+			}
+		});
+
+		It("never removes splats of the same capture", [this]()
+		{
+			const UGaussianSplatCloud* A = MakeCloud({ FVector3f(0.0f), FVector3f(0.1f, 0.0f, 0.0f) }, { 0.9f, 0.8f });
+			const TArray<bool> Removed = FindOverlaps({ A }, FGaussianSplatMergeSettings());
+			TestEqual("Removed", Removed.FilterByPredicate([](bool bRemoved) { return bRemoved; }).Num(), 0);
+		});
+	});
+
+	Describe("Concatenate", [this]()
+	{
+		It("reports captures without a transform", [this]()
+		{
+			const UGaussianSplatCloud* A = MakeCloud({ FVector3f(0.0f) }, { 1.0f });
+			TArray<int32> SourceIndices;
+			FString Error;
+			TestNull("Missing transform", FSplatCloudMerge::Concatenate({ A, A }, { FTransform::Identity }, SourceIndices, Error));
+			TestEqual("Error", Error, FString(TEXT("2 captures but 1 transforms")));
+		});
+
+		It("rejects non-uniform and negative scales", [this]()
+		{
+			const UGaussianSplatCloud* A = MakeCloud({ FVector3f(0.0f) }, { 1.0f });
+			TArray<int32> SourceIndices;
+			FString Error;
+			FTransform Stretched(FTransform::Identity);
+			Stretched.SetScale3D(FVector(1.0, 2.0, 1.0));
+			TestNull("Non-uniform scale", FSplatCloudMerge::Concatenate({ A }, { Stretched }, SourceIndices, Error));
+			TestFalse("Non-uniform scale is reported", Error.IsEmpty());
+
+			Error.Reset();
+			FTransform Mirrored(FTransform::Identity);
+			Mirrored.SetScale3D(FVector(-2.0));
+			TestNull("Negative scale", FSplatCloudMerge::Concatenate({ A }, { Mirrored }, SourceIndices, Error));
+			TestFalse("Negative scale is reported", Error.IsEmpty());
+
+			FTransform Uniform(FTransform::Identity);
+			Uniform.SetScale3D(FVector(2.0));
+			const UGaussianSplatCloud* Scaled = FSplatCloudMerge::Concatenate({ A }, { Uniform }, SourceIndices, Error);
+			if (TestNotNull("Uniform scale", Scaled))
+			{
+				TestTrue("Scaled splat", Scaled->GetScales()[0].Equals(FVector3f(2.0f)));
+			}
+		});
+
+		It("rotates the harmonics with the splats", [this]()
+		{
+			constexpr int32 NumSplats = 16;
+			TArray<FVector3f> Positions;
+			TArray<float> Opacities;
+			Positions.Init(FVector3f(0.0f), NumSplats);
+			Opacities.Init(1.0f, NumSplats);
+			UGaussianSplatCloud* Source = MakeCloud(Positions, Opacities, 3);
+			FRandomStream Random(0x5EED);
+			for (float& Coefficient : Source->GetHigherOrderHarmonicsArray())
+			{
+				Coefficient = Random.FRandRange(-0.5f, 0.5f);
+			}
+
+			const FQuat Rotation(FVector(0.3, -0.5, 0.8).GetSafeNormal(), 1.1);
+			TArray<int32> SourceIndices;
+			FString Error;
+			const UGaussianSplatCloud* Merged = FSplatCloudMerge::Concatenate({ Source }, { FTransform(Rotation) }, SourceIndices, Error);
+			if (!TestNotNull(FString::Printf(TEXT("Concatenate: %s"), *Error), Merged))
+			{
+				return;
+			}
+
+			// The rotated splat seen along the rotated direction looks like the original
+			for (int32 View = 0; View < 8; View++)
+			{
+				const FVector3f Direction(Random.GetUnitVector());
+				TArray<FLinearColor> Expected, Actual;
+				Expected.SetNum(NumSplats);
+				Actual.SetNum(NumSplats);
+				SplatKernels::Reference::EvaluateSH<3>(Source->GetZeroOrderHarmonicsArray(), Source->GetHigherOrderHarmonicsArray(),
+					Source->GetNumSHCoefficients(), Direction, Expected);
+				SplatKernels::Reference::EvaluateSH<3>(Merged->GetZeroOrderHarmonicsArray(), Merged->GetHigherOrderHarmonicsArray(),
+					Merged->GetNumSHCoefficients(), FQuat4f(Rotation).RotateVector(Direction), Actual);
+				for (int32 i = 0; i < NumSplats; i++)
+				{
+					TestTrue(FString::Printf(TEXT("View %d, splat %d"), View, i), Actual[i].Equals(Expected[i], 1.0e-4f));
+				}
+			}
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,165 @@
+// SplatCompactEncodingTest.cpp
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SplatCompactEncoding.h"
+
+BEGIN_DEFINE_SPEC(FSplatCompactEncodingSpec, "UnrealSplat.CompactEncoding",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+	static constexpr int32 NumSamples = 10000;
+
+	// Value decoded from Value quantized in [Min, Max], as the encoder and SplatCompactDecode.ush do it
+	static FVector3f RoundTrip111110(const FVector3f& Value, const FVector3f& Min, const FVector3f& Max)
+	{
+		const FVector3f Normalized = (Value - Min) * FSplatCompactEncoding::GetNormalizationScale(Min, Max);
+		const FVector3f Decoded = FSplatCompactEncoding::DecodeUnorm111110(FSplatCompactEncoding::EncodeUnorm111110(Normalized));
+		return Min + Decoded * (Max - Min);
+	}
+
+	// Half a quantization step of each field of the 11/11/10 layout, over Extent, plus float round off
+	static FVector3f Bound111110(const FVector3f& Extent)
+	{
+		return Extent * FVector3f(0.5f / 2047.0f, 0.5f / 2047.0f, 0.5f / 1023.0f) * 1.001f + FVector3f(1.0e-4f);
+	}
+
+	// Sum over chunks of the volumes of their bounding boxes
+	static double GetChunkVolume(TConstArrayView<FLinearColor> Positions, TConstArrayView<int32> Order)
+	{
+		double Volume = 0.0;
+		for (int32 Begin = 0; Begin < Order.Num(); Begin += FSplatCompactEncoding::ChunkSize)
+		{
+			FBox3f Box(ForceInit);
+			for (int32 k = Begin; k < FMath::Min(Begin + FSplatCompactEncoding::ChunkSize, Order.Num()); k++)
+			{
+				const FLinearColor& Position = Positions[Order[k]];
+				Box += FVector3f(Position.R, Position.G, Position.B);
+			}
+			Volume += Box.GetVolume();
+		}
+		return Volume;
+	}
+
+END_DEFINE_SPEC(FSplatCompactEncodingSpec)
+
+void FSplatCompactEncodingSpec::Define()
+{
+	It("quantizes positions to half a step of their chunk range", [this]()
+	{
+		FRandomStream Random(0x5EED);
+		const FVector3f Min(-1234.5f, 20.0f, -3.0f);
+		const FVector3f Max(4321.0f, 80.0f, 500.0f);
+		const FVector3f Bound = Bound111110(Max - Min);
+		FVector3f WorstError(0.0f);
+		for (int32 i = 0; i < NumSamples; i++)
+		{
+			const FVector3f Position(Random.FRandRange(Min.X, Max.X), Random.FRandRange(Min.Y, Max.Y), Random.FRandRange(Min.Z, Max.Z));
+			WorstError = WorstError.ComponentMax((RoundTrip111110(Position, Min, Max) - Position).GetAbs());
+		}
+		TestTrue(FString::Printf(TEXT("Worst error %s within %s"), *WorstError.ToString(), *Bound.ToString()),
+			WorstError.X <= Bound.X && WorstError.Y <= Bound.Y && WorstError.Z <= Bound.Z);
+
+		// The ends of the range and flat axes come back exactly
+		TestTrue("Chunk min", RoundTrip111110(Min, Min, Max).Equals(Min, 1.0e-4f));
+		TestTrue("Chunk max", RoundTrip111110(Max, Min, Max).Equals(Max, 1.0e-3f));
+		const FVector3f Flat(7.0f, 7.0f, 7.0f);
+		TestTrue("Flat range", RoundTrip111110(Flat, Flat, Flat).Equals(Flat, 0.0f));
+	});
+
+	It("quantizes log scales to half a step of their chunk range", [this]()
+	{
+		FRandomStream Random(0x5CA1E);
+		const FVector3f LogMin(FMath::Loge(0.01f));
+		const FVector3f LogMax(FMath::Loge(300.0f));
+		const FVector3f Bound = Bound111110(LogMax - LogMin);
+		float WorstRelativeError = 0.0f;
+		for (int32 i = 0; i < NumSamples; i++)
+		{
+			const FVector3f LogScale(Random.FRandRange(LogMin.X, LogMax.X), Random.FRandRange(LogMin.Y, LogMax.Y), Random.FRandRange(LogMin.Z, LogMax.Z));
+			const FVector3f Decoded = RoundTrip111110(LogScale, LogMin, LogMax);
+			const FVector3f Error = (Decoded - LogScale).GetAbs();
+			TestTrue(FString::Printf(TEXT("Log scale %s"), *LogScale.ToString()), Error.X <= Bound.X && Error.Y <= Bound.Y && Error.Z <= Bound.Z);
+			WorstRelativeError = FMath::Max(WorstRelativeError, FMath::Abs(FMath::Exp(Decoded.Z) / FMath::Exp(LogScale.Z) - 1.0f));
+		}
+		// 10 bits over a range of factor 30000 keep the scale within 0.51 %
+		TestTrue(FString::Printf(TEXT("Worst relative scale error %g"), WorstRelativeError), WorstRelativeError <= 0.0051f);
+	});
+
+	It("keeps rotations within 0.3 degrees with the smallest three", [this]()
+	{
+		FRandomStream Random(0xA261E);
+		TArray<FQuat4f> Rotations = { FQuat4f::Identity, FQuat4f(1.0f, 0.0f, 0.0f, 0.0f), FQuat4f(0.0f, -1.0f, 0.0f, 0.0f),
+			FQuat4f(0.5f, -0.5f, 0.5f, -0.5f), FQuat4f(UE_INV_SQRT_2, 0.0f, 0.0f, -UE_INV_SQRT_2) };
+		for (int32 i = 0; i < NumSamples; i++)
+		{
+			FQuat4f Rotation(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f));
+			Rotation.Normalize();
+			Rotations.Add(Rotation);
+		}
+
+		float WorstDegrees = 0.0f;
+		for (const FQuat4f& Rotation : Rotations)
+		{
+			const FQuat4f Decoded = FSplatCompactEncoding::DecodeRotation(FSplatCompactEncoding::EncodeRotation(Rotation));
+			TestTrue(FString::Printf(TEXT("Decoded %s is normalized"), *Decoded.ToString()), FMath::IsNearlyEqual(Decoded.SizeSquared(), 1.0f, 2.0e-5f));
+			// q and -q are the same rotation
+			const float Dot = FMath::Min(FMath::Abs(Rotation | Decoded), 1.0f);
+			WorstDegrees = FMath::Max(WorstDegrees, FMath::RadiansToDegrees(2.0f * FMath::Acos(Dot)));
+		}
+		TestTrue(FString::Printf(TEXT("Worst angle %g degrees"), WorstDegrees), WorstDegrees <= 0.3f);
+	});
+
+	It("quantizes colors relative to their chunk range", [this]()
+	{
+		FRandomStream Random(0xC010);
+		const FVector3f Min(-1.8f, -0.4f, 0.2f);
+		const FVector3f Max(2.5f, 0.6f, 0.2f);
+		const FVector3f Bound = (Max - Min) * (0.5f / 255.0f) * 1.001f + FVector3f(1.0e-6f);
+		for (int32 i = 0; i < NumSamples; i++)
+		{
+			const FVector3f DC(Random.FRandRange(Min.X, Max.X), Random.FRandRange(Min.Y, Max.Y), Min.Z);
+			const float Opacity = Random.FRand();
+			float DecodedOpacity;
+			const FVector3f Normalized = (DC - Min) * FSplatCompactEncoding::GetNormalizationScale(Min, Max);
+			const FVector3f Decoded = Min + FSplatCompactEncoding::DecodeColor(FSplatCompactEncoding::EncodeColor(Normalized, Opacity), DecodedOpacity) * (Max - Min);
+			const FVector3f Error = (Decoded - DC).GetAbs();
+			TestTrue(FString::Printf(TEXT("Color %s"), *DC.ToString()), Error.X <= Bound.X && Error.Y <= Bound.Y && Error.Z <= Bound.Z);
+			TestTrue(FString::Printf(TEXT("Opacity %g"), Opacity), FMath::Abs(DecodedOpacity - Opacity) <= 0.5f / 255.0f + 1.0e-6f);
+		}
+	});
+
+	It("orders splats so chunks cover small regions", [this]()
+	{
+		FRandomStream Random(0x30A7);
+		constexpr int32 NumSplats = 16 * FSplatCompactEncoding::ChunkSize;
+		TArray<FLinearColor> Positions;
+		for (int32 i = 0; i < NumSplats; i++)
+		{
+			Positions.Add(FLinearColor(Random.FRandRange(-500.0f, 500.0f), Random.FRandRange(-500.0f, 500.0f), Random.FRandRange(0.0f, 200.0f), 1.0f));
+		}
+		TArray<int32> Order;
+		FSplatCompactEncoding::GetMortonOrder(Positions.GetData(), NumSplats, Order);
+
+		TArray<int32> Sorted = Order;
+		Sorted.Sort();
+		bool bPermutation = Sorted.Num() == NumSplats;
+		for (int32 i = 0; bPermutation && i < NumSplats; i++)
+		{
+			bPermutation = Sorted[i] == i;
+		}
+		TestTrue("The order is a permutation", bPermutation);
+
+		TArray<int32> FileOrder;
+		for (int32 i = 0; i < NumSplats; i++)
+		{
+			FileOrder.Add(i);
+		}
+		const double SortedVolume = GetChunkVolume(Positions, Order);
+		const double FileVolume = GetChunkVolume(Positions, FileOrder);
+		TestTrue(FString::Printf(TEXT("Chunk volume %g sorted, %g in file order"), SortedVolume, FileVolume), SortedVolume < 0.25 * FileVolume);
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
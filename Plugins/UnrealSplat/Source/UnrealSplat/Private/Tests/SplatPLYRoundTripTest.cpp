@@ -0,0 +1,190 @@
+// SplatPLYRoundTripTest.cpp
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Parser.h"
+#include "GaussianSplatCloud.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+BEGIN_DEFINE_SPEC(FSplatPLYRoundTripSpec, "UnrealSplat.PLY.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+	static constexpr int32 NumSplats = 64;
+	static constexpr int32 SHDegree = 3;
+
+	// Smallest scale the log survives, in centimeters (WriteCloudToPLY clamps scale / 100 to UE_SMALL_NUMBER)
+	static constexpr float MinScale = 100.0f * UE_SMALL_NUMBER;
+
+	UGaussianSplatCloud* Source = nullptr;
+	UGaussianSplatCloud* Result = nullptr;
+	FString RelativePath;
+
+	// Opacity the sigmoid gives back for the logit written for Opacity
+	static float ExpectedOpacity(float Opacity)
+	{
+		return FMath::Clamp(Opacity, FGaussianSplatCloudSource::MinOpacity, 1.0f - FGaussianSplatCloudSource::MinOpacity);
+	}
+
+	static FVector3f ExpectedScale(const FVector3f& Scale)
+	{
+		return FVector3f(FMath::Max(Scale.X, MinScale), FMath::Max(Scale.Y, MinScale), FMath::Max(Scale.Z, MinScale));
+	}
+
+	// Relative tolerance for values that go through exp/log, absolute below one
+	static bool NearlyEqualRelative(float A, float B, float Tolerance)
+	{
+		return FMath::Abs(A - B) <= Tolerance * FMath::Max(1.0f, FMath::Max(FMath::Abs(A), FMath::Abs(B)));
+	}
+
+	void FillSource()
+	{
+		Source = NewObject<UGaussianSplatCloud>();
+		Source->Allocate(NumSplats, true, true, true, true, true, true, SHDegree);
+
+		TArrayView<FVector3f> Positions = Source->GetPositions();
+		TArrayView<FVector3f> Normals = Source->GetNormals();
+		TArrayView<FQuat4f> Orientations = Source->GetOrientations();
+		TArrayView<FVector3f> Scales = Source->GetScales();
+		TArrayView<float> Opacities = Source->GetOpacities();
+		TArrayView<FVector3f> ZeroOrderHarmonics = Source->GetZeroOrderHarmonicsArray();
+		TArrayView<float> HigherOrderHarmonics = Source->GetHigherOrderHarmonicsArray();
+
+		FRandomStream Random(0x5EED);
+		for (int32 i = 0; i < NumSplats; i++)
+		{
+			Positions[i] = FVector3f(Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(-5000.0f, 5000.0f), Random.FRandRange(-5000.0f, 5000.0f));
+			Normals[i] = FVector3f(Random.GetUnitVector());
+			FQuat4f Orientation(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(0.1f, 1.0f));
+			Orientation.Normalize();
+			Orientations[i] = Orientation;
+			Scales[i] = FVector3f(Random.FRandRange(0.01f, 50.0f), Random.FRandRange(0.01f, 50.0f), Random.FRandRange(0.01f, 50.0f));
+			Opacities[i] = Random.FRandRange(0.01f, 0.99f);
+			ZeroOrderHarmonics[i] = FVector3f(Random.FRandRange(-2.0f, 2.0f), Random.FRandRange(-2.0f, 2.0f), Random.FRandRange(-2.0f, 2.0f));
+		}
+		for (float& Coefficient : HigherOrderHarmonics)
+		{
+			Coefficient = Random.FRandRange(-1.0f, 1.0f);
+		}
+
+		// Clamp edges of the logit and log inverses
+		Opacities[0] = 0.0f;
+		Opacities[1] = 1.0f;
+		Opacities[2] = FGaussianSplatCloudSource::MinOpacity;
+		Opacities[3] = 1.0f - FGaussianSplatCloudSource::MinOpacity;
+		Opacities[4] = 0.5f;
+		Scales[5] = FVector3f(0.0f, MinScale, 1.0f);
+		Scales[6] = FVector3f(MinScale * 0.5f, 0.0f, MinScale * 2.0f);
+	}
+
+END_DEFINE_SPEC(FSplatPLYRoundTripSpec)
+
+void FSplatPLYRoundTripSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		// Both UParser entry points take paths relative to the content directory
+		RelativePath = FPaths::ProjectSavedDir() / TEXT("Automation/UnrealSplat/RoundTrip.ply");
+		FPaths::MakePathRelativeTo(RelativePath, *FPaths::ProjectContentDir());
+
+		FillSource();
+
+		FString Output;
+		const bool bWritten = UParser::WriteCloudToPLY(Source, RelativePath, FGaussianSplatExportSettings(), Output);
+		TestTrue(FString::Printf(TEXT("WriteCloudToPLY succeeds: %s"), *Output), bWritten);
+
+		bool bRead = false;
+		Result = bWritten ? UParser::ParseFilePLYToCloud(RelativePath, bRead, Output) : nullptr;
+		TestTrue(FString::Printf(TEXT("ParseFilePLYToCloud succeeds: %s"), *Output), bRead && Result != nullptr);
+	});
+
+	AfterEach([this]()
+	{
+		IFileManager::Get().Delete(*(FPaths::ProjectContentDir() + RelativePath), false, true, true);
+		Source = nullptr;
+		Result = nullptr;
+	});
+
+	It("keeps every attribute group and the SH degree", [this]()
+	{
+		if (!Result)
+		{
+			return;
+		}
+		TestEqual("Num", Result->Num(), NumSplats);
+		TestEqual("SH coefficients", Result->GetNumSHCoefficients(), Source->GetNumSHCoefficients());
+		TestEqual("Normals", Result->GetNormals().Num(), NumSplats);
+		TestEqual("Orientations", Result->GetOrientations().Num(), NumSplats);
+		TestEqual("Scales", Result->GetScales().Num(), NumSplats);
+		TestEqual("Opacities", Result->GetOpacities().Num(), NumSplats);
+		TestEqual("Zero order harmonics", Result->GetZeroOrderHarmonicsArray().Num(), NumSplats);
+		TestEqual("Higher order harmonics", Result->GetHigherOrderHarmonicsArray().Num(), Source->GetHigherOrderHarmonicsArray().Num());
+	});
+
+	It("reproduces positions, normals, orientations and harmonics", [this]()
+	{
+		if (!Result || Result->Num() != NumSplats || Result->GetNumSHCoefficients() != Source->GetNumSHCoefficients())
+		{
+			return;
+		}
+		for (int32 i = 0; i < NumSplats; i++)
+		{
+			// Only the / 100 and * 100 round off
+			TestTrue(FString::Printf(TEXT("Position %d"), i), Result->GetPositions()[i].Equals(Source->GetPositions()[i], 1.0e-3f));
+			TestTrue(FString::Printf(TEXT("Normal %d"), i), Result->GetNormals()[i].Equals(Source->GetNormals()[i], 0.0f));
+			TestTrue(FString::Printf(TEXT("Orientation %d"), i), Result->GetOrientations()[i].Equals(Source->GetOrientations()[i], 1.0e-6f));
+			TestTrue(FString::Printf(TEXT("Zero order harmonics %d"), i),
+				Result->GetZeroOrderHarmonicsArray()[i].Equals(Source->GetZeroOrderHarmonicsArray()[i], 0.0f));
+		}
+		const TArrayView<float> Expected = Source->GetHigherOrderHarmonicsArray();
+		const TArrayView<float> Actual = Result->GetHigherOrderHarmonicsArray();
+		int32 Mismatches = 0;
+		for (int32 i = 0; i < Expected.Num(); i++)
+		{
+			Mismatches += Actual[i] != Expected[i] ? 1 : 0;
+		}
+		TestEqual("Higher order harmonics mismatches", Mismatches, 0);
+	});
+
+	It("inverts the log scale, clamping at UE_SMALL_NUMBER", [this]()
+	{
+		if (!Result || Result->Num() != NumSplats)
+		{
+			return;
+		}
+		for (int32 i = 0; i < NumSplats; i++)
+		{
+			const FVector3f Expected = ExpectedScale(Source->GetScales()[i]);
+			const FVector3f Actual = Result->GetScales()[i];
+			const bool bEqual = NearlyEqualRelative(Actual.X, Expected.X, 1.0e-5f) && NearlyEqualRelative(Actual.Y, Expected.Y, 1.0e-5f)
+				&& NearlyEqualRelative(Actual.Z, Expected.Z, 1.0e-5f);
+			TestTrue(FString::Printf(TEXT("Scale %d: expected %s, got %s"), i, *Expected.ToString(), *Actual.ToString()), bEqual);
+		}
+		// Below the clamp every scale comes back as the clamp itself
+		TestTrue("Zero scale clamps", FMath::IsNearlyEqual(Result->GetScales()[5].X, MinScale, MinScale * 1.0e-4f));
+		TestTrue("Half the clamp clamps", FMath::IsNearlyEqual(Result->GetScales()[6].X, MinScale, MinScale * 1.0e-4f));
+	});
+
+	It("inverts the logit opacity, clamping at MinOpacity", [this]()
+	{
+		if (!Result || Result->Num() != NumSplats)
+		{
+			return;
+		}
+		for (int32 i = 0; i < NumSplats; i++)
+		{
+			const float Expected = ExpectedOpacity(Source->GetOpacities()[i]);
+			const float Actual = Result->GetOpacities()[i];
+			// Relative to the distance from the nearer bound, so the edges are checked as tightly as the middle
+			const float Tolerance = FMath::Max(1.0e-4f * FMath::Min(Expected, 1.0f - Expected), 2.5e-7f);
+			TestTrue(FString::Printf(TEXT("Opacity %d: expected %.9g, got %.9g"), i, Expected, Actual),
+				FMath::IsNearlyEqual(Actual, Expected, Tolerance));
+		}
+		TestTrue("Zero opacity stays above zero", Result->GetOpacities()[0] > 0.0f);
+		TestTrue("Full opacity stays below one", Result->GetOpacities()[1] < 1.0f);
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,182 @@
+// SplatTexturePagesTest.cpp
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SplatTexturePages.h"
+#include "Parser.h"
+#include "GaussianSplatCloud.h"
+#include "EditorAssetLibrary.h"
+#include "HAL/IConsoleManager.h"
+
+BEGIN_DEFINE_SPEC(FSplatTexturePagesSpec, "UnrealSplat.TexturePages",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+	// The default limit, UnrealSplat.MaxTextureDimension = 0
+	static constexpr int32 MaxDimension = 16384;
+	static constexpr int64 MaxTexels = int64(MaxDimension) * MaxDimension;
+
+	// Checks that the pages cover [0, NumSplats) in order and that every texture of every page fits the limit
+	void TestLayout(int64 NumSplats, int32 SHDegree, int32 ExpectedNumPages)
+	{
+		const int32 SplatsPerPage = FSplatTexturePages::GetSplatsPerPage(SHDegree, MaxTexels);
+		const TArray<FSplatPageRange> Pages = FSplatTexturePages::GetPages(NumSplats, SplatsPerPage);
+		TestEqual("Pages", Pages.Num(), ExpectedNumPages);
+
+		int64 NextSplat = 0;
+		for (int32 PageIndex = 0; PageIndex < Pages.Num(); PageIndex++)
+		{
+			const FSplatPageRange& Page = Pages[PageIndex];
+			TestEqual(FString::Printf(TEXT("FirstSplat of page %d"), PageIndex), int64(Page.FirstSplat), NextSplat);
+			if (PageIndex < Pages.Num() - 1)
+			{
+				TestEqual(FString::Printf(TEXT("Page %d is full"), PageIndex), Page.NumSplats, SplatsPerPage);
+			}
+			else
+			{
+				TestTrue(FString::Printf(TEXT("Last page %d is not empty"), PageIndex), Page.NumSplats > 0 && Page.NumSplats <= SplatsPerPage);
+			}
+			NextSplat += Page.NumSplats;
+
+			// Positions, scales, rotations and colors, then the harmonics bands the degree writes
+			TArray<int64> TexelsPerTexture = { Page.NumSplats, Page.NumSplats, Page.NumSplats, Page.NumSplats };
+			if (SHDegree >= 1)
+			{
+				TexelsPerTexture.Add(int64(Page.NumSplats) * 3);
+			}
+			if (SHDegree >= 2)
+			{
+				TexelsPerTexture.Add(int64(Page.NumSplats) * 5);
+			}
+			if (SHDegree >= 3)
+			{
+				TexelsPerTexture.Add(int64(Page.NumSplats) * 4);
+				TexelsPerTexture.Add(int64(Page.NumSplats) * 3);
+			}
+			for (int64 Texels : TexelsPerTexture)
+			{
+				int32 Width, Height;
+				FSplatTexturePages::GetTextureSize(Texels, Width, Height);
+				const FString What = FString::Printf(TEXT("Page %d, texture of %lld texels (%d x %d)"), PageIndex, Texels, Width, Height);
+				TestTrue(What + TEXT(" fits the limit"), Width <= MaxDimension && Height <= MaxDimension);
+				TestTrue(What + TEXT(" holds every texel"), int64(Width) * Height >= Texels);
+			}
+		}
+		TestEqual("Splats of all pages", NextSplat, NumSplats);
+	}
+
+	// Preprocessed with UnrealSplat.MaxTextureDimension = PagedDimension, so every page holds PagedDimension^2 splats
+	static constexpr int32 PagedDimension = 64;
+	static constexpr int32 SplatsPerPagedPage = PagedDimension * PagedDimension;
+	IConsoleVariable* MaxTextureDimension = nullptr;
+	int32 SavedMaxTextureDimension = 0;
+
+	// Preprocesses NumSplats splats without harmonics and returns the peak bytes held, or -1 on failure
+	int64 PreprocessPagedCloud(int32 NumSplats, int32 ExpectedNumPages)
+	{
+		UGaussianSplatCloud* Cloud = NewObject<UGaussianSplatCloud>();
+		Cloud->Allocate(NumSplats, true, false, true, true, true, true, 0);
+		FRandomStream Random(NumSplats);
+		for (int32 i = 0; i < NumSplats; i++)
+		{
+			Cloud->GetPositions()[i] = FVector3f(Random.FRandRange(-500.0f, 500.0f), Random.FRandRange(-500.0f, 500.0f), Random.FRandRange(0.0f, 200.0f));
+			Cloud->GetOrientations()[i] = FQuat4f::Identity;
+			Cloud->GetScales()[i] = FVector3f(1.0f);
+			Cloud->GetOpacities()[i] = 0.5f;
+			Cloud->GetZeroOrderHarmonicsArray()[i] = FVector3f(0.0f);
+		}
+
+		bool bSuccess = false;
+		FString Output;
+		TArray<FTextureLocations> Pages;
+		int64 PeakBytes = -1;
+		UParser::PreprocessCloudToFolder(Cloud, TEXT("UnrealSplatAutomation/Paging"), FGaussianSplatPreprocessSettings(), bSuccess, Output, Pages, &PeakBytes);
+		if (!TestTrue(FString::Printf(TEXT("PreprocessCloudToFolder succeeds: %s"), *Output), bSuccess))
+		{
+			return -1;
+		}
+		TestEqual(FString::Printf(TEXT("Pages of %d splats"), NumSplats), Pages.Num(), ExpectedNumPages);
+		return PeakBytes;
+	}
+
+END_DEFINE_SPEC(FSplatTexturePagesSpec)
+
+void FSplatTexturePagesSpec::Define()
+{
+	Describe("GetPages", [this]()
+	{
+		It("splits a 150M splat model with L3 harmonics into three pages", [this]()
+		{
+			TestEqual("Splats per page", FSplatTexturePages::GetSplatsPerPage(3, MaxTexels), int32(MaxTexels / 5));
+			TestLayout(150000000, 3, 3);
+		});
+
+		It("keeps a 150M splat model without harmonics on one page", [this]()
+		{
+			TestLayout(150000000, 0, 1);
+		});
+
+		It("fills pages exactly at the page size", [this]()
+		{
+			const int32 SplatsPerPage = FSplatTexturePages::GetSplatsPerPage(1, MaxTexels);
+			TestLayout(int64(SplatsPerPage) * 2, 1, 2);
+			TestLayout(int64(SplatsPerPage) * 2 + 1, 1, 3);
+		});
+
+		It("has no pages for an empty model", [this]()
+		{
+			TestEqual("Pages", FSplatTexturePages::GetPages(0, 1024).Num(), 0);
+		});
+	});
+
+	Describe("PreprocessCloudToFolder", [this]()
+	{
+		BeforeEach([this]()
+		{
+			MaxTextureDimension = IConsoleManager::Get().FindConsoleVariable(TEXT("UnrealSplat.MaxTextureDimension"));
+			if (TestNotNull("UnrealSplat.MaxTextureDimension", MaxTextureDimension))
+			{
+				SavedMaxTextureDimension = MaxTextureDimension->GetInt();
+				MaxTextureDimension->Set(PagedDimension, ECVF_SetByCode);
+			}
+		});
+
+		AfterEach([this]()
+		{
+			if (MaxTextureDimension)
+			{
+				MaxTextureDimension->Set(SavedMaxTextureDimension, ECVF_SetByCode);
+			}
+			UEditorAssetLibrary::DeleteDirectory(TEXT("/Game/UnrealSplatAutomation"));
+		});
+
+		It("holds the texels of one page at a time, whatever the number of pages", [this]()
+		{
+			if (!MaxTextureDimension)
+			{
+				return;
+			}
+			// Position, scale, rotation and color textures of one full page, staged as RGBA32F
+			const int64 PageBytes = 4 * int64(SplatsPerPagedPage) * int64(sizeof(FLinearColor));
+			const int64 ThreePagePeak = PreprocessPagedCloud(3 * SplatsPerPagedPage, 3);
+			const int64 NinePagePeak = PreprocessPagedCloud(9 * SplatsPerPagedPage, 9);
+			TestEqual("Peak bytes of 3 pages", ThreePagePeak, PageBytes);
+			TestEqual("Peak bytes of 9 pages", NinePagePeak, PageBytes);
+
+			// A partial last page holds no more than a full one
+			TestEqual("Peak bytes of 2.5 pages", PreprocessPagedCloud(5 * SplatsPerPagedPage / 2, 3), PageBytes);
+		});
+	});
+
+	Describe("GetPageTextureName", [this]()
+	{
+		It("keeps the name of page 0 and suffixes the others", [this]()
+		{
+			TestEqual("Page 0", FSplatTexturePages::GetPageTextureName(TEXT("positiontexture"), 0), FString(TEXT("positiontexture")));
+			TestEqual("Page 2", FSplatTexturePages::GetPageTextureName(TEXT("positiontexture"), 2), FString(TEXT("positiontexture_2")));
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
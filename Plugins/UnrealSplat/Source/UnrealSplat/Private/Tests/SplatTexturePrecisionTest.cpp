@@ -0,0 +1,201 @@
+// SplatTexturePrecisionTest.cpp
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Parser.h"
+#include "SplatKernels.h"
+#include "SplatTexturePages.h"
+#include "SplatCompactEncoding.h"
+#include "GaussianSplatCloud.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+BEGIN_DEFINE_SPEC(FSplatTexturePrecisionSpec, "UnrealSplat.TexturePrecision",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+	// 64 x 64 texels per splat texture, so only the harmonics and chunk range textures are padded
+	static constexpr int32 NumSplats = 4096;
+	static constexpr int32 SHDegree = 1;
+
+	// Texels of the texture BeginTexture creates for NumPixels texels
+	static int64 GetTexels(int64 NumPixels)
+	{
+		int32 Width, Height;
+		FSplatTexturePages::GetTextureSize(NumPixels, Width, Height);
+		return int64(Width) * Height;
+	}
+
+	// Values across the range of half: zeros, subnormals, rounding ties, the largest finite half and overflow
+	static TArray<FLinearColor> MakeTexels(int32 Num)
+	{
+		static const float Specials[] = { 0.0f, -0.0f, 1.0f, -1.0f, 5.9604645e-8f, 6.1035156e-5f, 1.00048828125f, 2049.0f, 65504.0f, 65520.0f, -1.0e6f, 3.14159265f };
+		FRandomStream Random(0x4A1F);
+		TArray<FLinearColor> Texels;
+		for (int32 i = 0; i < Num; i++)
+		{
+			float Values[4];
+			for (int32 Channel = 0; Channel < 4; Channel++)
+			{
+				const int32 Index = i * 4 + Channel;
+				Values[Channel] = Index < int32(UE_ARRAY_COUNT(Specials)) ? Specials[Index]
+					: Random.FRandRange(-1.0f, 1.0f) * FMath::Pow(2.0f, Random.FRandRange(-20.0f, 16.0f));
+			}
+			Texels.Add(FLinearColor(Values[0], Values[1], Values[2], Values[3]));
+		}
+		return Texels;
+	}
+
+	static FLinearColor ToLinear(const FFloat16Color& Color)
+	{
+		return FLinearColor(Color.R.GetFloat(), Color.G.GetFloat(), Color.B.GetFloat(), Color.A.GetFloat());
+	}
+
+	// Checks the SIMD EncodeHalf bit for bit against the reference for Num texels, and that it writes no further
+	void TestEncodeHalf(int32 Num, const FLinearColor& Offset, const FLinearColor& Scale)
+	{
+		const TArray<FLinearColor> Texels = MakeTexels(Num);
+		FFloat16Color Guard;
+		Guard.R.Encoded = Guard.G.Encoded = Guard.B.Encoded = Guard.A.Encoded = 0xDEAD;
+		TArray<FFloat16Color> Expected, Actual;
+		Expected.Init(Guard, Num + 1);
+		Actual.Init(Guard, Num + 1);
+		SplatKernels::Reference::EncodeHalf(Texels.GetData(), Num, Offset, Scale, Expected.GetData());
+		SplatKernels::EncodeHalf(Texels.GetData(), Num, Offset, Scale, Actual.GetData());
+
+		int32 Mismatches = 0;
+		for (int32 i = 0; i < Num; i++)
+		{
+			const bool bEqual = Actual[i].R.Encoded == Expected[i].R.Encoded && Actual[i].G.Encoded == Expected[i].G.Encoded
+				&& Actual[i].B.Encoded == Expected[i].B.Encoded && Actual[i].A.Encoded == Expected[i].A.Encoded;
+			if (!bEqual && Mismatches++ < 8)
+			{
+				AddError(FString::Printf(TEXT("Num %d, texel %d of %s: expected %s, got %s"), Num, i, *Texels[i].ToString(),
+					*ToLinear(Expected[i]).ToString(), *ToLinear(Actual[i]).ToString()));
+			}
+		}
+		TestEqual(FString::Printf(TEXT("Mismatches for %d texels"), Num), Mismatches, 0);
+		if (Num % 2 == 1)
+		{
+			// The last texel of an odd count is converted on its own, after the pairs
+			TestTrue(FString::Printf(TEXT("Tail texel of %d"), Num), Actual[Num - 1].R.Encoded == Expected[Num - 1].R.Encoded
+				&& Actual[Num - 1].A.Encoded == Expected[Num - 1].A.Encoded);
+		}
+		TestTrue(FString::Printf(TEXT("Nothing written past %d texels"), Num), Actual[Num].R.Encoded == 0xDEAD && Actual[Num].A.Encoded == 0xDEAD);
+	}
+
+	// The SIMD path only runs while the reference kernels are not forced
+	IConsoleVariable* ReferenceKernels = nullptr;
+	bool bReferenceKernels = false;
+
+	FString RelativePath;
+
+END_DEFINE_SPEC(FSplatTexturePrecisionSpec)
+
+void FSplatTexturePrecisionSpec::Define()
+{
+	Describe("EncodeHalf", [this]()
+	{
+		BeforeEach([this]()
+		{
+			ReferenceKernels = IConsoleManager::Get().FindConsoleVariable(TEXT("UnrealSplat.ReferenceKernels"));
+			if (ReferenceKernels)
+			{
+				bReferenceKernels = ReferenceKernels->GetBool();
+				ReferenceKernels->Set(false, ECVF_SetByCode);
+			}
+		});
+
+		AfterEach([this]()
+		{
+			if (ReferenceKernels)
+			{
+				ReferenceKernels->Set(bReferenceKernels, ECVF_SetByCode);
+			}
+		});
+
+		It("matches the reference for an even number of texels", [this]()
+		{
+			TestEncodeHalf(1024, FLinearColor(0.0f, 0.0f, 0.0f, 0.0f), FLinearColor(1.0f, 1.0f, 1.0f, 1.0f));
+			TestEncodeHalf(2, FLinearColor(0.0f, 0.0f, 0.0f, 0.0f), FLinearColor(1.0f, 1.0f, 1.0f, 1.0f));
+		});
+
+		It("matches the reference for an odd number of texels, including the tail", [this]()
+		{
+			TestEncodeHalf(1023, FLinearColor(0.0f, 0.0f, 0.0f, 0.0f), FLinearColor(1.0f, 1.0f, 1.0f, 1.0f));
+			TestEncodeHalf(3, FLinearColor(0.0f, 0.0f, 0.0f, 0.0f), FLinearColor(1.0f, 1.0f, 1.0f, 1.0f));
+			TestEncodeHalf(1, FLinearColor(0.0f, 0.0f, 0.0f, 0.0f), FLinearColor(1.0f, 1.0f, 1.0f, 1.0f));
+		});
+
+		It("applies the offset and scale of each channel", [this]()
+		{
+			const FLinearColor Offset(1.0f, -2.0f, 300.0f, 0.5f);
+			const FLinearColor Scale(0.5f, 2.0f, 0.001f, 1000.0f);
+			TestEncodeHalf(257, Offset, Scale);
+			TestEncodeHalf(256, Offset, Scale);
+		});
+	});
+
+	Describe("EstimatedTextureBytes", [this]()
+	{
+		BeforeEach([this]()
+		{
+			RelativePath = FPaths::ProjectSavedDir() / TEXT("Automation/UnrealSplat/Estimate.ply");
+			FPaths::MakePathRelativeTo(RelativePath, *FPaths::ProjectContentDir());
+
+			UGaussianSplatCloud* Cloud = NewObject<UGaussianSplatCloud>();
+			Cloud->Allocate(NumSplats, true, true, true, true, true, true, SHDegree);
+			FRandomStream Random(0xB17E5);
+			for (FVector3f& Position : Cloud->GetPositions())
+			{
+				Position = FVector3f(Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f), Random.FRandRange(-100.0f, 100.0f));
+			}
+			FString Output;
+			const bool bWritten = UParser::WriteCloudToPLY(Cloud, RelativePath, FGaussianSplatExportSettings(), Output);
+			TestTrue(FString::Printf(TEXT("WriteCloudToPLY succeeds: %s"), *Output), bWritten);
+		});
+
+		AfterEach([this]()
+		{
+			IFileManager::Get().Delete(*(FPaths::ProjectContentDir() + RelativePath), false, true, true);
+		});
+
+		// Bytes of the position, scale, rotation and color textures and the L1 harmonics texture for each precision
+		auto TestEstimate = [this](EGaussianSplatTexturePrecision Precision, int64 ExpectedBytes)
+		{
+			FGaussianSplatPreprocessSettings Settings;
+			Settings.PositionPrecision = Precision;
+			Settings.ScalePrecision = Precision;
+			Settings.RotationPrecision = Precision;
+			Settings.ColorPrecision = Precision;
+			Settings.HarmonicsPrecision = Precision;
+			FGaussianSplatProbeResult Probe;
+			if (TestTrue("ProbePLYWithSettings succeeds", UParser::ProbePLYWithSettings(RelativePath, Settings, Probe)))
+			{
+				TestEqual("Splats", Probe.NumSplats, int64(NumSplats));
+				TestEqual("SH degree", Probe.SHDegree, SHDegree);
+				TestEqual("Estimated texture bytes", Probe.EstimatedTextureBytes, ExpectedBytes);
+			}
+		};
+
+		It("counts 16 bytes per texel in full precision", [this, TestEstimate]()
+		{
+			TestEstimate(EGaussianSplatTexturePrecision::Full, 4 * GetTexels(NumSplats) * 16 + GetTexels(NumSplats * 3) * 16);
+		});
+
+		It("counts 8 bytes per texel in half precision, but 16 for positions", [this, TestEstimate]()
+		{
+			TestEstimate(EGaussianSplatTexturePrecision::Half, GetTexels(NumSplats) * 16 + 3 * GetTexels(NumSplats) * 8 + GetTexels(NumSplats * 3) * 8);
+		});
+
+		It("counts 4 bytes per texel and the chunk ranges for compact textures, with half precision harmonics", [this, TestEstimate]()
+		{
+			const int64 RangeTexels = GetTexels(FMath::DivideAndRoundUp(NumSplats, FSplatCompactEncoding::ChunkSize) * FSplatCompactEncoding::RangeTexelsPerChunk);
+			TestEstimate(EGaussianSplatTexturePrecision::Compact, 4 * GetTexels(NumSplats) * 4 + RangeTexels * 16 + GetTexels(NumSplats * 3) * 8);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -7,6 +7,8 @@
 #include "WorkspaceMenuStructureModule.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "Framework/Docking/TabManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "ShaderCore.h"
 
 IMPLEMENT_MODULE(FUnrealSplatModule, UnrealSplat)
 
@@ -63,6 +65,13 @@ void FUnrealSplatModule::StartupModule()
 {
 	UE_LOG(LogTemp, Log, TEXT("UnrealSplat: Module starting up"));
 
+	// Shaders/ holds the HLSL that decodes compact textures, included by materials and Niagara as /Plugin/UnrealSplat/...
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UnrealSplat"));
+	if (Plugin.IsValid() && !AllShaderSourceDirectoryMappings().Contains(TEXT("/Plugin/UnrealSplat")))
+	{
+		AddShaderSourceDirectoryMapping(TEXT("/Plugin/UnrealSplat"), FPaths::Combine(Plugin->GetBaseDir(), TEXT("Shaders")));
+	}
+
 	// Register the tab spawner
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(
 		PreprocessorTabName,
@@ -0,0 +1,93 @@
+// CompressedSplatDecoder.h
+// Dequantization of the chunk-quantized "compressed.ply" splat layout
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatBuffer.h"
+
+class FSplatArena;
+
+/**
+ * Decodes the compressed PLY layout written by SuperSplat and the PlayCanvas tools:
+ * - element "chunk": min/max of position and (log) scale for every 256 splats, optionally of color
+ * - element "vertex": uint32 packed_position and packed_scale (11/10/11 bits, relative to the chunk),
+ *   packed_rotation (index of the largest component + the other three in 10 bits each) and
+ *   packed_color (8 bits each of color and sigmoid opacity)
+ * - element "sh" (optional): f_rest_* as uchar, quantized to [-4, 4)
+ *
+ * Splats are decoded back into the raw columns of a float 3DGS PLY (log scale, logit opacity, f_dc),
+ * so decoded batches go through the same conversion as any other file.
+ */
+class UNREALSPLAT_API FCompressedSplatDecoder
+{
+public:
+	static constexpr uint32 SplatsPerChunk = 256;
+
+	FCompressedSplatDecoder();
+
+	/** True if the reader's file has the chunk and packed vertex elements of the compressed layout */
+	static bool IsCompressedLayout(miniply::PLYReader& Reader);
+
+	/** Spherical harmonics degree of the file's "sh" element (9, 24 or 45 f_rest_* properties), 0 if it has none */
+	static int32 GetSHDegree(miniply::PLYReader& Reader);
+
+	/**
+	 * Makes decoded batches take their storage from Arena, see FGaussianSplatBuffer::SetArena().
+	 * Both elements share one allocation, sized for harmonics up to SHDegree as in GetBatchBytes().
+	 */
+	void SetArena(FSplatArena* InArena, int32 SHDegree);
+
+	/** Bytes of column storage needed for NumRows rows of either element, with harmonics up to SHDegree */
+	static int64 GetBatchBytes(uint32 NumRows, int32 SHDegree);
+
+	/** Loads the bounds of every chunk. The reader's current element must be "chunk". */
+	bool LoadChunks(miniply::PLYReader& Reader);
+
+	/**
+	 * Dequantizes the loaded rows of the "vertex" element in parallel. FirstRow is the element row of the
+	 * first loaded row, which selects the chunks. Afterwards the position, scale, rotation, base color
+	 * and opacity columns hold the batch.
+	 */
+	bool DecodeVertices(const miniply::PLYReader& Reader, uint32 FirstRow);
+
+	/** Dequantizes the loaded rows of the "sh" element, up to SHDegree. Afterwards only the f_rest_* columns hold data. */
+	bool DecodeHarmonics(const miniply::PLYReader& Reader, int32 SHDegree);
+
+	/** Releases the column storage and the chunks */
+	void Reset();
+
+	int32 Num() const { return NumSplats; }
+
+	/** Contiguous column data of the last decoded batch, or nullptr if that batch did not contain the column */
+	const float* Column(EGaussianSplatColumn InColumn) const { return Columns[int32(InColumn)]; }
+
+	/** See FGaussianSplatBuffer::RestChannelStride() */
+	int32 RestChannelStride() const { return FGaussianSplatBuffer::NumSHCoefficientsForDegree(FileSHDegree); }
+
+private:
+	/** Chunk bounds, in the order of the chunk element's properties */
+	enum EChunkBound
+	{
+		MinX, MinY, MinZ, MaxX, MaxY, MaxZ,
+		MinScaleX, MinScaleY, MinScaleZ, MaxScaleX, MaxScaleY, MaxScaleZ,
+		MinR, MinG, MinB, MaxR, MaxG, MaxB,
+		NumChunkBounds
+	};
+
+	float* AllocateColumns(int32 NumColumnsUsed, int32 InNumSplats);
+
+	TArray<float> Chunks;
+	int32 NumChunks;
+	bool bChunkColors;
+
+	float* Columns[FGaussianSplatBuffer::NumColumns];
+	TArray<float> Storage;
+	TArray<uint32> Packed;
+	FSplatArena* Arena;
+	int32 ArenaColumns;
+	float* ArenaStorage;
+	int64 ArenaStorageSize;
+	int32 NumSplats;
+	int32 FileSHDegree;
+};
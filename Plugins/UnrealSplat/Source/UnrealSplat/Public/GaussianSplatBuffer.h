@@ -0,0 +1,150 @@
+// GaussianSplatBuffer.h
+// Structure-of-arrays storage for the raw vertex columns of a 3DGS PLY file
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace miniply
+{
+	struct PLYElement;
+	class PLYReader;
+}
+
+class FSplatArena;
+
+/**
+ * Vertex columns known to the splat pipeline, in the order the INRIA trainer writes them:
+ * x, y, z, nx, ny, nz, f_dc_0..2, f_rest_0..44, opacity, scale_0..2, rot_0..3
+ */
+enum class EGaussianSplatColumn : uint8
+{
+	X,
+	Y,
+	Z,
+	NX,
+	NY,
+	NZ,
+	DC0,
+	DC1,
+	DC2,
+	Rest0,
+	Opacity = Rest0 + 45,
+	Scale0,
+	Scale1,
+	Scale2,
+	Rot0,
+	Rot1,
+	Rot2,
+	Rot3,
+
+	Num
+};
+
+/**
+ * Raw (not yet activated) splat columns of a PLY vertex element.
+ * Property indexes are resolved once from the header, after which every column is a
+ * contiguous float array that the conversion loops can index directly.
+ */
+struct FGaussianSplatBuffer
+{
+	static constexpr int32 NumColumns = int32(EGaussianSplatColumn::Num);
+	static constexpr int32 NumRestCoefficients = 45;
+
+	/** Row stride of the canonical INRIA layout: every column as float32, in EGaussianSplatColumn order */
+	static constexpr int32 CanonicalRowStride = NumColumns * sizeof(float);
+
+	/** Rows handed to each ParallelFor task when decoding or converting splats */
+	static constexpr int32 RowsPerTask = 16 * 1024;
+
+	/** Rows per batch when streaming a vertex element through the buffer */
+	static constexpr uint32 RowsPerBatch = 64 * 1024;
+
+	/** Number of RowsPerTask-sized tasks covering NumRows rows */
+	static int32 NumTasks(int32 NumRows) { return FMath::DivideAndRoundUp(NumRows, RowsPerTask); }
+
+	FGaussianSplatBuffer();
+
+	/** Number of spherical harmonics coefficients per color channel for bands 1 up to Degree (band 0 is f_dc_*) */
+	static constexpr int32 NumSHCoefficientsForDegree(int32 Degree) { return (Degree + 1) * (Degree + 1) - 1; }
+
+	/** Number of f_rest_* coefficients (all three channels) needed for spherical harmonics up to Degree */
+	static constexpr int32 NumRestCoefficientsForDegree(int32 Degree) { return 3 * NumSHCoefficientsForDegree(Degree); }
+
+	/**
+	 * Looks up the PLY property index of every known column in Element. Unknown properties are ignored.
+	 * The spherical harmonics degree is detected from the number of f_rest_* properties (9, 24 or 45);
+	 * any other count cannot be split into channels and is treated as degree 0.
+	 */
+	void Resolve(const miniply::PLYElement& Element);
+
+	/** Forgets resolved columns the caller has no use for, so that they are neither decoded nor stored */
+	void Exclude(EGaussianSplatColumn First, int32 Count = 1);
+
+	/** Forgets the f_rest_* coefficients of every band above Degree, in all three channels */
+	void ExcludeSHAbove(int32 Degree);
+
+	/**
+	 * Makes Load() take its column storage from Arena instead of the heap. The arena must outlive the
+	 * loaded data; storage is reused for later batches that fit into the first one.
+	 */
+	void SetArena(FSplatArena* InArena) { Arena = InArena; }
+
+	/** Bytes of column storage Load() needs for NumRows rows of the resolved columns */
+	int64 GetBatchBytes(uint32 NumRows) const;
+
+	/** Restricts decoding of the reader's current element to the resolved columns. Call before loading. */
+	bool Project(miniply::PLYReader& Reader) const;
+
+	/**
+	 * Extracts all resolved columns of the reader's loaded rows into owned storage, in parallel row ranges.
+	 * Inside PLYReader::load_element_batches() these are the rows of the current batch; the storage is
+	 * reused from one batch to the next.
+	 */
+	bool Load(const miniply::PLYReader& Reader);
+
+	/** Releases the column storage */
+	void Reset();
+
+	int32 Num() const { return NumSplats; }
+
+	/** Contiguous column data, or nullptr if the column is not present in the file */
+	const float* Column(EGaussianSplatColumn InColumn) const { return Columns[int32(InColumn)]; }
+	const float* RestColumn(int32 Coefficient) const { return Columns[int32(EGaussianSplatColumn::Rest0) + Coefficient]; }
+
+	/** Spherical harmonics degree of the resolved element (0 = base color only) */
+	int32 SHDegree() const { return FileSHDegree; }
+
+	/**
+	 * Distance between the f_rest_* indexes of one coefficient in consecutive color channels.
+	 * Trainers store the rest coefficients channel-major, so this depends on the file's degree.
+	 */
+	int32 RestChannelStride() const { return NumSHCoefficientsForDegree(FileSHDegree); }
+
+	bool HasPosition() const { return HasColumns(EGaussianSplatColumn::X, 3); }
+	bool HasNormals() const { return HasColumns(EGaussianSplatColumn::NX, 3); }
+	bool HasZeroOrderHarmonics() const { return HasColumns(EGaussianSplatColumn::DC0, 3); }
+	bool HasHigherOrderHarmonics() const { return FileSHDegree > 0; }
+	bool HasOpacity() const { return HasColumns(EGaussianSplatColumn::Opacity, 1); }
+	bool HasScale() const { return HasColumns(EGaussianSplatColumn::Scale0, 3); }
+	bool HasRotation() const { return HasColumns(EGaussianSplatColumn::Rot0, 4); }
+
+	/** True if Element holds exactly the canonical columns as float32 in INRIA order, with nothing else in its rows */
+	static bool IsCanonicalLayout(const miniply::PLYElement& Element);
+
+	/** PLY property name of a column, e.g. "f_rest_12" */
+	static const char* ColumnName(int32 InColumn);
+
+private:
+	bool HasColumns(EGaussianSplatColumn First, int32 Count) const;
+	int32 NumResolvedColumns() const;
+
+	uint32 PropertyIndices[NumColumns];
+	float* Columns[NumColumns];
+	TArray<float> Storage;
+	FSplatArena* Arena;
+	float* ArenaStorage;
+	int64 ArenaStorageSize;
+	int32 NumSplats;
+	int32 FileSHDegree;
+};
@@ -0,0 +1,210 @@
+// GaussianSplatCloud.h
+// Compact float32 structure-of-arrays container for parsed splats
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Parser.h"
+#include "GaussianSplatBuffer.h"
+#include "GaussianSplatCloud.generated.h"
+
+/**
+ * Splats of a PLY file with their activations applied, in Unreal space and units:
+ * the same values as FGaussianSplatData, stored as one contiguous float32 array per attribute.
+ *
+ * Higher order spherical harmonics are a single flat array of Num() * GetNumSHCoefficients()
+ * RGB triplets, splat-major. Coefficient j of splat i starts at (i * GetNumSHCoefficients() + j) * 3.
+ *
+ * Blueprints hold the cloud as an object handle and read it through the per-splat accessors,
+ * so the arrays themselves are never copied.
+ */
+UCLASS(BlueprintType)
+class UNREALSPLAT_API UGaussianSplatCloud : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Resizes every attribute the file provides to InNumSplats (contents uninitialized) and drops the others */
+	void Allocate(int32 InNumSplats, bool bPositions, bool bNormals, bool bOrientations, bool bScales, bool bOpacity, bool bZeroOrderHarmonics, int32 InSHDegree);
+
+	/** Releases all splats */
+	void Empty();
+
+	/** Most splats a cloud with harmonics up to InSHDegree can hold, since the flat harmonics array is int32-indexed */
+	static int32 GetMaxSplats(int32 InSHDegree);
+
+	/** Expands the cloud into the double precision, per-splat array layout of FGaussianSplatData */
+	UFUNCTION(BlueprintCallable, Category = "JI20/Splats")
+	FGaussianSplatData ToSplatData() const;
+
+	// ---------- Blueprint accessors ----------
+
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	int32 GetNumSplats() const { return NumSplats; }
+
+	/** Spherical harmonics degree of the higher order coefficients (0 = base color only) */
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	int32 GetSHDegree() const { return SHDegree; }
+
+	/** Zero if the file has no positions */
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	FVector GetPosition(int32 Index) const;
+
+	/** Zero if the file has no normals */
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	FVector GetNormal(int32 Index) const;
+
+	/** Identity if the file has no rotations */
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	FQuat GetOrientation(int32 Index) const;
+
+	/** One if the file has no scales */
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	FVector GetScale(int32 Index) const;
+
+	/** One if the file has no opacities */
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	float GetOpacity(int32 Index) const;
+
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	FVector GetZeroOrderHarmonics(int32 Index) const;
+
+	/** RGB values of the splat's higher order coefficients, GetNumSHCoefficients() of them */
+	UFUNCTION(BlueprintPure, Category = "JI20/Splats")
+	TArray<FVector> GetHigherOrderHarmonics(int32 Index) const;
+
+	// ---------- C++ views ----------
+
+	int32 Num() const { return NumSplats; }
+
+	/** Higher order coefficients per splat and color channel: 0, 3, 8 or 15 */
+	int32 GetNumSHCoefficients() const { return (SHDegree + 1) * (SHDegree + 1) - 1; }
+
+	/** The attribute arrays are empty when the file does not have the attribute */
+	TArrayView<FVector3f> GetPositions() { return Positions; }
+	TArrayView<FVector3f> GetNormals() { return Normals; }
+	TArrayView<FQuat4f> GetOrientations() { return Orientations; }
+	TArrayView<FVector3f> GetScales() { return Scales; }
+	TArrayView<float> GetOpacities() { return Opacities; }
+	TArrayView<FVector3f> GetZeroOrderHarmonicsArray() { return ZeroOrderHarmonics; }
+	TArrayView<float> GetHigherOrderHarmonicsArray() { return HigherOrderHarmonics; }
+
+	TConstArrayView<FVector3f> GetPositions() const { return Positions; }
+	TConstArrayView<FVector3f> GetNormals() const { return Normals; }
+	TConstArrayView<FQuat4f> GetOrientations() const { return Orientations; }
+	TConstArrayView<FVector3f> GetScales() const { return Scales; }
+	TConstArrayView<float> GetOpacities() const { return Opacities; }
+	TConstArrayView<FVector3f> GetZeroOrderHarmonicsArray() const { return ZeroOrderHarmonics; }
+	TConstArrayView<float> GetHigherOrderHarmonicsArray() const { return HigherOrderHarmonics; }
+
+private:
+	UPROPERTY()
+	int32 NumSplats = 0;
+
+	UPROPERTY()
+	TArray<FVector3f> Positions;
+
+	UPROPERTY()
+	TArray<FVector3f> Normals;
+
+	UPROPERTY()
+	TArray<FQuat4f> Orientations;
+
+	UPROPERTY()
+	TArray<FVector3f> Scales;
+
+	UPROPERTY()
+	TArray<float> Opacities;
+
+	UPROPERTY()
+	TArray<FVector3f> ZeroOrderHarmonics;
+
+	UPROPERTY()
+	TArray<float> HigherOrderHarmonics;
+
+	UPROPERTY()
+	int32 SHDegree = 0;
+};
+
+/**
+ * Read-only view of a cloud as raw 3DGS PLY columns (EGaussianSplatColumn): every value converted back from
+ * Unreal space to what a trainer writes (file axes and units, log scale, logit opacity, channel-major f_rest_*).
+ * Clouds go through the same column-based code as file data this way, e.g. into textures or into a PLY file.
+ * Only columns of attributes the cloud has may be read.
+ */
+struct FGaussianSplatCloudSource
+{
+	/** Opacity is clamped to [MinOpacity, 1 - MinOpacity] before the logit so every value stays finite */
+	static constexpr float MinOpacity = 1.0e-6f;
+
+	const FVector3f* Positions;
+	const FVector3f* Normals;
+	const FQuat4f* Orientations;
+	const FVector3f* Scales;
+	const float* Opacities;
+	const FVector3f* ZeroOrderHarmonics;
+	const float* HigherOrderHarmonics;
+	int32 RestChannelStride;
+
+	explicit FGaussianSplatCloudSource(const UGaussianSplatCloud& Cloud)
+		: Positions(Cloud.GetPositions().GetData())
+		, Normals(Cloud.GetNormals().GetData())
+		, Orientations(Cloud.GetOrientations().GetData())
+		, Scales(Cloud.GetScales().GetData())
+		, Opacities(Cloud.GetOpacities().GetData())
+		, ZeroOrderHarmonics(Cloud.GetZeroOrderHarmonicsArray().GetData())
+		, HigherOrderHarmonics(Cloud.GetHigherOrderHarmonicsArray().GetData())
+		, RestChannelStride(Cloud.GetNumSHCoefficients())
+	{
+	}
+
+	FORCEINLINE float Get(int32 Column, int32 Row) const
+	{
+		switch (EGaussianSplatColumn(Column))
+		{
+		// Inverse of 100 * (x, -z, -y)
+		case EGaussianSplatColumn::X: return Positions[Row].X / 100.0f;
+		case EGaussianSplatColumn::Y: return -Positions[Row].Z / 100.0f;
+		case EGaussianSplatColumn::Z: return -Positions[Row].Y / 100.0f;
+		case EGaussianSplatColumn::NX: return Normals[Row].X;
+		case EGaussianSplatColumn::NY: return Normals[Row].Y;
+		case EGaussianSplatColumn::NZ: return Normals[Row].Z;
+		case EGaussianSplatColumn::DC0: return ZeroOrderHarmonics[Row].X;
+		case EGaussianSplatColumn::DC1: return ZeroOrderHarmonics[Row].Y;
+		case EGaussianSplatColumn::DC2: return ZeroOrderHarmonics[Row].Z;
+		case EGaussianSplatColumn::Opacity:
+		{
+			const float Opacity = FMath::Clamp(Opacities[Row], MinOpacity, 1.0f - MinOpacity);
+			return FMath::Loge(Opacity / (1.0f - Opacity));
+		}
+		// Inverse of 100 * exp(scale_0, scale_2, scale_1)
+		case EGaussianSplatColumn::Scale0: return FMath::Loge(FMath::Max(Scales[Row].X / 100.0f, UE_SMALL_NUMBER));
+		case EGaussianSplatColumn::Scale1: return FMath::Loge(FMath::Max(Scales[Row].Z / 100.0f, UE_SMALL_NUMBER));
+		case EGaussianSplatColumn::Scale2: return FMath::Loge(FMath::Max(Scales[Row].Y / 100.0f, UE_SMALL_NUMBER));
+		// Inverse of (rot_1, -rot_3, -rot_2, rot_0) as (X, Y, Z, W)
+		case EGaussianSplatColumn::Rot0: return Orientations[Row].W;
+		case EGaussianSplatColumn::Rot1: return Orientations[Row].X;
+		case EGaussianSplatColumn::Rot2: return -Orientations[Row].Z;
+		case EGaussianSplatColumn::Rot3: return -Orientations[Row].Y;
+		default:
+		{
+			// RGB triplets per coefficient in the cloud, channel-major columns
+			const int32 Rest = Column - int32(EGaussianSplatColumn::Rest0);
+			const int32 Channel = Rest / RestChannelStride;
+			const int32 Coefficient = Rest - Channel * RestChannelStride;
+			return HigherOrderHarmonics[(SIZE_T(Row) * RestChannelStride + Coefficient) * 3 + Channel];
+		}
+		}
+	}
+
+	/** Gathers rows [Begin, Begin + Num) of a column into Scratch */
+	FORCEINLINE const float* Column(int32 Column, int32 Begin, int32 Num, float* Scratch) const
+	{
+		for (int32 i = 0; i < Num; i++)
+		{
+			Scratch[i] = Get(Column, Begin + i);
+		}
+		return Scratch;
+	}
+};
@@ -10,6 +10,51 @@
 #include "Engine/Texture2D.h"
 #include "GaussianSplatLiveActor.generated.h"
 
+/**
+ * Texture references of one texture page of a frame. Frames with more splats than one set of textures
+ * holds are preprocessed into pages, each shown by a Niagara system of its own.
+ */
+USTRUCT(BlueprintType)
+struct FGaussianSplatFramePage
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* PositionTexture = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* ScaleTexture = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* ColorTexture = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* RotationTexture = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* HarmonicsL1Texture = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* HarmonicsL2Texture = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* HarmonicsL31Texture = nullptr;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* HarmonicsL32Texture = nullptr;
+
+    /** Chunk ranges of compact textures (see FSplatCompactEncoding); null for other precisions */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    UTexture2D* ChunkRangeTexture = nullptr;
+
+    /**
+     * Spherical harmonics degree of the page (0-3), derived from which harmonics textures exist.
+     * Goes to User.SHDegree for systems that declare it; the shipped SH renderer always samples degree 2.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 SHDegree = 0;
+};
+
 /**
  * Frame data - holds texture references for one frame
  */
@@ -18,6 +63,8 @@ struct FGaussianSplatFrame
 {
     GENERATED_BODY()
 
+    // Textures of page 0, as in Pages[0]; a frame without Pages is shown from these alone
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     UTexture2D* PositionTexture = nullptr;
 
@@ -41,6 +88,10 @@ struct FGaussianSplatFrame
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     UTexture2D* HarmonicsL32Texture = nullptr;
+
+    /** Page 0 (positiontexture, ...) first, then page N (positiontexture_N, ...) */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FGaussianSplatFramePage> Pages;
 };
 
 /**
@@ -66,7 +117,7 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "4DGS|Setup")
     FString ModelName;
 
-    /** Reference to a 3DGS actor with Niagara component */
+    /** Reference to a 3DGS actor with Niagara component; it shows page 0, and pages past it get copies of its system */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "4DGS|Setup")
     AActor* Target3DGSActor;
 
@@ -133,6 +184,11 @@ protected:
 private:
     float FrameAccumulator = 0.0f;
 
+    /** Niagara component of each page of the current frame, the target's own component first */
+    UPROPERTY(Transient)
+    TArray<UNiagaraComponent*> PageComponents;
+
     UNiagaraComponent* GetNiagaraComponent();
     void ApplyFrameToNiagara(const FGaussianSplatFrame& Frame);
+    static void ApplyPageToNiagara(UNiagaraComponent* NC, const FGaussianSplatFramePage& Page);
 };
@@ -0,0 +1,52 @@
+// GaussianSplatPages.h
+// One Niagara system per texture page, for models larger than one set of textures holds
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Parser.h"
+#include "GaussianSplatPages.generated.h"
+
+class UNiagaraComponent;
+
+/**
+ * Models with more splats than one texture holds are preprocessed into pages (see FTextureLocations), and every
+ * page needs a Niagara system of its own. The system set up for a model renders page 0; the other pages run
+ * copies of it, attached to it and created on demand, so they move with it.
+ */
+UCLASS()
+class UNREALSPLAT_API UGaussianSplatPageLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Shows every page of a preprocessed model. FirstPage gets the textures of page 0 and Components holds one
+	 * component per page afterwards, FirstPage first; components left over from a model with more pages are deactivated.
+	 * Textures go to User.PositionTexture, User.ScaleTexture, User.ColorTexture, User.RotationTexture and
+	 * User.SH1Texture to User.SH32Texture and, for compact textures, User.ChunkRangeTexture. Logs a warning for
+	 * pages with fewer harmonics than the system samples (see GetSampledSHDegree).
+	 *
+	 * @param FirstPage - Niagara component of the model, e.g. of a 3DGSActorSH
+	 * @param Pages - Texture locations returned by the preprocessor, one per page
+	 * @param Components - Components of earlier calls to reuse, and the components of the pages on return
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/Splats")
+	static void ApplyTexturePages(UNiagaraComponent* FirstPage, const TArray<FTextureLocations>& Pages, UPARAM(ref) TArray<UNiagaraComponent*>& Components);
+
+	/**
+	 * Makes Components hold NumPages active components running the system of FirstPage, FirstPage first.
+	 * Missing components are created on FirstPage's owner and attached to FirstPage; the ones past NumPages are deactivated.
+	 */
+	static void SetNumPageComponents(UNiagaraComponent* FirstPage, int32 NumPages, TArray<UNiagaraComponent*>& Components);
+
+	/**
+	 * Harmonics degree the system of Component samples whatever the degree of its textures: 0 for systems
+	 * without harmonics textures or with a User.SHDegree parameter to limit them, else ShippedSHRendererDegree.
+	 */
+	static int32 GetSampledSHDegree(const UNiagaraComponent* Component);
+
+	/** Degree the shipped SH renderer (UnrealSplatRendererSH) evaluates; it has no User.SHDegree parameter */
+	static constexpr int32 ShippedSHRendererDegree = 2;
+};
@@ -0,0 +1,104 @@
+// ImageSplatSequence.h
+// Reader for 4DGS sequences that store every frame's splat attributes as images
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatBuffer.h"
+
+class IImageWrapperModule;
+class FJsonObject;
+
+/**
+ * Raw columns of one decoded frame, in the FSplatColumnSource interface of the other readers:
+ * position, log scale, rotation, f_dc and logit opacity. The images carry no higher order harmonics.
+ */
+struct UNREALSPLAT_API FImageSplatFrame
+{
+	FImageSplatFrame();
+
+	FImageSplatFrame(const FImageSplatFrame&) = delete;
+	FImageSplatFrame& operator=(const FImageSplatFrame&) = delete;
+
+	int32 Num() const { return NumSplats; }
+
+	/** Contiguous column data, or nullptr if the column is not stored in the images */
+	const float* Column(EGaussianSplatColumn InColumn) const { return Columns[int32(InColumn)]; }
+
+	/** No f_rest_* columns */
+	int32 RestChannelStride() const { return 0; }
+
+	/** Why decoding failed; empty on success */
+	FString Error;
+
+private:
+	friend class FImageSplatSequence;
+
+	TArray64<float> Storage;
+	float* Columns[FGaussianSplatBuffer::NumColumns];
+	int32 NumSplats;
+};
+
+/**
+ * A directory with a sequence.json sidecar and one folder of attribute images per frame, as written by
+ * volumetric video pipelines instead of one PLY per frame:
+ *
+ *   sequence.json              { "ranges": { ... }, "frames": [ { "folder": "00000", "count": 250000, "ranges": { ... } }, ... ] }
+ *   00000/position.png|exr     RGB  = x, y, z
+ *   00000/scale.png|exr        RGB  = scale_0..2 (log scale)
+ *   00000/rotation.png|exr     RGBA = rot_0..3
+ *   00000/color.png|exr        RGBA = f_dc_0..2, opacity (logit)
+ *
+ * Splat i of a frame is pixel i of each image in row-major order; images may hold more pixels than splats.
+ * Integer images (8- or 16-bit PNG) are quantized: a normalized value v stands for min + v * (max - min), with
+ * "min" and "max" arrays per attribute under "ranges", per frame or for the whole sequence. Float images
+ * (EXR) hold the values themselves.
+ *
+ * DecodeFrame() is safe to call from worker threads, so several frames can be decoded at once.
+ */
+class UNREALSPLAT_API FImageSplatSequence
+{
+public:
+	static const TCHAR* SidecarFileName;
+
+	/** Number of attribute images per frame */
+	static constexpr int32 NumAttributes = 4;
+
+	/** True if AbsoluteDirectory holds a sidecar, i.e. an image-packed sequence */
+	static bool IsImageSequence(const FString& AbsoluteDirectory);
+
+	/** Parses the sidecar of AbsoluteDirectory. Returns false, with GetError() describing why, if it is invalid. Game thread only. */
+	bool Open(const FString& AbsoluteDirectory);
+
+	int32 GetNumFrames() const { return Frames.Num(); }
+
+	/** Folder name of a frame, relative to the sequence directory */
+	const FString& GetFrameFolder(int32 Frame) const { return Frames[Frame].Folder; }
+
+	const FString& GetError() const { return Error; }
+
+	/** Loads and decodes the images of a frame into OutFrame. Returns false and sets OutFrame.Error on failure. */
+	bool DecodeFrame(int32 Frame, FImageSplatFrame& OutFrame) const;
+
+private:
+	struct FRange
+	{
+		float Min[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		float Max[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	};
+
+	struct FFrame
+	{
+		FString Folder;
+		int32 NumSplats = 0;
+		FRange Ranges[NumAttributes];
+	};
+
+	/** Reads the "min" and "max" arrays of every attribute listed in a "ranges" object */
+	static bool ParseRanges(const FJsonObject& RangesObject, FRange* OutRanges);
+
+	FString Directory;
+	TArray<FFrame> Frames;
+	IImageWrapperModule* ImageWrapperModule = nullptr;
+	FString Error;
+};
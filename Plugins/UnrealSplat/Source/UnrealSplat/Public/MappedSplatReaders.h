@@ -0,0 +1,138 @@
+// MappedSplatReaders.h
+// Readers for the fixed-stride .splat and .ksplat formats, decoded straight from a memory-mapped file
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatBuffer.h"
+
+class FSplatArena;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Maps a whole splat file into memory and decodes ranges of splats in parallel into the raw columns of a
+ * float 3DGS PLY (log scale, logit opacity, f_dc, channel-major f_rest), so batches go through the same
+ * conversion as any PLY file. Nothing but one batch of columns is allocated; the file data is read in place.
+ */
+class UNREALSPLAT_API FMappedSplatReader
+{
+public:
+	FMappedSplatReader();
+	virtual ~FMappedSplatReader();
+
+	FMappedSplatReader(const FMappedSplatReader&) = delete;
+	FMappedSplatReader& operator=(const FMappedSplatReader&) = delete;
+
+	/** Maps AbsolutePath and parses its header. Batch columns are allocated from Arena. */
+	bool Open(const FString& AbsolutePath, FSplatArena& Arena);
+
+	int32 GetNumSplats() const { return NumPoints; }
+
+	/** Spherical harmonics degree stored in the file */
+	int32 GetSHDegree() const { return FileSHDegree; }
+
+	/** Summary of the header for the preprocessing log */
+	virtual FString Describe() const = 0;
+
+	const FString& GetError() const { return Error; }
+
+	/** Decodes splats [FirstSplat, FirstSplat + InNumSplats) into the columns, with harmonics up to SHDegree */
+	virtual bool DecodeBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree) = 0;
+
+	/** Number of splats in the last decoded batch */
+	int32 Num() const { return NumSplats; }
+
+	/** Contiguous column data of the last decoded batch, or nullptr if the batch does not contain the column */
+	const float* Column(EGaussianSplatColumn InColumn) const { return Columns[int32(InColumn)]; }
+
+	/** See FGaussianSplatBuffer::RestChannelStride() */
+	int32 RestChannelStride() const { return FGaussianSplatBuffer::NumSHCoefficientsForDegree(FileSHDegree); }
+
+protected:
+	/** Reads the header from Data and Size; sets NumPoints and FileSHDegree, or Error on failure */
+	virtual bool ParseHeader() = 0;
+
+	/**
+	 * Points the position, scale, rotation, base color and opacity columns, plus the f_rest_* columns of
+	 * bands up to SHDegree, at storage for InNumSplats splats. Returns false if the range is outside the file.
+	 */
+	bool BeginBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree);
+
+	const uint8* Data;
+	int64 Size;
+	int32 NumPoints;
+	int32 FileSHDegree;
+	FString Error;
+	float* Columns[FGaussianSplatBuffer::NumColumns];
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	FSplatArena* Arena;
+	float* BatchStorage;
+	int64 BatchStorageSize;
+	int32 NumSplats;
+};
+
+/**
+ * The 32-byte-per-splat .splat format of the antimatter15 web viewer, without a header:
+ * float position[3], float scale[3] (linear), uint8 color[4] (base color and sigmoid opacity),
+ * uint8 rotation[4] (w, x, y, z mapped from [-1, 1] to [0, 255]).
+ */
+class UNREALSPLAT_API FSplatReader : public FMappedSplatReader
+{
+public:
+	static constexpr int32 BytesPerSplat = 32;
+
+	virtual FString Describe() const override;
+	virtual bool DecodeBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree) override;
+
+protected:
+	virtual bool ParseHeader() override;
+};
+
+/**
+ * The .ksplat format of the GaussianSplats3D viewer (version 0.1 and later): a 4 KB header, one 1 KB header
+ * per section, then every section's bucket data and splats. Compression level 0 stores float32 values;
+ * levels 1 and 2 store positions as 16-bit offsets from the centre of their bucket, scale and rotation as
+ * half floats, and spherical harmonics as half floats (level 1) or 8 bits over the header's range (level 2).
+ */
+class UNREALSPLAT_API FKSplatReader : public FMappedSplatReader
+{
+public:
+	FKSplatReader();
+
+	virtual FString Describe() const override;
+	virtual bool DecodeBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree) override;
+
+protected:
+	virtual bool ParseHeader() override;
+
+private:
+	struct FSection
+	{
+		int32 FirstSplat;
+		int32 NumSplats;
+		int32 BucketSize;
+		int32 FullBucketCount;
+		float PositionScale;
+		uint32 PositionOffset;
+		int32 SHDegree;
+		int32 BytesPerSplat;
+		const float* BucketCenters;
+		const uint8* Splats;
+
+		/** First splat of every partially filled bucket, which follow the full buckets */
+		TArray<int32> PartialBucketStarts;
+
+		int32 GetBucket(int32 LocalSplat) const;
+	};
+
+	TArray<FSection> Sections;
+	int32 VersionMajor;
+	int32 VersionMinor;
+	int32 CompressionLevel;
+	float MinSHCoefficient;
+	float MaxSHCoefficient;
+};
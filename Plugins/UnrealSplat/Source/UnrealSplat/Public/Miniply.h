@@ -28,6 +28,7 @@ SOFTWARE.
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -83,6 +84,8 @@ namespace miniply {
         PLYPropertyType countType = PLYPropertyType::None; //!< None indicates this is not a list type, otherwise it's the type for the list count.
         uint32_t offset = 0;                  //!< Byte offset from the start of the row.
         uint32_t stride = 0;
+        uint32_t loadedOffset = 0;            //!< Byte offset from the start of a row once loaded. Differs from `offset` when a projection drops earlier properties.
+        bool     projected = true;            //!< False if the property was left out by `PLYReader::set_projection` and won't be loaded.
 
         std::vector<uint8_t> listData;
         std::vector<uint32_t> rowCount; // Entry `i` is the number of items (*not* the number of bytes) in row `i`.
@@ -95,6 +98,7 @@ namespace miniply {
         uint32_t                 count = 0;    //!< The number of items in this element (e.g. the number of vertices if this is the vertex element).
         bool                     fixedSize = true; //!< `true` if there are only fixed-size properties in this element, i.e. no list properties.
         uint32_t                 rowStride = 0;    //!< The number of bytes from the start of one row to the start of the next, for this element.
+        uint32_t                 loadedStride = 0; //!< Row stride of the loaded data, which is smaller than `rowStride` when a projection is in use.
 
         void calculate_offsets();
 
@@ -144,17 +148,83 @@ namespace miniply {
     };
 
 
+    /// Callback for `PLYReader::load_element_batches`. `firstRow` is the index
+    /// of the batch's first row within the element and `numRows` is the number
+    /// of rows in the batch. Return false to stop streaming early.
+    using PLYRowBatchVisitor = std::function<bool(uint32_t firstRow, uint32_t numRows)>;
+
+
+    /// Hook for running work on several threads, see `PLYReader::set_parallel_for`.
+    /// It must call `task(i)` once for every `i` in `[0, numTasks)`, in any
+    /// order and on any threads, and return once all of the calls are done.
+    using PLYParallelFor = std::function<void(uint32_t numTasks, const std::function<void(uint32_t task)>& task)>;
+
+
+    class PLYReadAhead;
+
+
     class PLYReader {
     public:
         PLYReader(const char* filename);
+
+        /// Without a memory map, the data section is read by a background
+        /// thread a few blocks ahead of the parser, so disk reads overlap
+        /// with decoding.
+        ///
+        /// When `memoryMap` is true the file is memory-mapped and fixed-size
+        /// elements of a `binary_little_endian` file are extracted straight from
+        /// the mapping: `load_element()` does not copy the rows anywhere, it just
+        /// points at them. ASCII rows still have to be parsed, but they are
+        /// parsed from the mapping rather than copied out of the read buffer
+        /// first. Big-endian files fall back to buffered reads.
+        PLYReader(const char* filename, bool memoryMap);
         ~PLYReader();
 
         bool valid() const;
+
+        /// True if element data is being read directly from a memory-mapped file.
+        bool is_memory_mapped() const;
         bool has_element() const;
         const PLYElement* element() const;
         bool load_element();
+
+        /// Streams the current element through `visitor` in batches of at most
+        /// `batchRows` rows, instead of loading all of it at once. While the
+        /// visitor runs, the batch *is* the loaded data: `num_loaded_rows()`
+        /// returns the batch size and the `extract_properties` family address
+        /// rows `[0, numRows)` of the batch.
+        ///
+        /// Fixed-size elements only ever hold one batch in memory (none at all
+        /// for memory-mapped files). Elements with list properties cannot be
+        /// split into rows without parsing them, so they are loaded in full and
+        /// then visited batch by batch.
+        ///
+        /// Afterwards the reader is positioned at the end of the element and the
+        /// element counts as loaded, but no rows are available any more. Returns
+        /// false if the data couldn't be read or the visitor stopped early.
+        bool load_element_batches(uint32_t batchRows, const PLYRowBatchVisitor& visitor);
+
+        /// Loads up to `numSamples` rows of the current fixed-size element
+        /// instead of all of them, e.g. to estimate statistics cheaply. Binary
+        /// rows are picked at an even stride across the element by seeking
+        /// past the rows in between. ASCII rows can't be located without
+        /// reading every line before them, so for ASCII files the sample is
+        /// the first `numSamples` rows.
+        ///
+        /// Afterwards the sampled rows are the loaded data: `num_loaded_rows()`
+        /// returns the sample size and the `extract_properties` family reads
+        /// from the sample. Returns false for elements with list properties.
+        bool load_element_sample(uint32_t numSamples);
         void next_element();
 
+        /// Lets the reader split work across threads. At the moment this is
+        /// the parsing of ASCII rows in fixed-size elements: the rows are split
+        /// into chunks at line boundaries, each chunk is parsed by its own task
+        /// and writes to its own rows of the loaded data, so the result is the
+        /// same as a serial parse. Without a hook everything runs on the
+        /// calling thread.
+        void set_parallel_for(const PLYParallelFor& parallelFor);
+
         PLYFileType file_type() const;
         int version_major() const;
         int version_minor() const;
@@ -165,9 +235,36 @@ namespace miniply {
         /// Check whether the current element has the given name.
         bool element_is(const char* name) const;
 
+        /// Restricts loading of the current element to the given properties. The
+        /// rest are skipped while decoding, so they take up no memory and cost
+        /// no conversion work, and trying to extract them fails. Call it before
+        /// `load_element()` or `load_element_batches()`; it applies until the
+        /// reader moves on to the next element.
+        ///
+        /// Memory-mapped rows are used in place, so for those the projection
+        /// only limits what can be extracted. List properties are always
+        /// loaded. Returns false if the element has already been loaded or any
+        /// of the property indexes is invalid.
+        bool set_projection(const uint32_t propIdxs[], uint32_t numProps);
+
         /// Number of rows in the current element.
         uint32_t num_rows() const;
 
+        /// Number of rows currently available for extraction: all of them after
+        /// `load_element()`, the current batch inside `load_element_batches()`.
+        uint32_t num_loaded_rows() const;
+
+        /// Raw bytes of the loaded rows, for callers that know the layout well
+        /// enough to decode rows themselves. Rows are `loadedStride` bytes apart
+        /// and each property sits at its `loadedOffset`, in native byte order.
+        /// Returns nullptr if no rows are loaded.
+        const uint8_t* element_data() const;
+
+        /// Bytes the reader currently holds in its own heap buffers: the read and
+        /// token buffers, the read-ahead ring, loaded rows and list data, and ASCII
+        /// text. Mapped file pages are not counted.
+        size_t buffer_bytes() const;
+
         /// Returns the index for the named property in the current element, or
         /// `kInvalidIndex` if it can't be found.
         uint32_t find_property(const char* name) const;
@@ -197,6 +294,15 @@ namespace miniply {
         /// `extract_list_column()` for those instead.
         bool extract_properties(const uint32_t propIdxs[], uint32_t numProps, PLYPropertyType destType, void* dest) const;
 
+        /// The same as `extract_properties`, but only for the rows in
+        /// `[firstRow, firstRow + numRows)` of the loaded element. `dest` receives
+        /// just those rows, packed from its start.
+        ///
+        /// This only reads from the reader, so disjoint row ranges can be
+        /// extracted concurrently from several threads. Returns false if the
+        /// range lies outside of the loaded rows.
+        bool extract_properties_range(const uint32_t propIdxs[], uint32_t numProps, PLYPropertyType destType, void* dest, uint32_t firstRow, uint32_t numRows) const;
+
         /// The same as `extract_properties`, but does not require rows in the
         /// destination to be contiguous: `destStride` is the number of bytes
         /// between the start of one row and the start of the next row in the
@@ -236,6 +342,9 @@ namespace miniply {
         bool find_indices(uint32_t propIdxs[1]) const;
 
     private:
+        bool map_file(const char* filename);
+        void unmap_file();
+
         bool refill_buffer();
         bool rewind_to_safe_char();
         bool accept();
@@ -253,6 +362,7 @@ namespace miniply {
         }
 
         bool int_literal(int* value);
+        bool uint_literal(uint32_t* value);
         bool float_literal(float* value);
         bool double_literal(double* value);
 
@@ -261,6 +371,13 @@ namespace miniply {
         bool parse_property(std::vector<PLYProperty>& properties);
 
         bool load_fixed_size_element(PLYElement& elem);
+        bool load_fixed_size_rows(PLYElement& elem, uint32_t numRows);
+        bool skip_fixed_size_element(const PLYElement& elem);
+        bool skip_fixed_size_rows(const PLYElement& elem, uint32_t numRows);
+        bool skip_bytes(int64_t numBytes);
+        bool load_ascii_rows(PLYElement& elem, uint32_t numRows);
+        bool rows_are_mapped() const;
+        void stop_read_ahead();
         bool load_variable_size_element(PLYElement& elem);
 
         bool load_ascii_scalar_property(PLYProperty& prop, size_t& destIndex);
@@ -292,6 +409,19 @@ namespace miniply {
         size_t m_currentElement = 0;
         bool m_elementLoaded = false;
         std::vector<uint8_t> m_elementData;
+        const uint8_t* m_elementPtr = nullptr; //!< Rows of the loaded element: either `m_elementData` or a range of the mapped file.
+        size_t m_elementSize = 0;
+
+        const uint8_t* m_mapData = nullptr; //!< Start of the memory-mapped file, if mapping is in use.
+        size_t m_mapSize = 0;
+        void* m_mapFileHandle = nullptr;    //!< Win32 file and file-mapping handles; unused on other platforms.
+        void* m_mapHandle = nullptr;
+
+        PLYReadAhead* m_readAhead = nullptr; //!< Background reads for the data section of buffered files.
+        bool m_readAheadStopped = false;    //!< Set once reads have become scattered, see `load_element_sample`.
+        uint32_t m_skipRowsOnNextElement = 0; //!< ASCII rows left unread by `load_element_sample`.
+        PLYParallelFor m_parallelFor;       //!< Optional hook for multithreaded parsing.
+        std::vector<char> m_asciiText;      //!< Null-terminated ASCII rows being parsed, when they can't be parsed in place.
 
         char* m_tmpBuf = nullptr;
     };
@@ -6,6 +6,7 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Parser.generated.h"
 
+class UGaussianSplatCloud;
 
 USTRUCT(BlueprintType)
 struct FHighOrderHarmonicsCoefficientsStruct {
@@ -54,6 +55,27 @@ struct FTextureLocations {
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TSoftObjectPtr<UTexture2D> HarmonicsL32TextureLocation;
 
+	// Spherical harmonics degree of the textures: 0 = none, 1 = L1, 2 = L1 + L2, 3 = all four.
+	// Harmonics textures above this degree were not created and their locations are empty.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 SHDegree;
+
+	// Splats [FirstSplat, FirstSplat + NumSplats) of the model are in these textures. Models with more texels than
+	// one texture can hold are split into pages of consecutive splats, one FTextureLocations each; the textures of
+	// page N > 0 carry the suffix _N. Every page needs a Niagara system of its own, see UGaussianSplatPageLibrary.
+	// The shipped systems spawn one particle per texel, so the range is for bookkeeping and not passed to them.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 FirstSplat;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumSplats;
+
+	// Ranges of the compact position, scale and color textures (see EGaussianSplatTexturePrecision::Compact), RGBA32F
+	// with six texels per chunk: position min, position max, ln(scale) min, ln(scale) max, f_dc min, f_dc max.
+	// Empty if none of them is compact.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TSoftObjectPtr<UTexture2D> ChunkRangeTextureLocation;
+
 	FTextureLocations()
 		: PositionTextureLocation()
 		, ScaleTextureLocation()
@@ -63,6 +85,282 @@ struct FTextureLocations {
 		, HarmonicsL2TextureLocation()
 		, HarmonicsL31TextureLocation()
 		, HarmonicsL32TextureLocation()
+		, SHDegree(0)
+		, FirstSplat(0)
+		, NumSplats(0)
+		, ChunkRangeTextureLocation()
+	{
+	}
+};
+
+UENUM(BlueprintType)
+enum class EGaussianSplatCropShape : uint8 {
+	Box,
+	Sphere
+};
+
+// Storage of a splat texture
+UENUM(BlueprintType)
+enum class EGaussianSplatTexturePrecision : uint8 {
+	// RGBA32F, 16 bytes per texel
+	Full,
+	// RGBA16F, 8 bytes per texel. Not used for positions, which are written in full precision instead:
+	// half precision keeps only about 1/2048 of their magnitude.
+	Half,
+	// Quantized to 4 bytes per texel, decoded per chunk of 256 consecutive splats with the ranges in the chunk
+	// range texture; the splats of a page are ordered along a Morton curve so chunks stay small. Values are in Unreal space.
+	// Position, scale and rotation textures are BGRA8 read as the 32-bit word W = B | G << 8 | R << 16 | A << 24:
+	// - Position: (Position - ChunkMin) / (ChunkMax - ChunkMin) as unorm x in bits 21-31, y in 10-20, z in 0-9.
+	// - Scale: (ln(Scale) - ChunkLogMin) / (ChunkLogMax - ChunkLogMin), laid out as the position.
+	// - Rotation: "smallest three". W >> 30 is the index (x, y, z, w) of the largest component, which is positive
+	//   and left out; the other three, in order, are in the 10-bit fields from bit 0 up, mapped from
+	//   [-1/sqrt(2), 1/sqrt(2)] to [0, 1023].
+	// - Color: RGBA8 UNORM, RGB = (f_dc - ChunkDCMin) / (ChunkDCMax - ChunkDCMin), A = opacity.
+	// Shaders/Private/SplatCompactDecode.ush decodes all four (see FSplatCompactEncoding).
+	// Harmonics have no compact form and are written in half precision instead.
+	// None of the shipped Niagara systems decode compact textures, so it is hidden from the settings panel and only
+	// meant for custom materials and systems, set from C++ or Python.
+	Compact UMETA(Hidden)
+};
+
+/**
+ * A box or sphere that crops a model while it is preprocessed.
+ * Volumes are placed in the model's Unreal space, i.e. the space of the position texture.
+ */
+USTRUCT(BlueprintType)
+struct FGaussianSplatCropVolume {
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGaussianSplatCropShape Shape;
+
+	// Location, rotation and scale of the volume. Non-uniform scale turns a sphere into an ellipsoid.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FTransform Transform;
+
+	// Half size of the box along its local axes, before scale
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (EditCondition = "Shape == EGaussianSplatCropShape::Box"))
+	FVector BoxExtent;
+
+	// Radius of the sphere, before scale
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", EditCondition = "Shape == EGaussianSplatCropShape::Sphere"))
+	float SphereRadius;
+
+	// Exclusive volumes remove the splats inside them. As soon as there is an inclusive volume,
+	// splats outside of every inclusive volume are removed as well.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bExclude;
+
+	FGaussianSplatCropVolume()
+		: Shape(EGaussianSplatCropShape::Box)
+		, Transform(FTransform::Identity)
+		, BoxExtent(100.0)
+		, SphereRadius(100.0f)
+		, bExclude(false)
+	{
+	}
+};
+
+/**
+ * Options for preprocessing a PLY file into splat textures.
+ */
+USTRUCT(BlueprintType)
+struct FGaussianSplatPreprocessSettings {
+	GENERATED_BODY()
+
+	// Highest spherical harmonics degree written to textures (0 = base color only).
+	// Coefficients of higher degrees are skipped while reading the file.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", ClampMax = "3"))
+	int32 MaxSHDegree;
+
+	// Splats removed by these volumes are left out of the textures, which are sized for the remaining splats
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FGaussianSplatCropVolume> CropVolumes;
+
+	// Precision of each texture. Half precision halves VRAM and cooked size of a texture; rotations, colors and
+	// harmonics need no more than that. Positions ignore Half, Compact quantizes them per chunk instead.
+	// Compact brings a splat without harmonics from 64 to 16 bytes (plus 0.375 for the chunk ranges), for mobile and VR,
+	// but needs a custom material or system to decode it.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGaussianSplatTexturePrecision PositionPrecision;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGaussianSplatTexturePrecision ScalePrecision;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGaussianSplatTexturePrecision RotationPrecision;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGaussianSplatTexturePrecision ColorPrecision;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGaussianSplatTexturePrecision HarmonicsPrecision;
+
+	FGaussianSplatPreprocessSettings()
+		: MaxSHDegree(3)
+		, CropVolumes()
+		, PositionPrecision(EGaussianSplatTexturePrecision::Full)
+		, ScalePrecision(EGaussianSplatTexturePrecision::Full)
+		, RotationPrecision(EGaussianSplatTexturePrecision::Full)
+		, ColorPrecision(EGaussianSplatTexturePrecision::Full)
+		, HarmonicsPrecision(EGaussianSplatTexturePrecision::Full)
+	{
+	}
+};
+
+/**
+ * Options for writing a splat cloud back to a binary PLY file.
+ * Positions are always written; every other group is written if enabled here and present in the cloud.
+ */
+USTRUCT(BlueprintType)
+struct FGaussianSplatExportSettings {
+	GENERATED_BODY()
+
+	// nx, ny, nz
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWriteNormals;
+
+	// f_dc_0..2
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWriteZeroOrderHarmonics;
+
+	// opacity, as the logit of the cloud's opacity
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWriteOpacity;
+
+	// scale_0..2, as the log of the cloud's scale
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWriteScale;
+
+	// rot_0..3
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bWriteRotation;
+
+	// Highest spherical harmonics degree written as f_rest_* (0 = none); the cloud's own degree if that is lower
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", ClampMax = "3"))
+	int32 MaxSHDegree;
+
+	FGaussianSplatExportSettings()
+		: bWriteNormals(true)
+		, bWriteZeroOrderHarmonics(true)
+		, bWriteOpacity(true)
+		, bWriteScale(true)
+		, bWriteRotation(true)
+		, MaxSHDegree(3)
+	{
+	}
+};
+
+/**
+ * One capture merged by UParser::PreprocessMerge.
+ */
+USTRUCT(BlueprintType)
+struct FGaussianSplatMergeInput {
+	GENERATED_BODY()
+
+	// Path of the PLY file relative to Content/ (e.g., "Splats/scan_north.ply")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString FilePath;
+
+	// Placement of the capture in the merged model. Scale must be uniform and positive.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FTransform Transform;
+
+	FGaussianSplatMergeInput()
+		: FilePath()
+		, Transform(FTransform::Identity)
+	{
+	}
+};
+
+/**
+ * Options for merging overlapping captures with UParser::PreprocessMerge.
+ * A splat is removed as a duplicate if a kept, more opaque splat of another capture lies at most CellSize away
+ * (in the same or a neighbouring grid cell), with a similar base color and size.
+ */
+USTRUCT(BlueprintType)
+struct FGaussianSplatMergeSettings {
+	GENERATED_BODY()
+
+	// Whether duplicates of different captures are removed; if not, the captures are only concatenated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool bRemoveOverlaps;
+
+	// Edge length of the hash grid cells and largest distance between duplicates, in Unreal units
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.001"))
+	float CellSize;
+
+	// Largest difference of the base colors of duplicates, per channel (0 - 1)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", ClampMax = "1"))
+	float MaxColorDifference;
+
+	// Largest ratio between the sizes of duplicates, compared on their largest and on their smallest axis
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+	float MaxScaleRatio;
+
+	FGaussianSplatMergeSettings()
+		: bRemoveOverlaps(true)
+		, CellSize(1.0f)
+		, MaxColorDifference(0.1f)
+		, MaxScaleRatio(1.5f)
+	{
+	}
+};
+
+/**
+ * Metadata of a PLY file gathered by UParser::ProbePLY without loading its splats.
+ */
+USTRUCT(BlueprintType)
+struct FGaussianSplatProbeResult {
+	GENERATED_BODY()
+
+	// Number of splats (vertices) in the file, as declared by its header. The preprocessor takes at most MAX_int32.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int64 NumSplats;
+
+	// PLY data format: "ascii", "binary_little_endian" or "binary_big_endian"
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FString Format;
+
+	// Vertex property names, in file order
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> PropertyNames;
+
+	// Vertex property types (e.g. "float"), matching PropertyNames
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FString> PropertyTypes;
+
+	// Spherical harmonics degree, from the number of f_rest_* coefficients (9, 24 or 45 for degree 1, 2 or 3)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 SHDegree;
+
+	// Bounds of the sampled splat positions, in Unreal space and units
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FBox ApproximateBounds;
+
+	// Number of splats the bounds were computed from
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 NumSampledSplats;
+
+	// Size of the PLY file on disk
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int64 FileSizeBytes;
+
+	// Size of the textures Preprocess3DGSModel would create for this file, in the formats of the probe's settings.
+	// Crop volumes are not taken into account.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int64 EstimatedTextureBytes;
+
+	FGaussianSplatProbeResult()
+		: NumSplats(0)
+		, Format()
+		, PropertyNames()
+		, PropertyTypes()
+		, SHDegree(0)
+		, ApproximateBounds(ForceInit)
+		, NumSampledSplats(0)
+		, FileSizeBytes(0)
+		, EstimatedTextureBytes(0)
 	{
 	}
 };
@@ -100,7 +398,8 @@ struct FGaussianSplatData
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FVector> ZeroOrderHarmonicsCoefficients;
 
-	// Spherical Harmonics coefficients - High order (f_rest_0, ..., f_rest_44)
+	// Spherical Harmonics coefficients - High order, one RGB value per coefficient of bands 1 and up
+	// (3, 8 or 15 values for SH degree 1, 2 or 3, read from f_rest_0, ..., f_rest_N)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TArray<FHighOrderHarmonicsCoefficientsStruct> HighOrderHarmonicsCoefficients;
 
@@ -134,35 +433,206 @@ class UNREALSPLAT_API UParser : public UBlueprintFunctionLibrary
 	GENERATED_BODY()
 
 public:
+	/**
+	 * Parses a PLY file into per-splat arrays. Expands the result of ParseFilePLYToCloud to double precision
+	 * and one allocation per splat for the harmonics, so prefer ParseFilePLYToCloud for large files.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "JI20/Parser")
 	static FGaussianSplatData ParseFilePLY(FString FilePath, bool& bOutSuccess, FString& OutputString);
 
+	/**
+	 * Parses a PLY file into a compact float32 splat cloud.
+	 *
+	 * @param FilePath - Path to PLY file relative to Content/ (e.g., "Splats/mymodel.ply")
+	 * @param bOutSuccess - Success flag
+	 * @param OutputString - Log output
+	 * @return The parsed splats (empty if the file has no vertex element), or nullptr if the file is not a valid PLY file
+	 */
 	UFUNCTION(BlueprintCallable, Category = "JI20/Parser")
-	static TArray<FLinearColor> SH2RGB(TArray<FVector> ZeroOrderHarmonics, TArray<FHighOrderHarmonicsCoefficientsStruct> HigherOrderHarmonics);
+	static UGaussianSplatCloud* ParseFilePLYToCloud(FString FilePath, bool& bOutSuccess, FString& OutputString);
+
+	/** Base (view independent) color of every splat from its zero order coefficients. See EvaluateSplatColors for view-dependent color. */
+	UFUNCTION(BlueprintCallable, Category = "JI20/Parser")
+	static TArray<FLinearColor> SH2RGB(const TArray<FVector>& ZeroOrderHarmonics, const TArray<FHighOrderHarmonicsCoefficientsStruct>& HigherOrderHarmonics);
 
 	/**
-	 * Preprocess a single PLY file into textures.
+	 * View-dependent color of every splat of Cloud, evaluated from its spherical harmonics on the CPU.
+	 *
+	 * @param Cloud - Splats to evaluate
+	 * @param CameraPosition - Position the splats are seen from, in Unreal space
+	 * @param MaxSHDegree - Highest degree to evaluate; the cloud's own degree if that is lower
+	 * @return One color per splat, alpha 1
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/Parser")
+	static TArray<FLinearColor> EvaluateSplatColors(const UGaussianSplatCloud* Cloud, FVector CameraPosition, int32 MaxSHDegree = 3);
+
+	/**
+	 * Writes a splat cloud to a binary little endian PLY file in the INRIA 3DGS layout, undoing the
+	 * conversions of ParseFilePLYToCloud: positions and axes back to the file's frame, log scale and logit opacity.
+	 *
+	 * @param Cloud - Splats to write
+	 * @param FilePath - Path of the PLY file relative to Content/ (e.g., "Splats/cropped.ply"); overwritten if it exists
+	 * @param Settings - Properties to write
+	 * @param OutputString - Log output
+	 * @return Whether the file was written completely
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/Parser")
+	static bool WriteCloudToPLY(const UGaussianSplatCloud* Cloud, FString FilePath, const FGaussianSplatExportSettings& Settings, FString& OutputString);
+
+	/**
+	 * Preprocess a single splat file (.ply, .spz, .splat or .ksplat) into textures.
 	 * Output: Creates folder next to PLY with textures inside.
 	 *
-	 * @param FilePath - Path to PLY file relative to Content/ (e.g., "Splats/mymodel.ply")
+	 * @param FilePath - Path to splat file relative to Content/ (e.g., "Splats/mymodel.ply")
 	 * @param bOutSuccess - Success flag
 	 * @param OutputString - Log output
-	 * @param TexLocations - Output array with single FTextureLocations
+	 * @param TexLocations - Output array with one FTextureLocations per texture page
 	 * @return Number of vertices processed
 	 */
 	UFUNCTION(BlueprintCallable, Category = "JI20/UnrealSplat")
 	static int Preprocess3DGSModel(FString FilePath, bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations);
 
 	/**
-	 * Preprocess a sequence of PLY files into frame folders.
+	 * Same as Preprocess3DGSModel, with control over which data ends up in the textures.
+	 * Only the PLY properties needed for the requested output are decoded.
+	 *
+	 * @param FilePath - Path to splat file relative to Content/ (e.g., "Splats/mymodel.ply")
+	 * @param Settings - Preprocessing options
+	 * @param bOutSuccess - Success flag
+	 * @param OutputString - Log output
+	 * @param TexLocations - Output array with one FTextureLocations per texture page
+	 * @return Number of vertices processed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/UnrealSplat")
+	static int Preprocess3DGSModelWithSettings(FString FilePath, const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations);
+
+	/**
+	 * Same as Preprocess3DGSModelWithSettings, with the textures saved to OutputFolder instead of next to the file,
+	 * e.g. into the frame folders of a sequence.
+	 *
+	 * @param FilePath - Path to splat file relative to Content/ (e.g., "Splats/sequence/0001.ply")
+	 * @param OutputFolder - Folder for the textures relative to Content/ (e.g., "Splats/walk/frame_00001"); created if missing
+	 * @param Settings - Preprocessing options
+	 * @param bOutSuccess - Success flag
+	 * @param OutputString - Log output
+	 * @param TexLocations - Output array with one FTextureLocations per texture page
+	 * @return Number of vertices processed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/UnrealSplat")
+	static int Preprocess3DGSModelToFolder(FString FilePath, FString OutputFolder, const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess,
+		FString& OutputString, TArray<FTextureLocations>& TexLocations);
+
+	/**
+	 * Reads the header of a PLY file plus a sample of its splats, without loading the rest.
+	 * Binary files are sampled at an even stride by seeking; ASCII files use their first splats.
+	 *
+	 * @param FilePath - Path to PLY file relative to Content/ (e.g., "Splats/mymodel.ply")
+	 * @param OutProbe - Splat count, schema, SH degree, approximate bounds and size estimates
+	 * @param NumSamples - Number of splats to read for the bounds
+	 * @return Whether the file is a valid PLY file with a vertex element
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/Parser")
+	static bool ProbePLY(FString FilePath, FGaussianSplatProbeResult& OutProbe, int32 NumSamples = 1024);
+
+	/**
+	 * ProbePLY, with the texture size estimate for the texture precisions and SH degree limit of Settings.
+	 *
+	 * @param FilePath - Path to PLY file relative to Content/ (e.g., "Splats/mymodel.ply")
+	 * @param Settings - Preprocessing options the textures would be created with
+	 * @param OutProbe - Splat count, schema, SH degree, approximate bounds and size estimates
+	 * @param NumSamples - Number of splats to read for the bounds
+	 * @return Whether the file is a valid PLY file with a vertex element
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/Parser")
+	static bool ProbePLYWithSettings(FString FilePath, const FGaussianSplatPreprocessSettings& Settings, FGaussianSplatProbeResult& OutProbe,
+		int32 NumSamples = 1024);
+
+	/**
+	 * Merges overlapping PLY captures into one model and preprocesses it into textures.
+	 * Every capture is moved by its transform first; see FGaussianSplatMergeSettings for how duplicates are found.
+	 *
+	 * @param Inputs - Captures to merge
+	 * @param ModelPath - Path of the merged model relative to Content/ (e.g., "Splats/site"); the textures are saved in this folder
+	 * @param MergeSettings - Overlap removal options
+	 * @param Settings - Preprocessing options
+	 * @param OutNumRemoved - Number of splats removed as duplicates
+	 * @param bOutSuccess - Success flag
+	 * @param OutputString - Log output
+	 * @param TexLocations - Texture locations of the merged model
+	 * @return Number of splats in the merged model, or -1 on failure
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/UnrealSplat")
+	static int PreprocessMerge(const TArray<FGaussianSplatMergeInput>& Inputs, FString ModelPath, const FGaussianSplatMergeSettings& MergeSettings,
+		const FGaussianSplatPreprocessSettings& Settings, int32& OutNumRemoved, bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations);
+
+	/**
+	 * Preprocesses a splat cloud held in memory into textures, as PreprocessMerge does with the merged captures.
+	 * The crop volumes of Settings are placed in the cloud's space. Pages are saved as soon as conversion moves
+	 * past them, so the texels of one page are held at a time.
+	 *
+	 * @param Cloud - Splats with positions, rotations, scales, opacities and base colors
+	 * @param OutputFolder - Folder for the textures relative to Content/ (e.g., "Splats/edited"); created if missing
+	 * @param Settings - Preprocessing options
+	 * @param bOutSuccess - Success flag
+	 * @param OutputString - Log output
+	 * @param TexLocations - Output array with one FTextureLocations per texture page
+	 * @param OutPeakTextureBytes - If set, receives the most bytes of locked texture mips and staging buffers held at once
+	 * @return Number of splats processed, or -1 on failure
+	 */
+	static int PreprocessCloudToFolder(const UGaussianSplatCloud* Cloud, FString OutputFolder, const FGaussianSplatPreprocessSettings& Settings,
+		bool& bOutSuccess, FString& OutputString, TArray<FTextureLocations>& TexLocations, int64* OutPeakTextureBytes = nullptr);
+
+	/**
+	 * Preprocess a sequence of splat files into frame folders.
+	 * Directories with a sequence.json sidecar are image-packed sequences and go to PreprocessImageSequence.
 	 * Output: {ParentOfSourceDir}/{ModelName}/frame_XXXXX/textures
 	 *
 	 * @param ModelName - Output folder name
-	 * @param SourceDirectory - Directory with *.ply files, relative to Content/ (e.g., "Splats/sequence")
+	 * @param SourceDirectory - Directory with splat files, relative to Content/ (e.g., "Splats/sequence")
 	 * @param bOutSuccess - Success flag
 	 * @param OutputString - Log output
 	 * @return Number of frames processed
 	 */
 	UFUNCTION(BlueprintCallable, Category = "JI20/UnrealSplat")
 	static int PreprocessSequence(FString ModelName, FString SourceDirectory, bool& bOutSuccess, FString& OutputString);
+
+	/**
+	 * Same as PreprocessSequence, with the preprocessing options applied to every frame.
+	 *
+	 * @param ModelName - Output folder name
+	 * @param SourceDirectory - Directory with splat files, relative to Content/ (e.g., "Splats/sequence")
+	 * @param Settings - Preprocessing options; crop volumes apply to every frame
+	 * @param bOutSuccess - Success flag
+	 * @param OutputString - Log output
+	 * @return Number of frames processed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/UnrealSplat")
+	static int PreprocessSequenceWithSettings(FString ModelName, FString SourceDirectory, const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess, FString& OutputString);
+
+	/**
+	 * Preprocess an image-packed 4DGS sequence (see FImageSplatSequence) straight into frame folders, without PLY files.
+	 * Frames are decoded on worker threads, several at once, while the textures of finished frames are saved.
+	 * Output: {ParentOfSourceDir}/{ModelName}/frame_XXXXX/textures, as AGaussianSplatLiveActor::LoadFrames expects
+	 *
+	 * @param ModelName - Output folder name
+	 * @param SourceDirectory - Directory with sequence.json and the frame image folders, relative to Content/
+	 * @param Settings - Preprocessing options; crop volumes apply to every frame
+	 * @param bOutSuccess - Success flag
+	 * @param OutputString - Log output
+	 * @return Number of frames processed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "JI20/UnrealSplat")
+	static int PreprocessImageSequence(FString ModelName, FString SourceDirectory, const FGaussianSplatPreprocessSettings& Settings, bool& bOutSuccess, FString& OutputString);
+
+	/** File extensions Preprocess3DGSModel accepts, without the dot */
+	static const TArray<FString>& GetSupportedFileExtensions();
+
+	/** Name of the folder of frame FrameIndex of a sequence: frame_XXXXX */
+	static FString GetSequenceFrameFolderName(int32 FrameIndex);
+
+	/** File dialog filter listing every supported extension, e.g. for DesktopPlatform's OpenFileDialog */
+	static FString GetFileDialogFilter();
+
+	/** Sorted names of the files with a supported extension directly inside AbsoluteDirectory */
+	static void FindSplatFiles(const FString& AbsoluteDirectory, TArray<FString>& OutFileNames);
 };
@@ -10,6 +10,10 @@
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Text/SMultiLineEditableText.h"
 
+class FStructOnScope;
+class IStructureDetailsView;
+struct FGaussianSplatPreprocessSettings;
+
 /**
  * Slate window for 3DGS/4DGS preprocessing
  * Converts PLY files to texture assets
@@ -30,6 +34,10 @@ private:
 	TSharedPtr<SCheckBox> SequenceModeCheckbox;
 	TSharedPtr<SMultiLineEditableText> OutputLog;
 
+	// Preprocessing settings (SH degree, crop volumes), edited in a details panel
+	TSharedPtr<FStructOnScope> SettingsStruct;
+	TSharedPtr<IStructureDetailsView> SettingsView;
+
 	// Button handlers
 	FReply OnBrowseClicked();
 	FReply OnPreprocessClicked();
@@ -38,4 +46,5 @@ private:
 	// Helper
 	void AppendLog(const FString& Message);
 	FString GetDefaultModelName(const FString& FilePath);
+	const FGaussianSplatPreprocessSettings& GetSettings() const;
 };
@@ -0,0 +1,106 @@
+// SplatArena.h
+// Linear allocator backing the intermediate buffers of one preprocessing job
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Hands out memory from large blocks and frees it all at once when the arena is destroyed or reset.
+ * The first block is sized up front (normally from the element count in the PLY header), so a job
+ * that stays within its estimate performs a single allocation. Requests that do not fit chain a
+ * new block instead of failing.
+ *
+ * Current and peak bytes cover everything allocated from the arena plus the bytes registered
+ * with TrackExternalBytes() or an FExternalBytes scope, so a job can report its working set in one place.
+ * Memory that is neither allocated here nor registered (allocator overhead, engine objects) is not counted,
+ * so the figures are a lower bound of the job's real footprint.
+ * Not thread-safe: allocate from the thread driving the job, then share the memory with its tasks.
+ */
+class UNREALSPLAT_API FSplatArena
+{
+public:
+	static constexpr int64 DefaultAlignment = 64;
+
+	explicit FSplatArena(int64 InitialCapacity = 0);
+	~FSplatArena();
+
+	FSplatArena(const FSplatArena&) = delete;
+	FSplatArena& operator=(const FSplatArena&) = delete;
+
+	/** Returns Bytes of uninitialized memory, valid until the arena is reset or destroyed */
+	void* Allocate(int64 Bytes, int64 Alignment = DefaultAlignment);
+
+	template <typename T>
+	T* AllocateArray(int64 Num)
+	{
+		return static_cast<T*>(Allocate(Num * int64(sizeof(T)), FMath::Max<int64>(alignof(T), DefaultAlignment)));
+	}
+
+	/** Makes sure the next Bytes of allocations fit without chaining another block, e.g. once the job size is known */
+	void Reserve(int64 Bytes);
+
+	/** Adds (or, with a negative Delta, removes) memory the job holds outside the arena, e.g. locked texture mips */
+	void TrackExternalBytes(int64 Delta);
+
+	/**
+	 * Memory held outside the arena whose size changes over the job, such as a file reader's buffers.
+	 * Set() registers the current size, and the bytes are released again when the scope ends,
+	 * so current bytes follow the actual frees.
+	 */
+	class FExternalBytes
+	{
+	public:
+		explicit FExternalBytes(FSplatArena& InArena)
+			: Arena(InArena)
+			, Bytes(0)
+		{
+		}
+
+		~FExternalBytes() { Set(0); }
+
+		FExternalBytes(const FExternalBytes&) = delete;
+		FExternalBytes& operator=(const FExternalBytes&) = delete;
+
+		void Set(int64 NewBytes)
+		{
+			Arena.TrackExternalBytes(NewBytes - Bytes);
+			Bytes = NewBytes;
+		}
+
+	private:
+		FSplatArena& Arena;
+		int64 Bytes;
+	};
+
+	/** Invalidates every allocation. The first block is kept for reuse, any chained blocks are freed. */
+	void Reset();
+
+	/** Bytes handed out by the arena, including alignment padding, plus tracked external bytes */
+	int64 GetCurrentBytes() const { return AllocatedBytes + ExternalBytes; }
+
+	/** Highest GetCurrentBytes() since the arena was created */
+	int64 GetPeakBytes() const { return PeakBytes; }
+
+	/** Bytes reserved from the system for the arena's blocks */
+	int64 GetCapacity() const;
+
+	/** One-line summary of the counters for the preprocessing log */
+	FString Describe() const;
+
+private:
+	struct FBlock
+	{
+		uint8* Data;
+		int64 Size;
+		int64 Used;
+	};
+
+	void AddBlock(int64 MinSize);
+	void UpdatePeak();
+
+	TArray<FBlock, TInlineAllocator<4>> Blocks;
+	int64 AllocatedBytes;
+	int64 ExternalBytes;
+	int64 PeakBytes;
+};
@@ -0,0 +1,47 @@
+// SplatCloudMerge.h
+// Merging of several splat clouds into one, with removal of splats that overlapping captures share
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UGaussianSplatCloud;
+struct FGaussianSplatMergeSettings;
+
+/**
+ * Combines clouds of overlapping captures into a single cloud in three passes:
+ * - Concatenate() moves every source by its transform and appends it to one cloud
+ * - FindOverlaps() hashes every splat into a grid cell and flags splats that duplicate a splat of another
+ *   source in the same or a neighbouring cell: close, with a similar base color and size. The more opaque one is kept.
+ * - Compact() copies the kept splats into the final cloud
+ *
+ * The passes run in parallel. The spatial hash is split into shards by cell and each shard sorts its splats
+ * by cell, so the splats of a cell are found by binary search. Every splat then looks up its preferred
+ * duplicates in the 27 cells around it, and a short serial pass keeps the most opaque splat of every group.
+ */
+class UNREALSPLAT_API FSplatCloudMerge
+{
+public:
+	/**
+	 * Appends the splats of every source, moved by its transform, to a new cloud. The merged cloud has the
+	 * attributes all sources have and the lowest spherical harmonics degree among them. Normals are dropped.
+	 * Higher order harmonics are rotated with the splats. Transforms must scale uniformly and positively,
+	 * since a splat's axes stay its own; otherwise nothing is merged and OutError says why.
+	 * OutSourceIndices receives the index of the source of every merged splat.
+	 */
+	static UGaussianSplatCloud* Concatenate(TConstArrayView<const UGaussianSplatCloud*> Sources, TConstArrayView<FTransform> Transforms,
+		TArray<int32>& OutSourceIndices, FString& OutError);
+
+	/**
+	 * Flags splats that duplicate a splat of another source in OutRemoved (one entry per splat).
+	 * Returns the number of flagged splats.
+	 */
+	static int32 FindOverlaps(const UGaussianSplatCloud& Cloud, TConstArrayView<int32> SourceIndices, const FGaussianSplatMergeSettings& Settings,
+		TArray<bool>& OutRemoved);
+
+	/** Returns a new cloud with the splats of Cloud that are not flagged in Removed, in their original order */
+	static UGaussianSplatCloud* Compact(const UGaussianSplatCloud& Cloud, TConstArrayView<bool> Removed);
+
+	/** Shards of the spatial hash, processed as independent tasks */
+	static constexpr int32 NumShards = 64;
+};
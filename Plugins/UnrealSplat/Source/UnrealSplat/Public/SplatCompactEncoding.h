@@ -0,0 +1,51 @@
+// SplatCompactEncoding.h
+// Quantization of the compact splat textures (EGaussianSplatTexturePrecision::Compact) and its inverse
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Every compact texture is BGRA8 and holds one 32-bit word per splat, read as W = B | G << 8 | R << 16 | A << 24,
+ * so a splat without harmonics takes 16 bytes. Positions, scales and colors are quantized relative to ranges per
+ * chunk of ChunkSize consecutive splats, stored in a chunk range texture of RangeTexelsPerChunk RGBA32F texels
+ * per chunk (another 0.375 bytes per splat). Splats are ordered along a Morton curve first, so a chunk covers a
+ * small region and its ranges stay tight.
+ *
+ * The Decode functions are the reference for Shaders/Private/SplatCompactDecode.ush, which materials and Niagara
+ * include as /Plugin/UnrealSplat/Private/SplatCompactDecode.ush.
+ */
+class UNREALSPLAT_API FSplatCompactEncoding
+{
+public:
+	/** Consecutive splats that share one entry of the chunk range texture */
+	static constexpr int32 ChunkSize = 256;
+
+	/** Texels per chunk: position min, position max, ln(scale) min, ln(scale) max, f_dc min, f_dc max */
+	static constexpr int32 RangeTexelsPerChunk = 6;
+
+	/** Position or ln(scale), normalized to [0, 1] in its chunk range: x in bits 21-31, y in bits 10-20, z in bits 0-9 */
+	static uint32 EncodeUnorm111110(const FVector3f& Normalized);
+	static FVector3f DecodeUnorm111110(uint32 Word);
+
+	/**
+	 * "Smallest three" encoding of a unit quaternion (x, y, z, w): W >> 30 is the index of the largest component,
+	 * which is made positive and left out; the other three, in order, are in the 10-bit fields from bit 0 up,
+	 * mapped from [-1/sqrt(2), 1/sqrt(2)] to [0, 1023]. The dropped component is sqrt(1 - a^2 - b^2 - c^2).
+	 */
+	static uint32 EncodeRotation(const FQuat4f& Rotation);
+	static FQuat4f DecodeRotation(uint32 Word);
+
+	/** f_dc normalized to [0, 1] in its chunk range, and opacity: R, G, B, A = 8-bit unorm each */
+	static FColor EncodeColor(const FVector3f& NormalizedDC, float Opacity);
+	static FVector3f DecodeColor(const FColor& Color, float& OutOpacity);
+
+	/** Reciprocal of the extent of [Min, Max] per axis, or 0 for a flat axis, whose values then all quantize to 0 */
+	static FVector3f GetNormalizationScale(const FVector3f& Min, const FVector3f& Max);
+
+	/**
+	 * Order of NumSplats positions along a Morton curve through their bounds, at 21 bits per axis.
+	 * OutOrder[k] is the index of the k-th splat on the curve.
+	 */
+	static void GetMortonOrder(const FLinearColor* Positions, int32 NumSplats, TArray<int32>& OutOrder);
+};
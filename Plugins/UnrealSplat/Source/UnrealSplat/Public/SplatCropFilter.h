@@ -0,0 +1,46 @@
+// SplatCropFilter.h
+// Evaluation of crop volumes on splat positions
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FGaussianSplatCropVolume;
+
+/**
+ * Decides which splats survive a set of crop volumes (see FGaussianSplatCropVolume). A splat is kept if it
+ * is inside no exclusive volume and, when there are inclusive volumes, inside at least one of them.
+ * Only positions are needed, so a file can be cropped in a cheap pass before any texture is sized.
+ */
+class UNREALSPLAT_API FSplatCropFilter
+{
+public:
+	explicit FSplatCropFilter(TConstArrayView<FGaussianSplatCropVolume> InVolumes);
+
+	/** True if there are no volumes and every splat is kept */
+	bool IsEmpty() const { return Volumes.Num() == 0; }
+
+	/** Whether a splat at Position, in Unreal space, is kept */
+	bool Contains(const FVector3f& Position) const;
+
+	/**
+	 * Evaluates NumSplats splats from their raw x, y, z columns in file space, in parallel.
+	 * Writes one flag per splat to OutKeep and returns the number of kept splats.
+	 */
+	int32 FilterPositions(const float* X, const float* Y, const float* Z, int32 NumSplats, bool* OutKeep) const;
+
+private:
+	struct FVolume
+	{
+		FTransform3f Transform;
+		FVector3f BoxExtent;
+		float SphereRadiusSquared;
+		bool bSphere;
+		bool bExclude;
+
+		bool Contains(const FVector3f& Position) const;
+	};
+
+	TArray<FVolume> Volumes;
+	bool bHasInclusive;
+};
@@ -0,0 +1,102 @@
+// SplatKernels.h
+// Batch kernels turning raw 3DGS PLY columns into the texel values written by the preprocessor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Float16Color.h"
+
+/**
+ * Every kernel reads Num values from each input column and writes Num texels to Out.
+ * Columns need no particular alignment.
+ *
+ * The default implementations use SSE2 (AVX2 when the build guarantees it) on x64 and NEON on ARM,
+ * and fall back to the reference path elsewhere. Measured against double precision:
+ * - exp is a Cephes-style polynomial with a maximum relative error of 1.7e-7 (about 1.5 ulp).
+ *   Inputs are clamped to [-87.3, 88.3] first, so exp itself never overflows to infinity or flushes
+ *   to zero (the scaled result of ConvertScales can still overflow for inputs above 83.9).
+ * - sigmoid is 1 / (1 + exp(-x)) on top of that exp, with a maximum absolute error of 9e-8.
+ * - quaternions are normalized in single precision with an exact square root and division,
+ *   with a maximum absolute error of 1.6e-7 per component. Quaternions with a squared length
+ *   below UE_SMALL_NUMBER become the identity, as with FQuat::Normalize.
+ * - EncodeHalf rounds to the nearest half (relative error below 4.9e-4 in the normal range), like FFloat16.
+ * Set UnrealSplat.ReferenceKernels to 1 to route every call through the reference path.
+ */
+namespace SplatKernels
+{
+	/** Out = 100 * (x, -z, -y, 1) */
+	void ConvertPositions(const float* X, const float* Y, const float* Z, int32 Num, FLinearColor* Out);
+
+	/** Out = 100 * (exp(scale_0), exp(scale_2), exp(scale_1), 1) */
+	void ConvertScales(const float* Scale0, const float* Scale1, const float* Scale2, int32 Num, FLinearColor* Out);
+
+	/** q = normalize(rot_1, rot_2, rot_3, rot_0) as (x, y, z, w); Out = (q.x, -q.z, -q.y, q.w) */
+	void ConvertRotations(const float* Rot0, const float* Rot1, const float* Rot2, const float* Rot3, int32 Num, FLinearColor* Out);
+
+	/** Out = (f_dc_0, f_dc_1, f_dc_2, clamp(sigmoid(opacity), 0, 1)) */
+	void ConvertColors(const float* DC0, const float* DC1, const float* DC2, const float* Opacity, int32 Num, FLinearColor* Out);
+
+	/**
+	 * Out = half((In - Offset) * Scale) per channel, for textures stored as RGBA16F.
+	 * Offset and Scale map a channel into a range where half precision is good enough, e.g. positions into [0, 1].
+	 */
+	void EncodeHalf(const FLinearColor* In, int32 Num, const FLinearColor& Offset, const FLinearColor& Scale, FFloat16Color* Out);
+
+	/**
+	 * View-dependent color of Out.Num() splats from their spherical harmonics up to Degree (0-3), as the
+	 * INRIA renderer evaluates it: Out = (max(0.5 + SH(dir), 0), 1) per color channel.
+	 *
+	 * ZeroOrder holds f_dc_0..2 of every splat. HigherOrder holds CoefficientStride RGB triplets per splat
+	 * (the layout of UGaussianSplatCloud), of which the first (Degree + 1)^2 - 1 are used; it is ignored
+	 * for degree 0. Directions are in Unreal space like the splat positions and are normalized here;
+	 * they are rotated into the PLY frame the coefficients were fitted in before evaluating.
+	 * The basis is evaluated Lanes splats at a time with the same SIMD primitives as the kernels above.
+	 */
+	template <int32 Degree>
+	void EvaluateSH(TConstArrayView<FVector3f> ZeroOrder, TConstArrayView<float> HigherOrder, int32 CoefficientStride,
+		const FVector3f& ViewDirection, TArrayView<FLinearColor> Out);
+
+	/** As above, with every splat viewed from CameraPosition: dir = Positions[i] - CameraPosition */
+	template <int32 Degree>
+	void EvaluateSH(TConstArrayView<FVector3f> ZeroOrder, TConstArrayView<float> HigherOrder, int32 CoefficientStride,
+		TConstArrayView<FVector3f> Positions, const FVector3f& CameraPosition, TArrayView<FLinearColor> Out);
+
+	/**
+	 * Turns higher order spherical harmonics along with a splat rotated by Rotation (Unreal space), so that
+	 * EvaluateSH gives the rotated splat seen along Rotation * dir the color the original had along dir.
+	 * Each band only mixes within itself. Its matrix is fitted once per rotation, by least squares over
+	 * fixed directions, from the same basis EvaluateSH uses, so it follows the INRIA signs and the PLY frame.
+	 */
+	class FSHRotation
+	{
+	public:
+		explicit FSHRotation(const FQuat4f& Rotation);
+
+		/** Out = rotated In for NumCoefficients (0, 3, 8 or 15) RGB triplets; In and Out must not overlap */
+		void Apply(const float* In, int32 NumCoefficients, float* Out) const;
+
+	private:
+		// Row j holds the weights of the original coefficients in rotated coefficient j
+		float Band1[3][3];
+		float Band2[5][5];
+		float Band3[7][7];
+	};
+
+	/** Scalar implementations built on FMath and FQuat, used to validate the SIMD kernels */
+	namespace Reference
+	{
+		void ConvertPositions(const float* X, const float* Y, const float* Z, int32 Num, FLinearColor* Out);
+		void ConvertScales(const float* Scale0, const float* Scale1, const float* Scale2, int32 Num, FLinearColor* Out);
+		void ConvertRotations(const float* Rot0, const float* Rot1, const float* Rot2, const float* Rot3, int32 Num, FLinearColor* Out);
+		void ConvertColors(const float* DC0, const float* DC1, const float* DC2, const float* Opacity, int32 Num, FLinearColor* Out);
+		void EncodeHalf(const FLinearColor* In, int32 Num, const FLinearColor& Offset, const FLinearColor& Scale, FFloat16Color* Out);
+
+		template <int32 Degree>
+		void EvaluateSH(TConstArrayView<FVector3f> ZeroOrder, TConstArrayView<float> HigherOrder, int32 CoefficientStride,
+			const FVector3f& ViewDirection, TArrayView<FLinearColor> Out);
+
+		template <int32 Degree>
+		void EvaluateSH(TConstArrayView<FVector3f> ZeroOrder, TConstArrayView<float> HigherOrder, int32 CoefficientStride,
+			TConstArrayView<FVector3f> Positions, const FVector3f& CameraPosition, TArrayView<FLinearColor> Out);
+	}
+}
@@ -0,0 +1,46 @@
+// SplatPLYWriter.h
+// Binary PLY output for splat clouds, the counterpart of reading files through miniply
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UGaussianSplatCloud;
+struct FGaussianSplatExportSettings;
+
+/**
+ * Writes a UGaussianSplatCloud as a binary_little_endian PLY vertex element with float properties, in the
+ * INRIA order (x y z, nx ny nz, f_dc_*, f_rest_*, opacity, scale_*, rot_*) restricted to the selected groups.
+ *
+ * Rows are encoded in parallel from the cloud's arrays into a large block buffer, so the file is written
+ * with a few big sequential writes instead of one per row or property. Values are read through
+ * FGaussianSplatCloudSource, i.e. converted back to the raw form of a trainer's output.
+ */
+class UNREALSPLAT_API FSplatPLYWriter
+{
+public:
+	/** Rows encoded and written per block */
+	static constexpr int32 RowsPerBlock = 64 * 1024;
+
+	FSplatPLYWriter(const UGaussianSplatCloud& InCloud, const FGaussianSplatExportSettings& Settings);
+
+	/** Writes the header and every splat to AbsolutePath. Returns false, with GetError() set, on I/O failure. */
+	bool Write(const FString& AbsolutePath);
+
+	/** The PLY header written before the rows */
+	FString GetHeader() const;
+
+	/** Bytes per vertex row */
+	int32 GetRowStride() const { return Columns.Num() * int32(sizeof(float)); }
+
+	const FString& GetError() const { return Error; }
+
+private:
+	void EncodeRows(int32 FirstRow, int32 NumRows, float* Out) const;
+
+	const UGaussianSplatCloud& Cloud;
+
+	/** Written columns, in file order */
+	TArray<int32> Columns;
+	FString Error;
+};
@@ -0,0 +1,41 @@
+// SplatTexturePages.h
+// Layout of the output textures of a model: texture sizes and the split into pages of consecutive splats
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Splats [FirstSplat, FirstSplat + NumSplats) of a model, stored in one set of textures */
+struct FSplatPageRange
+{
+	int32 FirstSplat = 0;
+	int32 NumSplats = 0;
+};
+
+/**
+ * Every attribute of a page has its own texture of NumSplats times its texels per splat: one for positions,
+ * scales, rotations and colors, 3, 5, 4 and 3 for the harmonics bands. Textures are square-ish, and a page holds
+ * as many splats as fit its largest texture within MaxTexelsPerTexture, so no texture exceeds the largest
+ * dimension the engine supports.
+ */
+class UNREALSPLAT_API FSplatTexturePages
+{
+public:
+	/** Texels per splat of the largest texture of a page: 5 with the L2 harmonics, 3 with L1 only, else 1 */
+	static int32 GetMaxTexelsPerSplat(int32 SHDegree);
+
+	/**
+	 * Dimensions of the square-ish texture holding NumPixels texels. Computed in integers, since a float square root
+	 * is off by several texels at the sizes of large scenes and would leave the texture too small.
+	 */
+	static void GetTextureSize(int64 NumPixels, int32& OutWidth, int32& OutHeight);
+
+	/** Splats per page for textures of at most MaxTexelsPerTexture texels */
+	static int32 GetSplatsPerPage(int32 SHDegree, int64 MaxTexelsPerTexture);
+
+	/** Asset name of texture Name (e.g. "positiontexture") of page PageIndex; page 0 keeps the names of single-page models */
+	static FString GetPageTextureName(const TCHAR* Name, int32 PageIndex);
+
+	/** Consecutive pages of at most SplatsPerPage splats covering NumSplats (at most MAX_int32) splats */
+	static TArray<FSplatPageRange> GetPages(int64 NumSplats, int32 SplatsPerPage);
+};
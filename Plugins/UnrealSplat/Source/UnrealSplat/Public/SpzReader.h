@@ -0,0 +1,84 @@
+// SpzReader.h
+// Reader for the gzip-compressed, quantized .spz splat format
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GaussianSplatBuffer.h"
+
+class FSplatArena;
+
+/**
+ * Reads .spz files (Niantic's packed Gaussian splat format, versions 2 and 3). The whole file is a gzip stream
+ * holding a 16-byte header followed by the quantized attributes, one attribute after the other:
+ * - positions: 24-bit signed fixed point, with the header's number of fractional bits
+ * - alphas: sigmoid opacity in 8 bits
+ * - colors: base color in 8 bits, scaled by 0.15 around 0.5
+ * - scales: log scale in 8 bits, (s + 10) * 16
+ * - rotations: x, y, z in 8 bits each with w >= 0 rebuilt (version 2), or smallest-three in 32 bits (version 3)
+ * - spherical harmonics: 8 bits per coefficient and channel, (v - 128) / 128, coefficient-major
+ *
+ * Open() inflates the file in fixed-size chunks straight into the quantized attribute storage, which is a
+ * fraction of the size of the float splats. DecodeBatch() then dequantizes a range of splats in parallel into
+ * the raw columns of a float 3DGS PLY, converted from the format's RUB axes to the PLY's RDF axes, so batches
+ * go through the same conversion as any PLY file.
+ */
+class UNREALSPLAT_API FSpzReader
+{
+public:
+	FSpzReader();
+
+	/**
+	 * Reads the header and inflates all quantized attributes of AbsolutePath into storage from Arena.
+	 * Returns false, with GetError() describing why, if the file is not a complete .spz file of a supported version.
+	 */
+	bool Open(const FString& AbsolutePath, FSplatArena& Arena);
+
+	int32 GetNumSplats() const { return NumPoints; }
+
+	/** Spherical harmonics degree stored in the file */
+	int32 GetSHDegree() const { return FileSHDegree; }
+
+	/** Summary of the header for the preprocessing log */
+	FString Describe() const;
+
+	const FString& GetError() const { return Error; }
+
+	/**
+	 * Dequantizes splats [FirstSplat, FirstSplat + InNumSplats) into the columns, with harmonics up to SHDegree.
+	 * Column storage comes from the arena passed to Open() and is reused by the next batch.
+	 */
+	bool DecodeBatch(int32 FirstSplat, int32 InNumSplats, int32 SHDegree);
+
+	/** Number of splats in the last decoded batch */
+	int32 Num() const { return NumSplats; }
+
+	/** Contiguous column data of the last decoded batch, or nullptr if the batch does not contain the column */
+	const float* Column(EGaussianSplatColumn InColumn) const { return Columns[int32(InColumn)]; }
+
+	/** See FGaussianSplatBuffer::RestChannelStride() */
+	int32 RestChannelStride() const { return FGaussianSplatBuffer::NumSHCoefficientsForDegree(FileSHDegree); }
+
+private:
+	int32 RotationBytes() const { return Version >= 3 ? 4 : 3; }
+
+	FSplatArena* Arena;
+	const uint8* Positions;
+	const uint8* Alphas;
+	const uint8* Colors;
+	const uint8* Scales;
+	const uint8* Rotations;
+	const uint8* Harmonics;
+
+	float* Columns[FGaussianSplatBuffer::NumColumns];
+	float* BatchStorage;
+	int64 BatchStorageSize;
+	int32 NumSplats;
+
+	int32 Version;
+	int32 NumPoints;
+	int32 FileSHDegree;
+	int32 FractionalBits;
+	bool bAntialiased;
+	FString Error;
+};
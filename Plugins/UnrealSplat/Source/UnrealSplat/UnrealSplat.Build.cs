@@ -55,10 +55,18 @@ public class UnrealSplat : ModuleRules
                 "AssetTools",
 				"DesktopPlatform",
 				"WorkspaceMenuStructure",
+				"PropertyEditor",
+				"Json",
+				"ImageWrapper",
+				"ImageCore",
+				"Projects",
 			}
 			);
 		
 		
+		// zlib inflates .spz files in a streaming fashion
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{